@@ -0,0 +1,93 @@
+// Copyright 2025, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "benchmark/benchmark.h"
+
+#include <filesystem>
+
+#include "omp.h"
+
+#include "osm/OsmFileHelper.h"
+
+namespace {
+    const std::string CHANGE_FILE = "../tests/data/427.osc.gz";
+}
+
+// _________________________________________________________________________________________________
+// Merges the given number of change files (first argument) with the given number of threads
+// (second argument).
+static void mergeAndSortFiles(benchmark::State& state) {
+    const auto numOfFiles = static_cast<size_t>(state.range(0));
+    omp_set_num_threads(static_cast<int>(state.range(1)));
+
+    std::vector<osmium::io::File> inputs(numOfFiles, osmium::io::File(CHANGE_FILE));
+    const auto output = std::filesystem::temp_directory_path() / "olu_benchmark_merged.osc";
+
+    for (auto _ : state) {
+        olu::osm::OsmFileHelper::mergeAndSortFiles(
+            inputs, output.string(), olu::osm::object_order_type_id_reverse_version_delete(),
+            false);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * numOfFiles));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * numOfFiles
+                                                 * std::filesystem::file_size(CHANGE_FILE)));
+    std::filesystem::remove(output);
+}
+BENCHMARK(mergeAndSortFiles)
+    ->ArgNames({"files", "threads"})
+    ->ArgsProduct({{1, 16, 128}, {1, 2, 4, 8, 16, 32}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+// _________________________________________________________________________________________________
+// Sorts the objects of the given number of change files with the given number of threads.
+static void sortObjects(benchmark::State& state) {
+    const auto numOfFiles = static_cast<size_t>(state.range(0));
+    omp_set_num_threads(static_cast<int>(state.range(1)));
+
+    std::vector<osmium::memory::Buffer> buffers;
+    std::vector<const osmium::OSMObject*> objects;
+    for (size_t i = 0; i < numOfFiles; ++i) {
+        osmium::io::Reader reader{osmium::io::File(CHANGE_FILE), osmium::osm_entity_bits::object};
+        while (osmium::memory::Buffer buffer = reader.read()) {
+            for (const auto &object: buffer.select<osmium::OSMObject>()) {
+                objects.push_back(&object);
+            }
+            buffers.push_back(std::move(buffer));
+        }
+        reader.close();
+    }
+
+    const olu::osm::object_order_type_id_reverse_version_delete compare;
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto unsorted = objects;
+        state.ResumeTiming();
+
+        olu::util::parallelSort(unsorted.begin(), unsorted.end(), compare);
+        benchmark::DoNotOptimize(unsorted.data());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * objects.size()));
+}
+BENCHMARK(sortObjects)
+    ->ArgNames({"files", "threads"})
+    ->ArgsProduct({{16, 128}, {1, 2, 4, 8, 16, 32}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
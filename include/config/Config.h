@@ -36,6 +36,13 @@ struct Config {
     static constexpr u_int16_t DEFAULT_WKT_PRECISION = 7;
     static constexpr u_int16_t DEFAULT_PERCENTAGE_PRECISION = 1;
     static constexpr u_int32_t DEFAULT_BATCH_SIZE = 1 << 18;
+    static constexpr u_int32_t DEFAULT_INSERT_BATCH_SIZE_MB = 16;
+    // Number of filled insert batches that can wait to be sent to the SPARQL endpoint while the
+    // osm2rdf output is still being filtered.
+    static constexpr u_int16_t DEFAULT_INSERT_QUEUE_SIZE = 2;
+    static constexpr u_int16_t DEFAULT_MAX_CONCURRENT_DOWNLOADS = 8;
+    static constexpr u_int16_t DEFAULT_MAX_CONCURRENT_REQUESTS = 1;
+    static constexpr u_int32_t DEFAULT_MERGE_MEMORY_LIMIT_MB = 4096;
 
     // The uri of the SPARQL endpoint for queries
     std::string sparqlEndpointUri;
@@ -66,9 +73,9 @@ struct Config {
     // User specified path to a polygon file
     std::string pathToPolygonFile;
 
-    // Strategy that is used by the osmium extract command to extract the changes. Possible values
-    // are: smart, complete_ways and simple. The default is "smart", because this is the one
-    // Geofabrik uses for their country extracts.
+    // Strategy that is used to extract the changes, with the same semantics as the osmium extract
+    // command. Possible values are: smart, complete_ways and simple. The default is "smart",
+    // because this is the one Geofabrik uses for their country extracts.
     // See: https://docs.osmcode.org/osmium/latest/osmium-extract.html for an explanation of the
     // strategies.
     std::string extractStrategy = "smart";
@@ -81,12 +88,54 @@ struct Config {
     // Option that can be used if the SPARQL endpoint is QLever.
     bool isQLever = false;
 
+    // Option to use HTTP/2 for the requests to the SPARQL endpoint and replication server.
+    bool useHttp2 = false;
+
+    // Option to send SPARQL queries and updates as URL-encoded form data instead of using the
+    // "application/sparql-query" and "application/sparql-update" content types.
+    bool useFormEncoding = false;
+
+    // Compression of the bodies of SPARQL requests ("gzip" or "zstd"). Empty if the bodies are
+    // sent uncompressed.
+    std::string requestCompression;
+
+    // Option to request the results of SPARQL queries as tab-separated values instead of JSON.
+    // Only supported for QLever endpoints.
+    bool useTsvResults = false;
+
+    // Option to send the delete and insert operations for each batch of objects in one SPARQL
+    // update, instead of deleting the triples of all objects before inserting any triples.
+    bool interleaveUpdates = false;
+
+    // The maximum number of change files that are downloaded from the replication server at once
+    size_t maxConcurrentDownloads = DEFAULT_MAX_CONCURRENT_DOWNLOADS;
+
+    // The maximum number of batches for which SPARQL updates are sent to the endpoint at once,
+    // and the maximum number of queries that are sent to the endpoint at once
+    size_t maxConcurrentRequests = DEFAULT_MAX_CONCURRENT_REQUESTS;
+
+    // Option to parse the downloaded change files from memory instead of storing them in the
+    // temporary directory before merging them.
+    bool streamChangeFiles = false;
+
+    // Maximum memory in bytes that is used for the osm objects while merging change files. If more
+    // is needed, sorted runs are written to the temporary directory.
+    size_t mergeMemoryLimit = static_cast<size_t>(DEFAULT_MERGE_MEMORY_LIMIT_MB) << 20;
+
     // Option to enable detailed statistics output.
     bool showDetailedStatistics = false;
 
     // The number of values or triples that should be sent in one batch to the SPARQL endpoint
     size_t batchSize = DEFAULT_BATCH_SIZE;
 
+    // Maximum size in bytes of the triples that are sent in one insert operation. The number of
+    // triples is limited by the batch size as well.
+    size_t insertBatchBytes = static_cast<size_t>(DEFAULT_INSERT_BATCH_SIZE_MB) << 20;
+
+    // Option to adapt the batch size for each kind of request to the latency of the endpoint,
+    // and to split batches that are too large for it
+    bool adaptiveBatchSize = false;
+
     // Directory to store temporary files
     std::filesystem::path tmpDir = std::filesystem::temp_directory_path();
 
@@ -100,6 +149,12 @@ struct Config {
     // User can specify a file to which the response of the SPARQL endpoint will be written.
     std::filesystem::path sparqlResponseFile;
 
+    // Directory with the local indexes of the OSM data. If empty, all OSM data is fetched from
+    // the SPARQL endpoint.
+    std::filesystem::path indexDir;
+    // PBF file from which the local indexes are built before the update. Optional.
+    std::filesystem::path indexBootstrapFile;
+
     // Stores the osm2rdf options that will be fetched from the SPARQL endpoint before
     // we convert the OSM data to RDF triples.
     std::map<std::string, std::string> osm2rdfOptions;;
@@ -33,6 +33,10 @@ namespace olu::config::constants {
     const static inline std::string HTML_KEY_CONTENT_TYPE = "Content-Type";
     const static inline std::string HTML_VALUE_CONTENT_TYPE = "application/x-www-form-urlencoded";
     const static inline std::string HTML_VALUE_CONTENT_TYPE_TURTLE = "text/turtle";
+    const static inline std::string HTML_VALUE_CONTENT_TYPE_SPARQL_QUERY =
+            "application/sparql-query";
+    const static inline std::string HTML_VALUE_CONTENT_TYPE_SPARQL_UPDATE =
+            "application/sparql-update";
 
     const static inline std::string HTML_KEY_AUTHORIZATION = "Authorization";
     const static inline std::string HTML_KEY_ACCEPT = "Accept";
@@ -40,6 +44,8 @@ namespace olu::config::constants {
             "application/sparql-results+json";
     const static inline std::string HTML_VALUE_ACCEPT_QLEVER_RESULT_JSON =
             "application/qlever-results+json";
+    const static inline std::string HTML_VALUE_ACCEPT_TSV = "text/tab-separated-values";
+    const static inline std::string HTML_KEY_CONTENT_ENCODING = "Content-Encoding";
 
     // File extensions -----------------------------------------------------------------------------
     const static inline std::string OSM_CHANGE_FILE_EXTENSION = ".osc";
@@ -47,6 +53,7 @@ namespace olu::config::constants {
     const static inline std::string OSM_EXTENSION = ".osm";
     const static inline std::string TURTLE_FILE_EXTENSION = ".ttl";
     const static inline std::string TEXT_FILE_EXTENSION = ".txt";
+    const static inline std::string INDEX_FILE_EXTENSION = ".idx";
 
     // Directory paths -----------------------------------------------------------------------------
     [[maybe_unused]] static std::string getPathToOluTmpDir(const std::filesystem::path& tmpDirPath) {
@@ -63,6 +70,9 @@ namespace olu::config::constants {
         return getPathToChangeFileDir(tmpDirPath) + std::to_string(sequenceNumber)
                 + OSM_CHANGE_FILE_EXTENSION + GZIP_EXTENSION;
     }
+    static std::string getPathToMergeRunDir(const std::filesystem::path& tmpDirPath) {
+        return getPathToOluTmpDir(tmpDirPath) + "merge_runs/";
+    }
     static std::string getPathToOsm2rdfScratchDir(const std::filesystem::path& tmpDirPath) {
         return getPathToOluTmpDir(tmpDirPath) + "osm2rdfScratch/";
     }
@@ -71,9 +81,6 @@ namespace olu::config::constants {
     static std::string getPathToChangeFile(const std::filesystem::path& tmpDirPath) {
         return getPathToOluTmpDir(tmpDirPath) + "changes" + OSM_CHANGE_FILE_EXTENSION + GZIP_EXTENSION;
     }
-    static std::string getPathToChangeFileExtract(const std::filesystem::path& tmpDirPath) {
-        return getPathToOluTmpDir(tmpDirPath) + "changes_extract" + OSM_CHANGE_FILE_EXTENSION + GZIP_EXTENSION;
-    }
     static std::string getPathToOsm2rdfInputFile(const std::filesystem::path& tmpDirPath) {
         return getPathToOluTmpDir(tmpDirPath) + "osm2rdf_input" + OSM_EXTENSION;
     }
@@ -83,6 +90,27 @@ namespace olu::config::constants {
     static std::string getPathToOsm2rdfInfoOutputFile(const std::filesystem::path& tmpDirPath) {
         return getPathToOluTmpDir(tmpDirPath) + "osm2rdf_info" + TEXT_FILE_EXTENSION;
     }
+    static std::string getPathToNodeLocationIndex(const std::filesystem::path& indexDirPath) {
+        return indexDirPath.string() + "/node_locations" + INDEX_FILE_EXTENSION;
+    }
+    static std::string getPathToWayNodesIndex(const std::filesystem::path& indexDirPath) {
+        return indexDirPath.string() + "/way_nodes" + INDEX_FILE_EXTENSION;
+    }
+    static std::string getPathToNodeWaysIndex(const std::filesystem::path& indexDirPath) {
+        return indexDirPath.string() + "/node_ways" + INDEX_FILE_EXTENSION;
+    }
+    static std::string getPathToRelationMembersIndex(const std::filesystem::path& indexDirPath) {
+        return indexDirPath.string() + "/relation_members" + INDEX_FILE_EXTENSION;
+    }
+    static std::string getPathToRelationTypesIndex(const std::filesystem::path& indexDirPath) {
+        return indexDirPath.string() + "/relation_types" + INDEX_FILE_EXTENSION;
+    }
+    static std::string getPathToMemberRelationsIndex(const std::filesystem::path& indexDirPath) {
+        return indexDirPath.string() + "/member_relations" + INDEX_FILE_EXTENSION;
+    }
+    static std::string getPathToRelationStringsIndex(const std::filesystem::path& indexDirPath) {
+        return indexDirPath.string() + "/relation_strings" + INDEX_FILE_EXTENSION;
+    }
     const static inline std::string PATH_TO_OSM2RDF_INFO_OUTPUT_FILE_DEBUG =
             "osm2rdf_info" + TEXT_FILE_EXTENSION;
     const static inline std::string PATH_TO_STATE_FILE = "state" + TEXT_FILE_EXTENSION;
@@ -503,12 +531,108 @@ namespace olu::config::constants {
         "The number of values or triples that should be sent in one batch to the SPARQL endpoint. "
         "Default is " + std::to_string(Config::DEFAULT_BATCH_SIZE) + ".";
 
+    const static inline std::string INSERT_BATCH_SIZE_MB_INFO =
+        "Maximum size of the body of an insert operation in MB:";
+    const static inline std::string INSERT_BATCH_SIZE_MB_OPTION_SHORT = "";
+    const static inline std::string INSERT_BATCH_SIZE_MB_OPTION_LONG = "insert-batch-size-mb";
+    const static inline std::string INSERT_BATCH_SIZE_MB_OPTION_HELP =
+        "The maximum size in MB of the triples that are sent to the SPARQL endpoint in one insert "
+        "operation. A batch is also sent if it contains as many triples as the batch size. "
+        "Default is " + std::to_string(Config::DEFAULT_INSERT_BATCH_SIZE_MB) + ".";
+
+    const static inline std::string ADAPTIVE_BATCH_SIZE_INFO = "Adapting the batch sizes";
+    const static inline std::string ADAPTIVE_BATCH_SIZE_OPTION_SHORT = "";
+    const static inline std::string ADAPTIVE_BATCH_SIZE_OPTION_LONG = "adaptive-batch-size";
+    const static inline std::string ADAPTIVE_BATCH_SIZE_OPTION_HELP =
+        "Adapt the number of values per batch separately for each kind of request to the SPARQL "
+        "endpoint, starting with the batch size. Batches grow while the time per value improves, "
+        "and batches that time out or are rejected by the endpoint (HTTP 413 or 5xx) are split "
+        "and sent again.";
+
     const static inline std::string QLEVER_ENDPOINT_INFO = "Working with a QLever endpoint";
     const static inline std::string QLEVER_ENDPOINT_OPTION_SHORT = "";
     const static inline std::string QLEVER_ENDPOINT_OPTION_LONG = "qlever";
     const static inline std::string QLEVER_ENDPOINT_OPTION_HELP =
         "Specify if the SPARQL endpoint is QLever. More metadata will be added to the output.";
 
+    const static inline std::string MAX_DOWNLOADS_INFO =
+        "Maximum number of concurrent change file downloads:";
+    const static inline std::string MAX_DOWNLOADS_OPTION_SHORT = "";
+    const static inline std::string MAX_DOWNLOADS_OPTION_LONG = "max-downloads";
+    const static inline std::string MAX_DOWNLOADS_OPTION_HELP =
+        "The maximum number of change files that are downloaded from the replication server at "
+        "the same time. Default is " + std::to_string(Config::DEFAULT_MAX_CONCURRENT_DOWNLOADS)
+        + ".";
+
+    const static inline std::string MAX_CONCURRENT_REQUESTS_INFO =
+        "Maximum number of concurrent SPARQL requests:";
+    const static inline std::string MAX_CONCURRENT_REQUESTS_OPTION_SHORT = "";
+    const static inline std::string MAX_CONCURRENT_REQUESTS_OPTION_LONG = "concurrent-requests";
+    const static inline std::string MAX_CONCURRENT_REQUESTS_OPTION_HELP =
+        "The maximum number of batches for which SPARQL updates are sent to the endpoint at the "
+        "same time while deleting triples, and the maximum number of queries that are sent to the "
+        "endpoint at the same time while fetching objects. The updates are only sent "
+        "concurrently if they are sent to the endpoint. Default is " + std::to_string(Config::DEFAULT_MAX_CONCURRENT_REQUESTS) + ".";
+
+    const static inline std::string STREAM_CHANGE_FILES_INFO =
+        "Merging downloaded change files from memory";
+    const static inline std::string STREAM_CHANGE_FILES_OPTION_SHORT = "";
+    const static inline std::string STREAM_CHANGE_FILES_OPTION_LONG = "stream-change-files";
+    const static inline std::string STREAM_CHANGE_FILES_OPTION_HELP =
+        "Decompress and parse the change files from the replication server directly from the "
+        "download buffers, instead of writing them to the temporary directory and reading them "
+        "again for merging.";
+
+    const static inline std::string MERGE_MEMORY_LIMIT_INFO =
+        "Memory limit for merging change files in MB:";
+    const static inline std::string MERGE_MEMORY_LIMIT_OPTION_SHORT = "";
+    const static inline std::string MERGE_MEMORY_LIMIT_OPTION_LONG = "merge-memory-limit";
+    const static inline std::string MERGE_MEMORY_LIMIT_OPTION_HELP =
+        "The maximum memory in MB that is used for the osm objects while merging and sorting the "
+        "change files. Larger inputs are sorted in runs on disk. Default is "
+        + std::to_string(Config::DEFAULT_MERGE_MEMORY_LIMIT_MB) + ".";
+
+    const static inline std::string HTTP2_INFO = "Using HTTP/2 if supported by the server";
+    const static inline std::string HTTP2_OPTION_SHORT = "";
+    const static inline std::string HTTP2_OPTION_LONG = "http2";
+    const static inline std::string HTTP2_OPTION_HELP =
+        "Negotiate HTTP/2 with the SPARQL endpoint and the replication server if they are "
+        "accessed over HTTPS. Connections are kept alive and reused in either case.";
+
+    const static inline std::string FORM_ENCODING_INFO =
+        "Sending SPARQL queries and updates URL-encoded as form data";
+    const static inline std::string FORM_ENCODING_OPTION_SHORT = "";
+    const static inline std::string FORM_ENCODING_OPTION_LONG = "form-encoding";
+    const static inline std::string FORM_ENCODING_OPTION_HELP =
+        "Send SPARQL queries and updates URL-encoded as form data, for endpoints that do not "
+        "accept the 'application/sparql-query' and 'application/sparql-update' content types.";
+
+    const static inline std::string COMPRESSION_INFO = "Compressing SPARQL requests with:";
+    const static inline std::string COMPRESSION_OPTION_SHORT = "";
+    const static inline std::string COMPRESSION_OPTION_LONG = "compression";
+    const static inline std::string COMPRESSION_OPTION_HELP =
+        "Compress the bodies of SPARQL queries and updates with 'gzip' or 'zstd' and send them "
+        "with the corresponding 'Content-Encoding' header. Compressed responses are accepted as "
+        "well. The SPARQL endpoint, or a proxy in front of it, has to support the compression.";
+
+    const static inline std::string TSV_RESULTS_INFO =
+        "Requesting query results as tab-separated values";
+    const static inline std::string TSV_RESULTS_OPTION_SHORT = "";
+    const static inline std::string TSV_RESULTS_OPTION_LONG = "tsv-results";
+    const static inline std::string TSV_RESULTS_OPTION_HELP =
+        "Request the results of SPARQL queries as tab-separated values instead of JSON, which "
+        "are smaller and faster to parse. Only supported for QLever endpoints.";
+
+    const static inline std::string INTERLEAVE_UPDATES_INFO =
+        "Sending the delete and insert operations for each batch of objects in one update";
+    const static inline std::string INTERLEAVE_UPDATES_OPTION_SHORT = "";
+    const static inline std::string INTERLEAVE_UPDATES_OPTION_LONG = "interleave-updates";
+    const static inline std::string INTERLEAVE_UPDATES_OPTION_HELP =
+        "Send the delete and insert operations for each batch of objects in one SPARQL update, "
+        "instead of deleting the triples of all objects before inserting the new ones. This "
+        "halves the number of update requests and shortens the time in which objects are "
+        "missing from the database, but the triples to insert are kept in memory.";
+
     const static inline std::string STATISTICS_INFO = "";
     const static inline std::string STATISTICS_OPTION_SHORT = "";
     const static inline std::string STATISTICS_OPTION_LONG = "statistics";
@@ -539,6 +663,22 @@ namespace olu::config::constants {
     const static inline std::string TMP_FILE_DIR_OPTION_LONG = "tmp";
     const static inline std::string TMP_FILE_DIR_OPTION_HELP =
             "Specify a directory where temporary files should be created.";
+
+    const static inline std::string INDEX_DIR_INFO = "Using local indexes at:";
+    const static inline std::string INDEX_DIR_OPTION_SHORT = "";
+    const static inline std::string INDEX_DIR_OPTION_LONG = "index-dir";
+    const static inline std::string INDEX_DIR_OPTION_HELP =
+            "Specify a directory for local indexes of the OSM data (node locations and the members "
+            "of ways and relations), which are consulted before the SPARQL endpoint and updated "
+            "with each change file. The indexes for the members of ways and relations are only "
+            "used after they were built with --index-from-pbf.";
+
+    const static inline std::string INDEX_BOOTSTRAP_INFO = "Building local indexes from:";
+    const static inline std::string INDEX_BOOTSTRAP_OPTION_SHORT = "";
+    const static inline std::string INDEX_BOOTSTRAP_OPTION_LONG = "index-from-pbf";
+    const static inline std::string INDEX_BOOTSTRAP_OPTION_HELP =
+            "Build the local indexes (--index-dir) from the given PBF file before the update. The "
+            "file has to contain the same OSM data as the SPARQL endpoint.";
 } // namespace olu::config::constants
 
 #endif //OSM_LIVE_UPDATES_CONSTANTS_H
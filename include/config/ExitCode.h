@@ -37,7 +37,9 @@ namespace olu::config {
         TMP_DIR_NOT_EXISTS,
         TMP_DIR_IS_NOT_DIRECTORY,
         POLYGON_FILE_NOT_EXISTS,
-        BBOX_INVALID
+        BBOX_INVALID,
+        INDEX_DIR_IS_NOT_DIRECTORY,
+        INDEX_BOOTSTRAP_FILE_NOT_EXISTS
     };
 
 }
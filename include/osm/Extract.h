@@ -0,0 +1,136 @@
+// Copyright 2025, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef OSM_LIVE_UPDATES_EXTRACT_H
+#define OSM_LIVE_UPDATES_EXTRACT_H
+
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "osmium/osm/box.hpp"
+#include "osmium/osm/location.hpp"
+#include "osmium/osm/object.hpp"
+
+#include "config/Config.h"
+#include "util/PolygonIndex.h"
+#include "util/Types.h"
+
+namespace olu::osm {
+
+    /**
+     * Strategies of the osmium-tool extract command, see
+     * https://docs.osmcode.org/osmium/latest/osmium-extract.html
+     */
+    enum class ExtractStrategy {
+        // Nodes in the region, ways with at least one node in the region and relations with at
+        // least one of these nodes or ways as member.
+        SIMPLE,
+        // Like SIMPLE, but with all nodes of the ways and the parent relations of the relations.
+        COMPLETE_WAYS,
+        // Like COMPLETE_WAYS, but with all member nodes and member ways (and their nodes) of the
+        // multipolygon relations that directly reference a node or way of the extract. Parent
+        // relations that are multipolygons are not completed.
+        SMART
+    };
+
+    /**
+     * Cuts the objects of a change file to a bounding box or polygon.
+     *
+     * The extract works on the objects while the change files are merged, so no extra file has
+     * to be written. The objects have to be passed in the order type (nodes, ways, relations)
+     * and id. With the simple strategy, `includes()` can be called for each object during the
+     * merge. The other strategies need to see all objects first: Each object is passed to
+     * `prepare()`, followed by a call to `finish()`, before `includes()` is called.
+     *
+     * Like osmium extract, only objects in the change file are considered. Deleted nodes have no
+     * location and are never included, so deletions are dropped.
+     */
+    class Extract {
+    public:
+        /**
+         * Creates an extract for the bounding box or polygon file and the strategy of the config.
+         */
+        explicit Extract(const config::Config &config);
+        Extract(const osmium::Box &box, ExtractStrategy strategy);
+        Extract(util::PolygonIndex polygon, ExtractStrategy strategy);
+
+        [[nodiscard]] static ExtractStrategy strategyFromString(const std::string &strategy);
+
+        /**
+         * @return True if `prepare()` and `finish()` have to be called for all objects before
+         * `includes()` can be used.
+         */
+        [[nodiscard]] bool needsPreparation() const {
+            return _strategy != ExtractStrategy::SIMPLE;
+        }
+
+        void prepare(const osmium::OSMObject &object);
+        void finish();
+
+        /**
+         * @return True if the object belongs to the extract.
+         */
+        [[nodiscard]] bool includes(const osmium::OSMObject &object);
+
+        [[nodiscard]] bool contains(const osmium::Location &location) const;
+
+    private:
+        ExtractStrategy _strategy;
+        std::optional<osmium::Box> _box;
+        std::optional<util::PolygonIndex> _polygon;
+
+        // Objects that belong to the extract. Ways and relations are included because of the
+        // nodes in the region, the extra nodes are only added to complete the ways.
+        std::unordered_set<id_t> _nodesInRegion;
+        std::unordered_set<id_t> _extraNodes;
+        std::unordered_set<id_t> _ways;
+        std::unordered_set<id_t> _relations;
+
+        // Needed to complete the extract in `finish()`: The parents of each relation, the nodes
+        // of the ways that are not included (only for the smart strategy) and the member ways of
+        // the multipolygon relations that are completed (only for the smart strategy)
+        std::unordered_map<id_t, member_ids_t> _parentsOfRelations;
+        std::unordered_map<id_t, member_ids_t> _nodesOfWays;
+        member_ids_t _waysOfMultipolygons;
+
+        bool _isFinished = false;
+
+        void prepareNode(const osmium::OSMObject &object);
+        void prepareWay(const osmium::OSMObject &object);
+        void prepareRelation(const osmium::OSMObject &object);
+    };
+
+    /**
+     * Exception that can appear inside the `Extract` class.
+     */
+    class ExtractException final : public std::exception {
+        std::string message;
+    public:
+        explicit ExtractException(const char* msg) : message(msg) { }
+
+        [[nodiscard]] const char* what() const noexcept override {
+            return message.c_str();
+        }
+    };
+
+} // namespace olu::osm
+
+#endif //OSM_LIVE_UPDATES_EXTRACT_H
@@ -19,6 +19,8 @@
 #ifndef NODEHANDLER_H
 #define NODEHANDLER_H
 
+#include <deque>
+#include <future>
 #include <map>
 #include <set>
 
@@ -26,25 +28,44 @@
 
 #include "OsmDataFetcher.h"
 #include "StatisticsHandler.h"
+#include "osm/NodeLocationIndex.h"
+#include "osm/RequestBatchSizes.h"
 
 namespace olu::osm {
 
     class NodeHandler: public osmium::handler::Handler {
     public:
         explicit NodeHandler(const config::Config &config, OsmDataFetcher &odf,
-                             StatisticsHandler &stats): _config(config), _odf(&odf),
-                                                        _stats(&stats) { }
+                             StatisticsHandler &stats, RequestBatchSizes &batchSizes,
+                             const NodeLocationIndex *nodeLocationIndex = nullptr):
+            _config(config), _odf(&odf), _stats(&stats), _batchSizes(&batchSizes),
+            _nodeLocationIndex(nodeLocationIndex) { }
 
-        // Iterator for osmium::apply
+        // The requests for previous locations use the fetcher, the batch sizes and the index, so
+        // they have to be finished before the handler is destroyed
+        ~NodeHandler() { waitForLocationRequests(); }
+
+        // Iterator for osmium::apply. The previous locations of modified nodes are requested in
+        // the background as soon as a batch of them was read.
         void node(const osmium::Node& node);
 
         /**
          * Checks if the location of the given nodes from the change file has changed. If so, the
          * node is added to the _modifiedNodesWithChangedLocation set, otherwise to the
-         * _modifiedNodes set
+         * _modifiedNodes set.
+         * The previous locations are looked up in the node location index first, if one is
+         * given, and only the remaining nodes are fetched from the SPARQL endpoint. Waits for the
+         * requests that were started while reading the change file.
          */
         void checkNodesForLocationChange();
 
+        /**
+         * Waits until all requests for previous locations that were started while reading the
+         * change file are finished, and discards their results. Has to be called on every path
+         * that leaves the change file unprocessed, e.g. if an exception is thrown.
+         */
+        void waitForLocationRequests() noexcept;
+
         [[nodiscard]] std::set<id_t> getCreatedNodes() const { return _createdNodes; }
         [[nodiscard]] std::set<id_t> getModifiedNodes() const { return _modifiedNodes; }
         [[nodiscard]] std::set<id_t> getDeletedNodes() const { return _deletedNodes; }
@@ -67,13 +88,15 @@ namespace olu::osm {
         }
 
         /**
-         * @return True if the change file contains no nodes.
+         * @return True if the change file contains no nodes. Modified nodes count even if their
+         * location was not checked yet.
          */
-        bool empty() const {
+        [[nodiscard]] bool empty() const {
             return _createdNodes.empty() &&
                    _modifiedNodes.empty() &&
                    _modifiedNodesWithChangedLocation.empty() &&
-                   _deletedNodes.empty();
+                   _deletedNodes.empty() &&
+                   _modifiedNodesBuffer.empty();
         }
 
         /**
@@ -95,6 +118,8 @@ namespace olu::osm {
         config::Config _config;
         OsmDataFetcher* _odf;
         StatisticsHandler* _stats;
+        RequestBatchSizes* _batchSizes;
+        const NodeLocationIndex* _nodeLocationIndex;
 
         // Nodes that are in a delete-changeset in the change file.
         std::set<id_t> _deletedNodes;
@@ -103,6 +128,27 @@ namespace olu::osm {
 
 
         std::map<id_t, osmium::Location> _modifiedNodesBuffer;
+
+        struct LocationRequestResult {
+            std::map<id_t, osmium::Location> locations;
+            size_t indexHits = 0;
+            size_t indexMisses = 0;
+        };
+        // Ids of modified nodes for which the previous location was not requested yet
+        std::set<id_t> _nodesToRequest;
+        // Requests for previous locations that run in the background, oldest first
+        std::deque<std::future<LocationRequestResult>> _locationRequests;
+        // Previous locations of the modified nodes from the finished requests
+        std::map<id_t, osmium::Location> _previousLocations;
+
+        /**
+         * Starts a request for the previous locations of the nodes in `_nodesToRequest`. If the
+         * maximum number of concurrent requests is reached, waits for the oldest one first.
+         */
+        void requestLocations();
+
+        void collectLocations(std::future<LocationRequestResult> &request);
+
         // Nodes that are in a modify-changeset in the change file that don't change their location.
         std::set<id_t> _modifiedNodes;
         // Nodes that where modified in the changeset and have a location that has changed.
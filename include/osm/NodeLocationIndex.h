@@ -0,0 +1,95 @@
+// Copyright 2025, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef NODELOCATIONINDEX_H
+#define NODELOCATIONINDEX_H
+
+#include <cstdint>
+#include <filesystem>
+#include <set>
+#include <vector>
+
+#include "osmium/handler.hpp"
+#include "osmium/osm/location.hpp"
+
+#include "osm/Node.h"
+#include "util/MmapArray.h"
+#include "util/Types.h"
+
+namespace olu::osm {
+
+    /**
+     * Dense, file backed index that maps node ids to their location. The locations are stored as
+     * pairs of int32 coordinates at the position of the node id, so a lookup is a single memory
+     * access into the mapped file.
+     *
+     * The index can be used as an osmium handler: For a PBF file all node locations are stored,
+     * for a change file the locations of created and modified nodes are updated and deleted nodes
+     * are removed.
+     */
+    class NodeLocationIndex: public osmium::handler::Handler {
+    public:
+        explicit NodeLocationIndex(const std::filesystem::path &path): _locations(path) {}
+
+        // Iterator for osmium::apply
+        void node(const osmium::Node& node);
+
+        /**
+         * @return The location of the node with the given id, or an undefined location if the
+         * node is not in the index.
+         */
+        [[nodiscard]] osmium::Location get(const id_t &nodeId) const;
+
+        void set(const id_t &nodeId, const osmium::Location &location);
+        void remove(const id_t &nodeId);
+
+        /**
+         * Looks up the locations for the given node ids.
+         *
+         * @param nodeIds The ids of the nodes to look up
+         * @param nodes Vector to which a node object is appended for each node that was found
+         * @return The ids of the nodes that are not in the index
+         */
+        std::set<id_t> lookup(const std::set<id_t> &nodeIds, std::vector<Node> &nodes) const;
+
+        /**
+         * Removes all locations from the index.
+         */
+        void clear() { _locations.resize(0); }
+
+        /**
+         * Writes all changes to the index file.
+         */
+        void sync() const { _locations.sync(); }
+
+    private:
+        // The coordinates are stored XOR'd with the undefined coordinate, so that the zero bytes
+        // of a sparse file are read as an undefined location.
+        struct StoredLocation {
+            int32_t x;
+            int32_t y;
+        };
+
+        static constexpr int32_t UNDEFINED_MASK = osmium::Location::undefined_coordinate;
+
+        util::MmapArray<StoredLocation> _locations;
+    };
+
+} // namespace olu::osm
+
+#endif //NODELOCATIONINDEX_H
@@ -33,6 +33,13 @@ namespace olu::osm {
         explicit Osm2ttl(olu::config::Config *config, OsmDataFetcher *odf,
                          StatisticsHandler *stats): _config(config), _odf(odf), _stats(stats) {}
 
+        /**
+         * Fetches the osm2rdf options that the triples in the SPARQL endpoint were generated with
+         * and stores them in the config. Has to be called before `convert()` and
+         * `hasTripleForOption()`, which only read the options.
+         */
+        void fetchOptions();
+
         // Converts osm data to ttl triplets
         void convert();
 
@@ -60,7 +67,7 @@ namespace olu::osm {
         template <typename T>
         static void run(const osm2rdf::config::Config& config);
 
-        std::vector<std::string> getArgsFromEndpoint();
+        [[nodiscard]] std::vector<std::string> getArgsFromEndpoint() const;
     };
 
 } // namespace olu::osm
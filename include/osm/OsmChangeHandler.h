@@ -19,7 +19,13 @@
 #ifndef OSM_LIVE_UPDATES_OSMCHANGEHANDLER_H
 #define OSM_LIVE_UPDATES_OSMCHANGEHANDLER_H
 
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <set>
+#include <string>
+#include <vector>
 
 #include "Osm2ttl.h"
 #include "osmium/handler.hpp"
@@ -28,9 +34,13 @@
 #include "config/Config.h"
 #include "osm/OsmDataFetcher.h"
 #include "osm/NodeHandler.h"
+#include "osm/NodeLocationIndex.h"
 #include "osm/ReferencesHandler.h"
 #include "osm/RelationHandler.h"
+#include "osm/RelationMemberIndex.h"
+#include "osm/RequestBatchSizes.h"
 #include "osm/WayHandler.h"
+#include "osm/WayNodeIndex.h"
 #include "sparql/SparqlWrapper.h"
 #include "sparql/QueryWriter.h"
 #include "osm/StatisticsHandler.h"
@@ -49,16 +59,62 @@ namespace olu::osm {
     class OsmChangeHandler: public osmium::handler::Handler {
     public:
         explicit OsmChangeHandler(config::Config &config, OsmDataFetcher &odf,
-                                  StatisticsHandler &stats);
+                                  StatisticsHandler &stats,
+                                  const NodeLocationIndex *nodeLocationIndex = nullptr,
+                                  const WayNodeIndex *wayNodeIndex = nullptr,
+                                  const RelationMemberIndex *relationMemberIndex = nullptr);
         void run();
 
         /**
          * Send a SPARQL update query to the endpoint
+         *
+         * @param worker The index of the worker of `util::BatchHelper::doInBatchesConcurrently()`
+         * that sends the update. Workers with different indices can send updates at the same time.
          */
         void runUpdateQuery(const sparql::UpdateOperation & updateOp, const std::string& query,
-                            const std::vector<std::string> &prefixes);
+                            const std::vector<std::string> &prefixes, size_t worker = 0);
 
     private:
+        // Number of threads that run the stages of the update. At most four stages can run at
+        // the same time.
+        static constexpr size_t MAX_CONCURRENT_STAGES = 4;
+
+        /**
+         * Relevant triples from the osm2rdf output, folded like the inserted triples and grouped
+         * by the id of the osm object they belong to.
+         */
+        struct TriplesByObject {
+            std::map<id_t, std::vector<std::string>> nodes;
+            std::map<id_t, std::vector<std::string>> ways;
+            std::map<id_t, std::vector<std::string>> relations;
+            // Number of relevant triples before they were folded
+            size_t numOfTriples = 0;
+        };
+
+        /**
+         * SPARQL wrapper and update buffers of a worker that sends updates concurrently with the
+         * other workers.
+         */
+        struct UpdateWorker {
+            explicit UpdateWorker(const config::Config &config): sparql(config) { }
+
+            sparql::SparqlWrapper sparql;
+            sparql::PreparedUpdate update;
+        };
+
+        /**
+         * Sends an update that was prepared by the SPARQL wrapper to the endpoint and logs the
+         * response. Can be called from several threads at once.
+         */
+        void runPreparedUpdate(const sparql::PreparedUpdate &update);
+
+        /**
+         * Returns the number of batches for which updates can be sent at once. Updates are only
+         * sent concurrently to the endpoint, because the order of the output would be mixed up
+         * otherwise.
+         */
+        [[nodiscard]] size_t getMaxConcurrentUpdates() const;
+
         config::Config* _config;
         sparql::SparqlWrapper _sparql;
         sparql::QueryWriter _queryWriter;
@@ -66,6 +122,28 @@ namespace olu::osm {
         StatisticsHandler* _stats;
         Osm2ttl _osm2ttl;
 
+        // Buffers of the update that is sent by `runUpdateQuery()`
+        sparql::PreparedUpdate _update;
+        // Workers for the updates that are sent concurrently with the ones of `_sparql`, the
+        // worker with index i is at position i - 1
+        std::vector<std::unique_ptr<UpdateWorker>> _updateWorkers;
+        // Guards the statistics and the response file while updates are sent concurrently
+        std::mutex _updateMutex;
+
+        // Local index for node locations, which is consulted before the SPARQL endpoint. Can be
+        // null.
+        const NodeLocationIndex* _nodeLocationIndex;
+        // Local index for the nodes of ways, which is used instead of the SPARQL endpoint to find
+        // the ways that reference moved nodes if it was built. Can be null.
+        const WayNodeIndex* _wayNodeIndex;
+        // Local index for the members of relations, which is used instead of the SPARQL endpoint
+        // for the members of relations and the relations that reference changed nodes or ways if
+        // it was built. Can be null.
+        const RelationMemberIndex* _relationMemberIndex;
+
+        // Sizes of the batches for the different kinds of requests
+        RequestBatchSizes _batchSizes;
+
         /**
          * Osmium handler for the nodes in the change file.
          * Sorts the ids of the nodes into the respective sets (_createdNodes,
@@ -108,20 +186,12 @@ namespace olu::osm {
 
         /**
          * Fetches the ids of ways and relations of which the geometry needs to be updated and
-         * stores them in the corresponding set
+         * stores them in the corresponding set. The referencing ways and relations are taken
+         * from the way node index and the relation member index if they were built.
          */
         void getIdsOfRelationsToUpdateGeo();
         void getIdsOfWaysToUpdateGeo();
 
-        /**
-         * Fetches the ids of relations that are referenced in relations which geometry will be
-         * changed in this update process and stores them in the corresponding set
-         *
-         * @Warning This is currently skipped because osm2rdf does not calculate the geometries for
-         * relations that reference other relations
-         */
-        void getReferencedRelations();
-
         /**
          * Returns the path to a temporary file that is used to store the dummy nodes.
          *
@@ -152,7 +222,9 @@ namespace olu::osm {
         /**
          * Creates dummy nodes for the referenced nodes that are not in the change file. The dummy
          * nodes contain the node id and the location which is used for the nodes that are
-         * referenced in ways and writes them to a temporary file
+         * referenced in ways and writes them to a temporary file. The locations are taken from the
+         * node location index if possible. The batches are fetched concurrently, each one is
+         * written to its own file.
          */
         void createDummyNodes();
 
@@ -165,7 +237,8 @@ namespace olu::osm {
         /**
          * Creates dummy relations for the referenced relations that are not in the change file and
          * writes them to a temporary file.
-         * The dummy relation only contains the members of that relation
+         * The dummy relation only contains the members of that relation, which are taken from the
+         * relation member index if possible.
          */
         void createDummyRelations();
 
@@ -181,6 +254,55 @@ namespace olu::osm {
          */
         void deleteTriplesFromDatabase();
 
+        /**
+         * Passes the batch sizes that were reached for the different kinds of requests to the
+         * statistics.
+         */
+        void countBatchSizes() const;
+
+        /**
+         * Calls `deleteBatch` with each batch of the given ids and the index of the worker that
+         * processes it, for up to `getMaxConcurrentUpdates()` batches at once, and updates the
+         * progress bar after each batch.
+         *
+         * Unlike the insert batches, the delete bodies are built and compressed by the worker
+         * that sends them, not by a separate preparer thread. The workers run concurrently, so a
+         * body is built while the bodies of the other workers are sent. The worker also has to
+         * keep the ids of its batch, because the batch is split and sent again if the endpoint
+         * rejects it as too large.
+         */
+        void deleteInBatches(const std::set<id_t> &ids,
+                             const std::function<void(const std::set<id_t> &, size_t)> &deleteBatch,
+                             osm2rdf::util::ProgressBar &progress, size_t &counter);
+
+        /**
+         * @return The ids of the ways and relations whose triples are deleted, because they are
+         * in the change file
+         */
+        [[nodiscard]] std::set<id_t> getIdsOfWaysToDelete() const;
+        [[nodiscard]] std::set<id_t> getIdsOfRelationsToDelete() const;
+
+        /**
+         * @return The SPARQL update operations that delete the triples of the given objects, which
+         * depend on the osm2rdf options the triples in the database were generated with. Empty if
+         * no ids are given.
+         */
+        [[nodiscard]] std::vector<std::string>
+        getDeleteOperationsForNodes(const std::set<id_t> &nodeIds) const;
+        [[nodiscard]] std::vector<std::string>
+        getDeleteOperationsForWays(const std::set<id_t> &wayIds) const;
+        [[nodiscard]] std::vector<std::string>
+        getDeleteOperationsForRelations(const std::set<id_t> &relationIds) const;
+
+        /**
+         * @return The SPARQL update operations that delete the geometry triples of the given
+         * objects. Empty if no ids are given.
+         */
+        [[nodiscard]] std::vector<std::string>
+        getDeleteOperationsForWaysGeometry(const std::set<id_t> &wayIds) const;
+        [[nodiscard]] std::vector<std::string>
+        getDeleteOperationsForRelationsGeometry(const std::set<id_t> &relationIds) const;
+
         /**
          * Send SPARQL queries to delete all triples that belong to the nodes that are inserted to
          * the database
@@ -212,40 +334,83 @@ namespace olu::osm {
         void deleteRelationsGeometry(osm2rdf::util::ProgressBar &progress, size_t &counter);
 
         /**
-         * Send SPARQL queries to insert all relevant triples
+         * Filters the triples that where generated by osm2rdf and sends the relevant ones to the
+         * SPARQL endpoint.
+         *
+         * The osm2rdf output is streamed: each relevant triple is folded (blank nodes) and
+         * appended to the current batch. A batch is filled when its triples reach
+         * `Config::insertBatchBytes` bytes or `Config::batchSize` triples, so that the bodies of
+         * the insert operations have similar sizes. A filled batch is handed to a thread which
+         * writes and compresses the body of the INSERT update, and then to a sender thread which
+         * runs it, while the next batches are being built. At most `Config::DEFAULT_INSERT_QUEUE_SIZE`
+         * batches and updates wait in each step, so the memory usage does not depend on the size
+         * of the osm2rdf output.
+         */
+        void filterAndInsertRelevantTriples();
+
+        /**
+         * Deletes and inserts the triples of the objects in batches, if `Config::interleaveUpdates`
+         * is set. The delete operations and the new triples of each batch are sent in one update,
+         * so the objects are only missing from the database while that update is processed.
+         *
+         * The relevant triples are grouped by object first, so they are kept in memory.
+         */
+        void deleteAndInsertTriples();
+
+        /**
+         * Filters the triples that where generated by osm2rdf like
+         * `filterAndInsertRelevantTriples()`, but groups them by object instead of inserting them.
+         */
+        [[nodiscard]] TriplesByObject groupRelevantTriplesByObject() const;
+
+        /**
+         * Sends one update for each batch of the given ids, which runs the delete operations that
+         * `getDeleteOperations` returns for the batch and inserts the triples of the objects in the
+         * batch. If the triples exceed `Config::insertBatchBytes` bytes or `Config::batchSize`
+         * triples, the remaining triples are inserted in further updates for the batch.
          */
-        void insertTriplesToDatabase(const std::vector<triple_t> &triples);
+        void deleteAndInsertInBatches(
+            const std::set<id_t> &ids,
+            const std::function<std::vector<std::string>(const std::set<id_t> &)>
+                &getDeleteOperations,
+            const std::map<id_t, std::vector<std::string>> &triples,
+            osm2rdf::util::ProgressBar &progress, size_t &counter);
 
         /**
          * Filters the triples that where generated by osm2rdf. Relevant triples are triples for osm
          * elements that occurred in the change file or osm elements which geometry needs to be
          * updated. Irrelevant triples are triples that where generated for referenced elements.
+         *
+         * @param emit Function that is called for each relevant triple, in the order of the
+         * osm2rdf output
+         * @param countBytes Function that is called with the number of bytes read for each line
          */
-        [[nodiscard]] std::vector<triple_t> filterRelevantTriples() const;
+        void filterRelevantTriples(const std::function<void(triple_t)> &emit,
+                                   const std::function<void(size_t)> &countBytes) const;
 
         /**
-         * Checks if the given triple is relevant for the osm node object it belongs to and adds it
-         * to the relevantTriples vector if that is the case.
+         * Checks if the given triple is relevant for the osm node object it belongs to and passes
+         * it to `emit` if that is the case.
          */
         static void filterNodeTriple(const triple_t &nodeTriple, const std::set<id_t> &nodesToInsert,
-                              std::vector<triple_t> &relevantTriples,
+                              const std::function<void(triple_t)> &emit,
                               std::string &currentLink);
 
         /**
-         * Checks if the given triple is relevant for the osm way object it belongs to and adds it
-         * to the relevantTriples vector if that is the case.
+         * Checks if the given triple is relevant for the osm way object it belongs to and passes
+         * it to `emit` if that is the case.
          */
         void filterWayTriple(const triple_t &wayTriple, const std::set<id_t> &waysToInsert,
-                             std::vector<triple_t> &relevantTriples,
+                             const std::function<void(triple_t)> &emit,
                              std::string &currentLink) const;
 
         /**
          * Checks if the given triple is relevant for the osm relation object it belongs to and
-         * adds it to the relevantTriples vector if that is the case.
+         * passes it to `emit` if that is the case.
          */
         void filterRelationTriple(const triple_t &relationTriple,
                                                  const std::set<id_t> &relationsToInsert,
-                                                 std::vector<triple_t> &relevantTriples,
+                                                 const std::function<void(triple_t)> &emit,
                                                  std::string &currentLink) const;
 
     };
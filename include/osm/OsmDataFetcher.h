@@ -26,6 +26,8 @@
 #include "OsmDatabaseState.h"
 #include "config/Constants.h"
 #include "osm/Node.h"
+#include "osm/Relation.h"
+#include "osm/Way.h"
 
 #include "util/Types.h"
 
@@ -72,6 +74,24 @@ namespace olu::osm {
         virtual void
         fetchAndWriteNodesToFile(const std::string &filePath, const std::set<id_t> &nodeIds){}
 
+        /**
+         * Fetches the node members for the given ways and whether they have tags.
+         *
+         * @param wayIds The ids of the ways to fetch
+         * @return A vector containing a way object for each way that was returned by the SPARQL
+         * endpoint
+         */
+        virtual std::vector<Way> fetchWays(const std::set<id_t> &wayIds){return {};}
+
+        /**
+         * Fetches the members and the type for the given relations.
+         *
+         * @param relationIds The ids of the relations to fetch
+         * @return A vector containing a relation object for each relation that was returned by
+         * the SPARQL endpoint
+         */
+        virtual std::vector<Relation> fetchRelations(const std::set<id_t> &relationIds){return {};}
+
         /**
          * Fetches the members for the given relations and writes the relation to a file in the osm
          * XML format.
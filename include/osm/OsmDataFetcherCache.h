@@ -0,0 +1,198 @@
+// Copyright 2025, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef OSMDATAFETCHERCACHE_H
+#define OSMDATAFETCHERCACHE_H
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "osm/OsmDataFetcher.h"
+#include "osm/OsmObjectType.h"
+#include "osm/StatisticsHandler.h"
+
+namespace olu::osm {
+
+    /**
+     * Decorator for an `OsmDataFetcher` that remembers the nodes, ways and relations returned by
+     * the wrapped fetcher, so that each object is fetched at most once per run. Ids for which the
+     * wrapped fetcher returned no object are remembered as well.
+     *
+     * The member lists of ways and relations are always fetched completely, so that the ids
+     * needed by the `ReferencesHandler` and the dummy objects written afterward are served by
+     * the same query. All other requests are passed to the wrapped fetcher.
+     *
+     * The cache can be used from several threads. Each wrapped fetcher handles one request at a
+     * time, so requests run concurrently up to the number of wrapped fetchers.
+     */
+    class OsmDataFetcherCache final : public OsmDataFetcher {
+    public:
+        explicit OsmDataFetcherCache(std::unique_ptr<OsmDataFetcher> fetcher,
+                                     StatisticsHandler &stats): _stats(&stats) {
+            _idleFetchers.push_back(fetcher.get());
+            _fetchers.push_back(std::move(fetcher));
+        }
+
+        explicit OsmDataFetcherCache(std::vector<std::unique_ptr<OsmDataFetcher>> fetchers,
+                                     StatisticsHandler &stats):
+            _fetchers(std::move(fetchers)), _stats(&stats) {
+            for (const auto &fetcher: _fetchers) {
+                _idleFetchers.push_back(fetcher.get());
+            }
+        }
+
+        std::vector<Node> fetchNodes(const std::set<id_t> &nodeIds) override;
+
+        void fetchAndWriteNodesToFile(const std::string &filePath, const std::set<id_t> &nodeIds) override;
+
+        std::vector<Way> fetchWays(const std::set<id_t> &wayIds) override;
+
+        std::vector<Relation> fetchRelations(const std::set<id_t> &relationIds) override;
+
+        size_t fetchAndWriteRelationsToFile(const std::string &filePath, const std::set<id_t> &relationIds) override;
+
+        size_t fetchAndWriteWaysToFile(const std::string &filePath, const std::set<id_t> &wayIds) override;
+
+        member_ids_t fetchWaysMembers(const std::set<id_t> &wayIds) override;
+
+        std::pair<std::vector<id_t>, std::vector<id_t>>
+        fetchRelationMembers(const std::set<id_t> &relIds) override;
+
+        std::string fetchLatestTimestamp() override {
+            return withFetcher([](OsmDataFetcher &fetcher) {
+                return fetcher.fetchLatestTimestamp();
+            });
+        }
+
+        std::vector<id_t> fetchWaysReferencingNodes(const std::set<id_t> &nodeIds) override {
+            return withFetcher([&](OsmDataFetcher &fetcher) {
+                return fetcher.fetchWaysReferencingNodes(nodeIds);
+            });
+        }
+
+        std::vector<id_t> fetchRelationsReferencingNodes(const std::set<id_t> &nodeIds) override {
+            return withFetcher([&](OsmDataFetcher &fetcher) {
+                return fetcher.fetchRelationsReferencingNodes(nodeIds);
+            });
+        }
+
+        std::vector<id_t> fetchRelationsReferencingWays(const std::set<id_t> &wayIds) override {
+            return withFetcher([&](OsmDataFetcher &fetcher) {
+                return fetcher.fetchRelationsReferencingWays(wayIds);
+            });
+        }
+
+        std::vector<id_t>
+        fetchRelationsReferencingRelations(const std::set<id_t> &relationIds) override {
+            return withFetcher([&](OsmDataFetcher &fetcher) {
+                return fetcher.fetchRelationsReferencingRelations(relationIds);
+            });
+        }
+
+        std::string fetchOsm2RdfVersion() override {
+            return withFetcher([](OsmDataFetcher &fetcher) {
+                return fetcher.fetchOsm2RdfVersion();
+            });
+        }
+
+        std::map<std::string, std::string> fetchOsm2RdfOptions() override {
+            return withFetcher([&](OsmDataFetcher &fetcher) {
+                return fetcher.fetchOsm2RdfOptions();
+            });
+        }
+
+        OsmDatabaseState fetchUpdatesCompleteUntil() override {
+            return withFetcher([&](OsmDataFetcher &fetcher) {
+                return fetcher.fetchUpdatesCompleteUntil();
+            });
+        }
+
+        std::string fetchReplicationServer() override {
+            return withFetcher([](OsmDataFetcher &fetcher) {
+                return fetcher.fetchReplicationServer();
+            });
+        }
+
+    private:
+        std::vector<std::unique_ptr<OsmDataFetcher>> _fetchers;
+        StatisticsHandler* _stats;
+        std::mutex _mutex;
+        // Wrapped fetchers that do not handle a request at the moment, guarded by `_mutex`
+        std::vector<OsmDataFetcher*> _idleFetchers;
+        std::condition_variable _fetcherReleased;
+
+        /**
+         * Runs the request with a wrapped fetcher that is not used by another thread, and blocks
+         * until one is available.
+         */
+        template <typename Request>
+        std::invoke_result_t<Request, OsmDataFetcher&> withFetcher(Request &&request) {
+            OsmDataFetcher* fetcher;
+            {
+                std::unique_lock lock(_mutex);
+                _fetcherReleased.wait(lock, [this] { return !_idleFetchers.empty(); });
+                fetcher = _idleFetchers.back();
+                _idleFetchers.pop_back();
+            }
+
+            // Releases the fetcher even if the request throws
+            struct Release {
+                OsmDataFetcherCache* cache;
+                OsmDataFetcher* fetcher;
+                ~Release() {
+                    {
+                        std::lock_guard lock(cache->_mutex);
+                        cache->_idleFetchers.push_back(fetcher);
+                    }
+                    cache->_fetcherReleased.notify_one();
+                }
+            } release{this, fetcher};
+
+            return request(*fetcher);
+        }
+
+        template <typename T>
+        struct Cache {
+            std::unordered_map<id_t, T> objects;
+            // Ids for which the wrapped fetcher returned no object
+            std::unordered_set<id_t> missingIds;
+        };
+
+        Cache<Node> _nodes;
+        Cache<Way> _ways;
+        Cache<Relation> _relations;
+
+        /**
+         * Returns the remembered objects for the given ids and fetches the other ones with the
+         * given function.
+         */
+        template <typename T>
+        std::vector<T> fetchCached(const OsmObjectType &type, const std::set<id_t> &ids,
+                                   Cache<T> &cache,
+                                   const std::function<std::vector<T>(const std::set<id_t> &)>
+                                   &fetch);
+    };
+
+} // namespace olu::osm
+
+#endif //OSMDATAFETCHERCACHE_H
@@ -4,6 +4,7 @@
 
 #ifndef OSMDATAFETCHERQLEVER_H
 #define OSMDATAFETCHERQLEVER_H
+#include <fstream>
 #include <set>
 #include <string>
 
@@ -14,6 +15,7 @@
 #include "osm/Node.h"
 #include "sparql/SparqlWrapper.h"
 #include "sparql/QueryWriter.h"
+#include "util/TsvStream.h"
 #include "util/Types.h"
 
 namespace olu::osm {
@@ -27,6 +29,10 @@ namespace olu::osm {
 
         void fetchAndWriteNodesToFile(const std::string &filePath, const std::set<id_t> &nodeIds) override;
 
+        std::vector<Way> fetchWays(const std::set<id_t> &wayIds) override;
+
+        std::vector<Relation> fetchRelations(const std::set<id_t> &relationIds) override;
+
         size_t fetchAndWriteRelationsToFile(const std::string &filePath, const std::set<id_t> &relationIds) override;
 
         size_t fetchAndWriteWaysToFile(const std::string &filePath, const std::set<id_t> &wayIds) override;
@@ -61,9 +67,25 @@ namespace olu::osm {
         sparql::QueryWriter _queryWriter;
         simdjson::ondemand::parser _parser;
 
+        // Values of a row in the result of a query, in the order of the selected variables.
+        // Unbound values are empty.
+        using result_row_t = util::TsvStream::row_t;
+        result_row_t _row;
+
+        /**
+         * Sends the query to the endpoint and applies the given function to each row of the
+         * result, while the response is being received. The result is requested as tab-separated
+         * values if configured by the user, and in the QLever JSON format otherwise.
+         */
         void runQuery(const std::string &query,
                       const std::vector<std::string> &prefixes,
-                      std::function<void(simdjson::ondemand::value)> resultFunc);
+                      const std::function<void(const result_row_t &)> &resultFunc);
+
+        void runTsvQuery(std::ofstream &outputFile,
+                         const std::function<void(const result_row_t &)> &resultFunc);
+
+        void runJsonQuery(std::ofstream &outputFile,
+                          const std::function<void(const result_row_t &)> &resultFunc);
 
         /**
          * Parses the items in a list that is delimited by ";" and applies the given function to
@@ -77,21 +99,14 @@ namespace olu::osm {
         parseValueList(const std::string_view &list, std::function<T(std::string)> function);
 
         /**
-         * Iterates over the results of the given response and applies the given function to each
-         * JSON element in "res".
-         */
-        void forResults(const simdjson::padded_string &response,
-                        std::function<void(simdjson::ondemand::value)> func);
-
-        /**
-         * Returns the JSON element at "results.bindings" for the given document.
+         * Returns the string of the given JSON value, or an empty string if it is null.
          */
-        static simdjson::ondemand::value getResults(simdjson::ondemand::document &doc);
+        static std::string_view getString(simdjson::ondemand::value value);
 
         /**
-         * Returns the string at the "value" element for the given JSON element.
+         * Returns the value at the given index of the row.
          */
-        template <typename T> static T getValue(simdjson::ondemand::value value);
+        static std::string_view getValue(const result_row_t &row, size_t index);
     };
 }
 #endif //OSMDATAFETCHERQLEVER_H
@@ -27,6 +27,10 @@ namespace olu::osm {
 
         void fetchAndWriteNodesToFile(const std::string &filePath, const std::set<id_t> &nodeIds) override;
 
+        std::vector<Way> fetchWays(const std::set<id_t> &wayIds) override;
+
+        std::vector<Relation> fetchRelations(const std::set<id_t> &relationIds) override;
+
         size_t fetchAndWriteRelationsToFile(const std::string &filePath, const std::set<id_t> &relationIds) override;
 
         size_t fetchAndWriteWaysToFile(const std::string &filePath, const std::set<id_t> &wayIds) override;
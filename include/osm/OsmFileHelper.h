@@ -19,9 +19,18 @@
 #ifndef OSMFILEHELPER_H
 #define OSMFILEHELPER_H
 
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <queue>
 #include <string>
+#include <vector>
 
 #include <osmium/io/file.hpp>
+#include <osmium/io/gzip_compression.hpp>
 #include <osmium/osm/object.hpp>
 #include <osmium/object_pointer_collection.hpp>
 #include <osmium/visitor.hpp>
@@ -32,8 +41,15 @@
 #include "osmium/io/xml_output.hpp"
 #include <osmium/osm/object_comparisons.hpp>
 
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
 #include "osm2rdf/util/ProgressBar.h"
 
+#include "config/Constants.h"
+#include "util/ParallelSort.h"
+
 namespace olu::osm {
     /**
      * Ordering function for osmium::OSMObject that takes the deleted of the osm object into
@@ -54,12 +70,427 @@ namespace olu::osm {
         }
     };
 
+    /**
+     * Sorted stream of osm objects, which is one of the inputs of the k-way merge in
+     * `OsmObjectCollection`.
+     */
+    class SortedObjectSource {
+    public:
+        virtual ~SortedObjectSource() = default;
+
+        /**
+         * @return The current object, or nullptr if all objects were read.
+         */
+        [[nodiscard]] virtual const osmium::OSMObject* current() const = 0;
+        virtual void next() = 0;
+    };
+
+    /**
+     * Reads the objects of a sorted osm file, only one buffer is kept in memory at a time.
+     */
+    class SortedFileSource final : public SortedObjectSource {
+    public:
+        explicit SortedFileSource(const osmium::io::File &file):
+            _reader(file, osmium::osm_entity_bits::object) {
+            readBuffer();
+        }
+
+        [[nodiscard]] const osmium::OSMObject* current() const override {
+            return _done ? nullptr : &*_it;
+        }
+
+        void next() override {
+            if (++_it == _end) {
+                readBuffer();
+            }
+        }
+
+    private:
+        osmium::io::Reader _reader;
+        osmium::memory::Buffer _buffer;
+        osmium::memory::Buffer::t_const_iterator<osmium::OSMObject> _it;
+        osmium::memory::Buffer::t_const_iterator<osmium::OSMObject> _end;
+        bool _done = false;
+
+        void readBuffer() {
+            while ((_buffer = _reader.read())) {
+                _it = _buffer.cbegin<osmium::OSMObject>();
+                _end = _buffer.cend<osmium::OSMObject>();
+                if (_it != _end) {
+                    return;
+                }
+            }
+
+            _reader.close();
+            _done = true;
+        }
+    };
+
+    /**
+     * Iterates over a sorted vector of objects that are kept in memory.
+     */
+    class SortedPointerSource final : public SortedObjectSource {
+    public:
+        explicit SortedPointerSource(const std::vector<const osmium::OSMObject*> &objects):
+            _objects(&objects) { }
+
+        [[nodiscard]] const osmium::OSMObject* current() const override {
+            return _position < _objects->size() ? (*_objects)[_position] : nullptr;
+        }
+
+        void next() override { ++_position; }
+
+    private:
+        const std::vector<const osmium::OSMObject*>* _objects;
+        size_t _position = 0;
+    };
+
+    /**
+     * Collects the osm objects of several osm files and writes them sorted to a single file. Of
+     * consecutive objects with the same type and id, only the first one is written.
+     *
+     * The files can come from disk or from a memory buffer (`osmium::io::File(buffer, size,
+     * format)`), which is decompressed while it is parsed. Objects of unsorted files are kept in
+     * memory until `memoryLimit` bytes are used. Then they are sorted and written to a run file in
+     * `runDir`, so the memory usage is bounded. Files that are already sorted are not read into
+     * memory at all. All runs, sorted files and the objects in memory are combined with a k-way
+     * merge when the output is written. Without a `runDir`, no runs can be written, so the
+     * memory limit is ignored and all objects are kept in memory.
+     *
+     * @tparam TCompare Comparator type that defines the comparison function for osm objects.
+     */
+    template <typename TCompare>
+    class OsmObjectCollection {
+    public:
+        // Maximum number of sources that are merged at once. Each source has an open reader, so if
+        // there are more sources they are merged into intermediate runs first.
+        static constexpr size_t MAX_MERGE_WIDTH = 64;
+
+        explicit OsmObjectCollection(TCompare compareFunction,
+                                     const size_t memoryLimit = std::numeric_limits<size_t>::max(),
+                                     std::filesystem::path runDir = {}):
+            _compare(std::move(compareFunction)), _memoryLimit(memoryLimit),
+            _runDir(std::move(runDir)) { }
+
+        ~OsmObjectCollection() {
+            for (const auto &run: _runs) {
+                std::error_code error;
+                std::filesystem::remove(run, error);
+            }
+        }
+
+        OsmObjectCollection(const OsmObjectCollection &) = delete;
+        OsmObjectCollection &operator=(const OsmObjectCollection &) = delete;
+
+        /**
+         * Reads all osm objects of the given file into the collection. A file that is backed by
+         * a memory buffer can be released afterward.
+         */
+        void add(const osmium::io::File &file) {
+            osmium::io::Reader reader{file, osmium::osm_entity_bits::object};
+            while (osmium::memory::Buffer buffer = reader.read()) {
+                addBuffer(std::move(buffer));
+                if (isMemoryLimitExceeded()) {
+                    writeRun();
+                }
+            }
+            reader.close();
+        }
+
+        /**
+         * Reads all osm objects of the given files into the collection. The files are decoded in
+         * parallel, each one with its own reader, in groups of one file per thread. The memory
+         * limit is checked after each group.
+         *
+         * @param onFileRead Function that is called after each file was read
+         */
+        void add(const std::vector<osmium::io::File> &files,
+                 const std::function<void()> &onFileRead = [] {}) {
+            size_t numOfThreads = 1;
+#if defined(_OPENMP)
+            numOfThreads = static_cast<size_t>(omp_get_max_threads());
+#endif
+
+            for (size_t from = 0; from < files.size(); from += numOfThreads) {
+                const size_t to = std::min(from + numOfThreads, files.size());
+                std::vector<std::vector<osmium::memory::Buffer>> buffers(to - from);
+                std::exception_ptr error;
+#pragma omp parallel for schedule(dynamic)
+                for (size_t i = from; i < to; ++i) {
+                    try {
+                        osmium::io::Reader reader{files[i], osmium::osm_entity_bits::object};
+                        while (osmium::memory::Buffer buffer = reader.read()) {
+                            buffers[i - from].push_back(std::move(buffer));
+                        }
+                        reader.close();
+                    } catch (...) {
+#pragma omp critical
+                        {
+                            error = std::current_exception();
+                        }
+                    }
+#pragma omp critical
+                    {
+                        onFileRead();
+                    }
+                }
+
+                if (error) {
+                    std::rethrow_exception(error);
+                }
+
+                // The buffers are added in the order of the files, so the result does not depend
+                // on which thread finished first.
+                for (auto &fileBuffers: buffers) {
+                    for (auto &buffer: fileBuffers) {
+                        addBuffer(std::move(buffer));
+                    }
+                }
+                if (isMemoryLimitExceeded()) {
+                    writeRun();
+                }
+            }
+        }
+
+        /**
+         * Adds a file which objects are already sorted by the comparator. The file is not read
+         * into memory, but merged with the other objects when the output is written. The file has
+         * to exist until then.
+         */
+        void addSorted(const osmium::io::File &file) {
+            _sortedFiles.push_back(file);
+            _isMergePrepared = false;
+        }
+
+        /**
+         * @return True if the objects of the file are sorted by the comparator. Only two buffers
+         * of the file are kept in memory at a time.
+         */
+        [[nodiscard]] bool isSorted(const osmium::io::File &file) const {
+            osmium::io::Reader reader{file, osmium::osm_entity_bits::object};
+            osmium::memory::Buffer previousBuffer;
+            const osmium::OSMObject* previous = nullptr;
+            while (osmium::memory::Buffer buffer = reader.read()) {
+                for (const auto &object: buffer.select<osmium::OSMObject>()) {
+                    if (previous != nullptr && _compare(object, *previous)) {
+                        reader.close();
+                        return false;
+                    }
+                    previous = &object;
+                }
+                // The previous object points into this buffer, moving it does not change its data
+                previousBuffer = std::move(buffer);
+            }
+            reader.close();
+            return true;
+        }
+
+        /**
+         * Calls `callback` with each collected object, in the order in which they are written.
+         * Of consecutive objects with the same type and id, only the first one is passed. The
+         * objects are only valid during the call.
+         */
+        template <typename TCallback>
+        void forEach(TCallback &&callback) {
+            prepareMerge();
+            forEachMerged(_mergeFiles, _objects, callback);
+        }
+
+        /**
+         * Writes all collected objects sorted to the output file.
+         */
+        void write(const std::string &outputFile) {
+            write(outputFile, [](const osmium::OSMObject &) { return true; });
+        }
+
+        /**
+         * Writes all collected objects for which `filter` returns true sorted to the output file.
+         * The filter is called in the same order as the callback of `forEach()`.
+         */
+        template <typename TFilter>
+        void write(const std::string &outputFile, TFilter &&filter) {
+            prepareMerge();
+            merge(_mergeFiles, _objects, outputFile, filter);
+        }
+
+    private:
+        TCompare _compare;
+        size_t _memoryLimit;
+        std::filesystem::path _runDir;
+
+        std::vector<osmium::memory::Buffer> _buffers;
+        std::vector<const osmium::OSMObject*> _objects;
+        size_t _memoryUsage = 0;
+
+        std::vector<osmium::io::File> _sortedFiles;
+        std::vector<std::filesystem::path> _runs;
+
+        // The files that are merged with the objects in memory, set by `prepareMerge()`
+        std::vector<osmium::io::File> _mergeFiles;
+        bool _isMergePrepared = false;
+
+        void addBuffer(osmium::memory::Buffer buffer) {
+            for (const auto &object: buffer.select<osmium::OSMObject>()) {
+                _objects.push_back(&object);
+            }
+            _memoryUsage += buffer.capacity();
+            // We need to keep the buffer in storage
+            _buffers.push_back(std::move(buffer));
+            _isMergePrepared = false;
+        }
+
+        [[nodiscard]] bool isMemoryLimitExceeded() const {
+            return _memoryUsage + _objects.size() * sizeof(void*) > _memoryLimit;
+        }
+
+        void sortObjects() {
+            util::parallelSort(_objects.begin(), _objects.end(),
+                               [this](const osmium::OSMObject* lhs, const osmium::OSMObject* rhs) {
+                                   return _compare(*lhs, *rhs);
+                               });
+        }
+
+        std::filesystem::path nextRunPath() {
+            std::filesystem::create_directories(_runDir);
+            _runs.push_back(_runDir / ("run" + std::to_string(_runs.size())
+                                       + config::constants::OSM_CHANGE_FILE_EXTENSION));
+            return _runs.back();
+        }
+
+        /**
+         * Sorts the objects in memory and writes them to a new run file. Does nothing if no run
+         * directory is set, the objects then stay in memory until the output is written.
+         */
+        void writeRun() {
+            if (_runDir.empty()) {
+                return;
+            }
+
+            sortObjects();
+            merge({}, _objects, nextRunPath(), [](const osmium::OSMObject &) { return true; });
+
+            _objects.clear();
+            _buffers.clear();
+            _memoryUsage = 0;
+        }
+
+        /**
+         * Sorts the objects in memory and merges runs and sorted files into intermediate runs
+         * until the remaining files and the objects in memory can be merged at once.
+         */
+        void prepareMerge() {
+            if (_isMergePrepared) {
+                return;
+            }
+
+            std::vector<osmium::io::File> files = _sortedFiles;
+            for (const auto &run: _runs) {
+                files.emplace_back(run.string());
+            }
+            while (!_runDir.empty() && files.size() >= MAX_MERGE_WIDTH) {
+                std::vector<osmium::io::File> merged;
+                for (size_t from = 0; from < files.size(); from += MAX_MERGE_WIDTH) {
+                    const auto to = std::min(from + MAX_MERGE_WIDTH, files.size());
+                    if (to - from == 1) {
+                        merged.push_back(files[from]);
+                        continue;
+                    }
+
+                    const auto runPath = nextRunPath();
+                    merge(std::vector(files.begin() + from, files.begin() + to), {}, runPath,
+                          [](const osmium::OSMObject &) { return true; });
+                    merged.emplace_back(runPath.string());
+                }
+                files = std::move(merged);
+            }
+
+            sortObjects();
+            _mergeFiles = std::move(files);
+            _isMergePrepared = true;
+        }
+
+        /**
+         * K-way merge of the sorted files and sorted objects, which calls `callback` with each
+         * object that has another type or id than the previous one.
+         */
+        template <typename TCallback>
+        void forEachMerged(const std::vector<osmium::io::File> &files,
+                           const std::vector<const osmium::OSMObject*> &objects,
+                           TCallback &callback) const {
+            std::vector<std::unique_ptr<SortedObjectSource>> sources;
+            for (const auto &file: files) {
+                sources.push_back(std::make_unique<SortedFileSource>(file));
+            }
+            sources.push_back(std::make_unique<SortedPointerSource>(objects));
+
+            auto greater = [this, &sources](const size_t a, const size_t b) {
+                return _compare(*sources[b]->current(), *sources[a]->current());
+            };
+            std::priority_queue<size_t, std::vector<size_t>, decltype(greater)> queue(greater);
+            for (size_t i = 0; i < sources.size(); ++i) {
+                if (sources[i]->current() != nullptr) {
+                    queue.push(i);
+                }
+            }
+
+            // The last passed object might be in a buffer that was already released, so only
+            // its type and id are kept.
+            std::optional<std::pair<osmium::item_type, osmium::object_id_type>> lastPassed;
+            while (!queue.empty()) {
+                const size_t source = queue.top();
+                queue.pop();
+
+                const osmium::OSMObject* object = sources[source]->current();
+                if (const std::pair typeAndId(object->type(), object->id());
+                    lastPassed != typeAndId) {
+                    callback(*object);
+                    lastPassed = typeAndId;
+                }
+
+                sources[source]->next();
+                if (sources[source]->current() != nullptr) {
+                    queue.push(source);
+                }
+            }
+        }
+
+        /**
+         * K-way merge of the sorted files and sorted objects into the output file. Only the
+         * objects for which `filter` returns true are written.
+         */
+        template <typename TFilter>
+        void merge(const std::vector<osmium::io::File> &files,
+                   const std::vector<const osmium::OSMObject*> &objects,
+                   const std::filesystem::path &outputFile, TFilter &&filter) const {
+            osmium::io::Writer writer{osmium::io::File(outputFile.string()),
+                                      osmium::io::overwrite::allow};
+            auto out = make_output_iterator(writer);
+            auto writeObject = [&filter, &out](const osmium::OSMObject &object) {
+                if (filter(object)) {
+                    *out = object;
+                }
+            };
+            forEachMerged(files, objects, writeObject);
+            writer.close();
+        }
+    };
+
     class OsmFileHelper {
     public:
+        // Rough estimate of the memory needed to keep the objects of an osm file in memory,
+        // relative to its size.
+        static constexpr size_t ESTIMATED_MEMORY_PER_FILE_BYTE = 4;
+
         /**
          * Merges multiple osmium::io::File objects into a single output file
          * while sorting the objects by the given comparator.
          *
+         * The input files are decoded in parallel and the objects are sorted in parallel, using
+         * the OpenMP threads. If the input files are expected to need more memory than
+         * `memoryLimit`, each input file is checked for being sorted first. Sorted input files
+         * are merged directly from disk, the others are sorted in runs of at most `memoryLimit`
+         * bytes in `runDir`.
+         *
          * @tparam TCompare Comparator type that defines the comparison function for osm objects.
          * @param inputFiles Files to merge and sort.
          * @param outputFile Path to the output file where the merged and sorted objects will be
@@ -67,37 +498,79 @@ namespace olu::osm {
          * @param compareFunction Compartor implementation that defines the sorting order of the
          * osm objects.
          * @param withProgressbar If true, a progress bar will be displayed during the process.
+         * @param memoryLimit Maximum number of bytes used for the objects kept in memory.
+         * @param runDir Directory for temporary run files.
+         */
+        template <typename TCompare>
+        static void mergeAndSortFiles(
+            std::vector<osmium::io::File> &inputFiles, const std::string &outputFile,
+            TCompare && compareFunction, const bool &withProgressbar,
+            const size_t &memoryLimit = std::numeric_limits<size_t>::max(),
+            const std::filesystem::path &runDir = {}) {
+            OsmObjectCollection objects(std::forward<TCompare>(compareFunction), memoryLimit,
+                                        runDir);
+            addFiles(objects, inputFiles, withProgressbar, memoryLimit, runDir);
+            objects.write(outputFile);
+        }
+
+        /**
+         * Adds the input files to the collection, like `mergeAndSortFiles()` does before the
+         * output is written. Sorted input files are only checked for being sorted if the run
+         * directory is set and the input files are expected to need more memory than
+         * `memoryLimit`.
          */
         template <typename TCompare>
-        static void mergeAndSortFiles(std::vector<osmium::io::File> &inputFiles,
-                                      const std::string &outputFile,
-                                      TCompare && compareFunction,
-                                      const bool &withProgressbar) {
-            osmium::io::Writer writer{outputFile, osmium::io::overwrite::allow};
-            const auto out = make_output_iterator(writer);
+        static void addFiles(OsmObjectCollection<TCompare> &objects,
+                             const std::vector<osmium::io::File> &inputFiles,
+                             const bool &withProgressbar,
+                             const size_t &memoryLimit = std::numeric_limits<size_t>::max(),
+                             const std::filesystem::path &runDir = {}) {
+            size_t estimatedMemory = 0;
+            for (const auto &file: inputFiles) {
+                estimatedMemory += ESTIMATED_MEMORY_PER_FILE_BYTE * (file.buffer() != nullptr
+                    ? file.buffer_size() : std::filesystem::file_size(file.filename()));
+            }
+            const bool checkIfSorted = !runDir.empty() && estimatedMemory > memoryLimit;
 
             osm2rdf::util::ProgressBar readProgress(inputFiles.size(), withProgressbar);
             size_t counter = 0;
             readProgress.update(counter);
 
-            std::vector<osmium::memory::Buffer> changes;
-            osmium::ObjectPointerCollection objects;
-            for (const osmium::io::File& change_file : inputFiles) {
-                osmium::io::Reader reader{change_file, osmium::osm_entity_bits::object};
-                while (osmium::memory::Buffer buffer = reader.read()) {
-                    apply(buffer, objects);
-                    // We need to keep the buffer in storage
-                    changes.push_back(std::move(buffer));
+            // Sorted files are merged directly from disk, so they only have to be checked
+            std::vector<char> isSorted(inputFiles.size(), false);
+            if (checkIfSorted) {
+                std::exception_ptr error;
+#pragma omp parallel for schedule(dynamic)
+                for (size_t i = 0; i < inputFiles.size(); ++i) {
+                    try {
+                        isSorted[i] = objects.isSorted(inputFiles[i]);
+                    } catch (...) {
+#pragma omp critical
+                        {
+                            error = std::current_exception();
+                        }
+                    }
+                }
+
+                if (error) {
+                    std::rethrow_exception(error);
                 }
-                reader.close();
-                readProgress.update(++counter);
             }
-            readProgress.done();
 
-            objects.sort(compareFunction);
+            std::vector<osmium::io::File> unsortedFiles;
+            for (size_t i = 0; i < inputFiles.size(); ++i) {
+                if (isSorted[i]) {
+                    objects.addSorted(inputFiles[i]);
+                    readProgress.update(++counter);
+                } else {
+                    unsortedFiles.push_back(inputFiles[i]);
+                }
+            }
 
-            std::unique_copy(objects.cbegin(), objects.cend(), out, osmium::object_equal_type_id());
-            writer.close();
+            objects.add(unsortedFiles, [&readProgress, &counter] {
+                readProgress.update(++counter);
+            });
+            readProgress.done();
         }
     };
 }
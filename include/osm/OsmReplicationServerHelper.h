@@ -19,6 +19,9 @@
 #ifndef OSMREPLICATIONSERVERHELPER_H
 #define OSMREPLICATIONSERVERHELPER_H
 
+#include <functional>
+#include <map>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -39,7 +42,7 @@ namespace olu::osm {
 
         /**
          * Fetches the database state (sequence number and timestamp) for the given sequence number
-         * from the server
+         * from the server. Fetched states are cached.
          *
          * @param sequenceNumber the sequence number to fetch the database state for
          * @return The database state for the provided sequence number
@@ -55,13 +58,32 @@ namespace olu::osm {
         [[nodiscard]] OsmDatabaseState fetchLatestDatabaseState() const;
 
         /**
-         * Fetches the .osc change file from the server, writes it to a file and returns the path to
-         * the file. The file might be compressed with gzip.
+         * Fetches the .osc change files for the sequence numbers between `fromSeqNum` and
+         * `toSeqNum` from the server and writes them to the change file directory. The files
+         * might be compressed with gzip.
          *
-         * @param sequenceNumber The sequence number to fetch the change file for
-         * @return The path to the location of the fetched .osm Change file
+         * Up to `Config::maxConcurrentDownloads` files are downloaded at once, and each response
+         * is written to its file while it is received.
+         *
+         * @param fromSeqNum Sequence number to start fetching from
+         * @param toSeqNum Sequence number to stop fetching at
+         * @param onFetched Function that is called with the sequence number of each fetched
+         * change file, in ascending order
          */
-        void fetchChangeFile(int &sequenceNumber) const;
+        void fetchChangeFiles(int fromSeqNum, int toSeqNum,
+                              const std::function<void(int)> &onFetched) const;
+
+        /**
+         * Fetches the gzip compressed .osc change files for the sequence numbers between
+         * `fromSeqNum` and `toSeqNum` from the server like `fetchChangeFiles()`, but keeps them
+         * in memory instead of writing them to disk.
+         *
+         * @param onFetched Function that is called with the sequence number and the compressed
+         * content of each fetched change file, in ascending order. The content is released after
+         * the call.
+         */
+        void streamChangeFiles(int fromSeqNum, int toSeqNum,
+                               const std::function<void(int, std::string &)> &onFetched) const;
 
         /**
          * Fetches the 'nearest' database state for the given timestamp from the server, meaning the
@@ -71,10 +93,37 @@ namespace olu::osm {
          * @return The 'nearest' database state for the given timestamp
          */
         void fetchDatabaseStateForTimestamp(const std::string &timeStamp) const;
+
+        /**
+         * Searches the latest database state which timestamp is before or equal to the given
+         * timestamp, with an interpolation search over the sequence numbers. Only O(log n) state
+         * files are fetched, where n is the number of sequence numbers between the searched and
+         * the latest state.
+         *
+         * @param timeStamp Timestamp to search the database state for
+         * @param latestState The latest database state, which has to be after the timestamp
+         * @param guessedSeqNum Sequence number that is probed first, or -1 if there is no guess
+         * @param fetchState Function that returns the database state for a sequence number
+         * @return The latest database state before or equal to the timestamp
+         */
+        static OsmDatabaseState searchDatabaseStateForTimestamp(
+            const std::string &timeStamp, const OsmDatabaseState &latestState, int guessedSeqNum,
+            const std::function<OsmDatabaseState(int)> &fetchState);
     private:
         config::Config* _config;
         StatisticsHandler* _stats;
 
+        // Database states that were already fetched, by sequence number
+        mutable std::map<int, OsmDatabaseState> _stateCache;
+        mutable std::mutex _stateCacheMutex;
+
+        /**
+         * Downloads the change files for the sequence numbers between `fromSeqNum` and
+         * `toSeqNum`, either to the change file directory or into memory.
+         */
+        void downloadChangeFiles(int fromSeqNum, int toSeqNum, bool keepInMemory,
+                                 const std::function<void(int, std::string &)> &onFetched) const;
+
         /**
          * Sends a HTTP request to the replication server and tries to extract a data base state
          * from the returned state file.
@@ -94,18 +143,6 @@ namespace olu::osm {
          */
         static OsmDatabaseState extractStateFromStateFile(const std::string& stateFile);
 
-        /**
-         * Fetches the state files for the sequence numbers between `fromSeqNum` and `toSeqNum`
-         * from the server and returns a vector with the extracted database states.
-         *
-         * @param fromSeqNum Sequence number to start fetching from
-         * @param toSeqNum Sequence number to stop fetching at
-         * @return A vector containing the database states for the sequence numbers between
-         * `fromSeqNum` and `toSeqNum` sorted by sequence number in descending order.
-         */
-        [[nodiscard]] std::vector<OsmDatabaseState>
-        fetchDatabaseStatesForSequenceNumbers(int fromSeqNum, int toSeqNum) const;
-
         /**
          * Makes an educated guess for the sequence number based on the timestamp and the
          * replication server url.
@@ -25,7 +25,11 @@
 #include "OsmChangeHandler.h"
 #include "config/Config.h"
 #include "osm/StatisticsHandler.h"
+#include "osm/NodeLocationIndex.h"
+#include "osm/RelationMemberIndex.h"
+#include "osm/WayNodeIndex.h"
 #include "osm/OsmDataFetcher.h"
+#include "osm/OsmFileHelper.h"
 #include "osm/OsmReplicationServerHelper.h"
 
 namespace olu::osm {
@@ -50,6 +54,14 @@ namespace olu::osm {
         std::unique_ptr<OsmDataFetcher> _odf;
         sparql::QueryWriter _queryWriter;
 
+        // Local index for node locations, only present if the user specified an index directory.
+        std::unique_ptr<NodeLocationIndex> _nodeLocationIndex;
+        // Local index for the nodes of ways, only present if the user specified an index directory.
+        std::unique_ptr<WayNodeIndex> _wayNodeIndex;
+        // Local index for the members of relations, only present if the user specified an index
+        // directory.
+        std::unique_ptr<RelationMemberIndex> _relationMemberIndex;
+
         /**
          * Decides which sequence number to start from.
          *
@@ -74,10 +86,25 @@ namespace olu::osm {
         */
         void fetchChangeFiles();
 
+        /**
+        * Downloads all change files from the given sequence number to the `latest` one and merges
+        * them into a single change file without storing them in the /changes directory. Each
+        * change file is decompressed and parsed from memory as soon as it was downloaded, while
+        * the following ones are still being downloaded.
+        */
+        void fetchAndMergeChangeFiles();
+
         /**
         * Uses osmium to merge all change files in the /changes directory into a single one.
         */
-        void mergeChangeFiles(const std::string &pathToChangeFileDir) const;
+        void mergeChangeFiles(const std::string &pathToChangeFileDir);
+
+        /**
+         * Writes the merged change file. If the user specified a bounding box or polygon, only
+         * the objects in the extract are written.
+         */
+        void writeChangeFile(
+            OsmObjectCollection<object_order_type_id_reverse_version_delete> &objects);
 
         /**
         * Delete all files in the /changes dir
@@ -112,10 +139,15 @@ namespace olu::osm {
         void insertMetadataTriples(OsmChangeHandler &och);
 
         /**
-         * Applies the user-specified bounding box or polygon to the change files
-         * by using the 'extract' option from the 'osmium-tool'
+         * Rebuilds the local indexes from the PBF file specified by the user.
+         */
+        void buildIndexes() const;
+
+        /**
+         * Applies the objects in the merged change file to the local indexes, so that they match
+         * the state of the SPARQL endpoint after the update.
          */
-        void applyBoundaries() const;
+        void updateIndexes() const;
     };
 
     /**
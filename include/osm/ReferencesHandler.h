@@ -19,11 +19,15 @@
 #ifndef REFERENCESHANDLER_H
 #define REFERENCESHANDLER_H
 
+#include <mutex>
+
 #include "osmium/handler.hpp"
 
 #include "osm/NodeHandler.h"
 #include "osm/WayHandler.h"
 #include "osm/RelationHandler.h"
+#include "osm/RelationMemberIndex.h"
+#include "osm/RequestBatchSizes.h"
 
 namespace olu::osm {
     class ReferencesHandler: public osmium::handler::Handler {
@@ -32,20 +36,39 @@ namespace olu::osm {
                                    OsmDataFetcher &odf,
                                    NodeHandler &nodeHandler,
                                    WayHandler &wayHandler,
-                                   RelationHandler &relationHandler):
+                                   RelationHandler &relationHandler,
+                                   RequestBatchSizes &batchSizes,
+                                   const RelationMemberIndex *relationMemberIndex = nullptr):
             _config(config),
             _odf(&odf),
+            _batchSizes(&batchSizes),
             _nodeHandler(nodeHandler),
             _wayHandler(wayHandler),
-            _relationHandler(relationHandler) {}
+            _relationHandler(relationHandler),
+            _relationMemberIndex(relationMemberIndex) {}
 
-        // Iterators for osmium::apply
+        // Iterators for osmium::apply. The members of the ways and relations are only recorded
+        // here, because the change file is read in a single pass and the node, way and relation
+        // handlers have not seen all objects yet. Use `resolveReferences()` afterward.
         void way(const osmium::Way& way);
         void relation(const osmium::Relation& relation);
 
+        /**
+         * Resolves the member lists recorded while reading the change file. Each member that is
+         * not present in the change file is stored in the corresponding set (_referencedNodes,
+         * _referencedWays, _referencedRelations). The recorded member lists are released
+         * afterward.
+         *
+         * @warning Has to be called after all objects in the change file have been read and the
+         * nodes have been checked for location changes.
+         */
+        void resolveReferences();
+
         /**
          * Fetches the ids of all nodes and ways that are referenced by the relation with the given
-         * ids and stores them in the corresponding set (_referencedNodes, _referencedWays)
+         * ids and stores them in the corresponding set (_referencedNodes, _referencedWays). The
+         * members are taken from the relation member index if possible. The other relations are
+         * fetched in batches, up to `Config::maxConcurrentRequests` at once.
          *
          * @param relationIds The ids of the relations for which the referenced nodes and ways
          * should be fetched
@@ -54,28 +77,46 @@ namespace olu::osm {
 
         /**
          * Fetches the ids of all nodes that are referenced by the way with the given
-         * ids and stores them in the corresponding set (_referencedNodes)
+         * ids and stores them in the corresponding set (_referencedNodes). The ways are fetched in
+         * batches, up to `Config::maxConcurrentRequests` at once.
          *
          * @param wayIds The ids of the ways for which the referenced nodes should be fetched
          */
         void getReferencesForWays(const std::set<id_t> &wayIds);
 
         [[nodiscard]] std::set<id_t> getReferencedNodes() const {
+            std::lock_guard lock(_mutex);
             return _referencedNodes;
         }
         [[nodiscard]] std::set<id_t> getReferencedWays() const {
+            std::lock_guard lock(_mutex);
             return _referencedWays;
         }
         [[nodiscard]] std::set<id_t> getReferencedRelations() const {
+            std::lock_guard lock(_mutex);
             return _referencedRelations;
         }
 
     private:
         config::Config& _config;
         OsmDataFetcher* _odf;
+        RequestBatchSizes* _batchSizes;
         NodeHandler& _nodeHandler;
         WayHandler& _wayHandler;
         RelationHandler& _relationHandler;
+        // Local index for the members of relations, which is consulted before the SPARQL
+        // endpoint if it was built. Can be null.
+        const RelationMemberIndex* _relationMemberIndex;
+
+        // Ids of the nodes, ways and relations that are members of the ways and relations in the
+        // change file. Can contain duplicates until `resolveReferences()` is called.
+        member_ids_t _nodeMembers;
+        member_ids_t _wayMembers;
+        member_ids_t _relationMembers;
+
+        // Guards the referenced ids below, because the references of ways and relations are
+        // fetched at the same time
+        mutable std::mutex _mutex;
 
         // Nodes that are referenced by a way or relation that are NOT present in the change file,
         // meaning they have to be fetched from the database
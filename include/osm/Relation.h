@@ -0,0 +1,51 @@
+// Copyright 2025, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef OSM_LIVE_UPDATES_RELATION_H
+#define OSM_LIVE_UPDATES_RELATION_H
+
+#include <string>
+
+#include "osm/RelationMember.h"
+#include "util/Types.h"
+
+namespace olu::osm {
+
+    class Relation {
+    public:
+        explicit Relation(id_t id, std::string type, relation_members_t members);
+
+        /**
+         * Returns the relation as an XML osm object, which only contains the members and the
+         * "type" tag.
+         */
+        [[nodiscard]] std::string getXml() const;
+
+        [[nodiscard]] id_t getId() const { return id; }
+        // Value of the "type" tag of the relation, empty if the relation has no such tag
+        [[nodiscard]] const std::string& getType() const { return type; }
+        [[nodiscard]] const relation_members_t& getMembers() const { return members; }
+    protected:
+        id_t id;
+        std::string type;
+        relation_members_t members;
+    };
+
+}
+
+#endif //OSM_LIVE_UPDATES_RELATION_H
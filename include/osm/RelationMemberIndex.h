@@ -0,0 +1,158 @@
+// Copyright 2025, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef RELATIONMEMBERINDEX_H
+#define RELATIONMEMBERINDEX_H
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "osmium/handler.hpp"
+#include "osmium/osm/relation.hpp"
+
+#include "osm/OsmObjectType.h"
+#include "osm/Relation.h"
+#include "osm/RelationMember.h"
+#include "util/PersistentMultiMap.h"
+#include "util/Types.h"
+
+namespace olu::osm {
+
+    /**
+     * File backed store of the member lists of all relations, together with a reverse index
+     * from the members to the relations that reference them. This replaces the SPARQL queries
+     * for the members of relations and for the relations that reference moved nodes or changed
+     * ways.
+     *
+     * The index has to be built once from a complete data set (PBF file) between `beginBuild()`
+     * and `endBuild()`. After that, it can be used as an osmium handler for change files: The
+     * old members of each relation in the change file are replaced by the new ones, and the
+     * changes are written to disk on `commit()`. An index that was never built is not
+     * maintained and contains no entries.
+     */
+    class RelationMemberIndex: public osmium::handler::Handler {
+    public:
+        explicit RelationMemberIndex(const std::filesystem::path &indexDir);
+
+        // Iterator for osmium::apply
+        void relation(const osmium::Relation& relation);
+
+        /**
+         * Rebuilds the index: The relations that are passed to `relation()` between
+         * `beginBuild()` and `endBuild()` replace the previous content of the index.
+         */
+        void beginBuild();
+        void endBuild();
+
+        /**
+         * @return True if the index was built from a complete data set and can be used for
+         * lookups.
+         */
+        [[nodiscard]] bool isBuilt() const { return _relationTypes.isBuilt(); }
+
+        /**
+         * Looks up the members of the given relations.
+         *
+         * @param relationIds The ids of the relations to look up
+         * @param relations Vector to which an entry is appended for each relation that was found
+         * @return The ids of the relations that are not in the index
+         */
+        std::set<id_t> lookup(const std::set<id_t> &relationIds,
+                              std::vector<Relation> &relations) const;
+
+        /**
+         * @return The ids of all relations that have at least one of the given objects as member.
+         */
+        [[nodiscard]] std::set<id_t> getRelationsReferencing(const OsmObjectType &memberType,
+                                                             const std::set<id_t> &memberIds) const;
+
+        /**
+         * Writes the changes of the last change file to the index files.
+         */
+        void commit();
+
+    private:
+        struct StoredMember {
+            // Position of the member in the member list of the relation
+            uint32_t position;
+            // Id of the role in the string table
+            uint32_t roleId;
+            id_t ref;
+            OsmObjectType type;
+
+            auto operator<=>(const StoredMember &other) const = default;
+        };
+
+        // Maps relation ids to their members
+        util::PersistentMultiMap<StoredMember> _membersOfRelations;
+        // Maps relation ids to the id of their "type" tag in the string table. Each relation in
+        // the index has exactly one entry, which refers to the empty string if it has no type.
+        util::PersistentMultiMap<uint32_t> _relationTypes;
+        // Maps the keys of members (see `getMemberKey()`) to the ids of the relations that
+        // reference them
+        util::PersistentMultiMap<id_t> _relationsOfMembers;
+
+        // Only present while the index is built
+        std::unique_ptr<util::PersistentMultiMap<StoredMember>::Builder> _membersOfRelationsBuilder;
+        std::unique_ptr<util::PersistentMultiMap<uint32_t>::Builder> _relationTypesBuilder;
+        std::unique_ptr<util::PersistentMultiMap<id_t>::Builder> _relationsOfMembersBuilder;
+
+        // Table of the distinct roles and relation types. Each string is stored once and referred
+        // to by its position. New strings are appended to the file on `commit()`.
+        std::filesystem::path _stringsPath;
+        std::vector<std::string> _strings;
+        std::unordered_map<std::string, uint32_t> _stringIds;
+        size_t _numOfStoredStrings = 0;
+
+        /**
+         * @return The id of the given string in the string table. The string is added to the
+         * table if it is not already in there.
+         */
+        uint32_t getStringId(const std::string &string);
+        void readStrings();
+        void writeStrings();
+
+        /**
+         * Combines the type and the id of a member into one key for the reverse index.
+         */
+        static id_t getMemberKey(const OsmObjectType &type, const id_t &id) {
+            return id * 4 + static_cast<id_t>(type);
+        }
+    };
+
+    /**
+     * Exception that can appear inside the `RelationMemberIndex` class.
+     */
+    class RelationMemberIndexException final : public std::exception {
+        std::string message;
+    public:
+        explicit RelationMemberIndexException(const char* msg) : message(msg) { }
+
+        [[nodiscard]] const char* what() const noexcept override {
+            return message.c_str();
+        }
+    };
+
+} // namespace olu::osm
+
+#endif //RELATIONMEMBERINDEX_H
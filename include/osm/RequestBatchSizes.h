@@ -0,0 +1,54 @@
+// Copyright 2025, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef REQUESTBATCHSIZES_H
+#define REQUESTBATCHSIZES_H
+
+#include "config/Config.h"
+#include "util/AdaptiveBatchSize.h"
+
+namespace olu::osm {
+
+    /**
+     * Sizes of the batches for the different kinds of requests to the SPARQL endpoint. The
+     * requests have very different costs per element, so each kind has its own batch size, which
+     * is adapted separately if `Config::adaptiveBatchSize` is set.
+     */
+    struct RequestBatchSizes {
+        explicit RequestBatchSizes(const config::Config &config):
+            nodeLocations(config.batchSize, config.adaptiveBatchSize),
+            wayMembers(config.batchSize, config.adaptiveBatchSize),
+            relationMembers(config.batchSize, config.adaptiveBatchSize),
+            referencingElements(config.batchSize, config.adaptiveBatchSize),
+            deletes(config.batchSize, config.adaptiveBatchSize) { }
+
+        // Queries for the locations of nodes
+        util::AdaptiveBatchSize nodeLocations;
+        // Queries for the members of ways
+        util::AdaptiveBatchSize wayMembers;
+        // Queries for the members of relations
+        util::AdaptiveBatchSize relationMembers;
+        // Queries for the ways and relations that reference nodes, ways or relations
+        util::AdaptiveBatchSize referencingElements;
+        // Delete operations
+        util::AdaptiveBatchSize deletes;
+    };
+
+} // namespace olu::osm
+
+#endif //REQUESTBATCHSIZES_H
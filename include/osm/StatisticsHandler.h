@@ -19,8 +19,13 @@
 #ifndef STATISTICSHANDLER_H
 #define STATISTICSHANDLER_H
 
+#include <algorithm>
+#include <array>
+#include <chrono>
 #include <string>
+#include <vector>
 #include <cstddef>
+#include <mutex>
 
 #include "simdjson.h"
 
@@ -28,7 +33,10 @@
 #include <util/Types.h>
 
 #include "OsmDatabaseState.h"
+#include "osm/OsmObjectType.h"
 #include "sparql/SparqlWrapper.h"
+#include "util/Histogram.h"
+#include "util/StageGraph.h"
 
 namespace olu::osm {
     class StatisticsHandler {
@@ -65,6 +73,18 @@ namespace olu::osm {
             return std::chrono::duration_cast<std::chrono::milliseconds>(_endTimeApplyingBoundaries - _startTimeApplyingBoundaries).count();
         }
 
+        void startTimeBuildingIndexes() { _startTimeBuildingIndexes = std::chrono::system_clock::now(); }
+        void endTimeBuildingIndexes() { _endTimeBuildingIndexes = std::chrono::system_clock::now(); }
+        long getTimeInMSBuildingIndexes() const {
+            return std::chrono::duration_cast<std::chrono::milliseconds>(_endTimeBuildingIndexes - _startTimeBuildingIndexes).count();
+        }
+
+        void startTimeUpdatingIndexes() { _startTimeUpdatingIndexes = std::chrono::system_clock::now(); }
+        void endTimeUpdatingIndexes() { _endTimeUpdatingIndexes = std::chrono::system_clock::now(); }
+        long getTimeInMSUpdatingIndexes() const {
+            return std::chrono::duration_cast<std::chrono::milliseconds>(_endTimeUpdatingIndexes - _startTimeUpdatingIndexes).count();
+        }
+
         void startTimeFetchingChangeFiles() { _startTimeFetchingChangeFiles = std::chrono::system_clock::now(); }
         void endTimeFetchingChangeFiles() { _endTimeFetchingChangeFiles = std::chrono::system_clock::now(); }
         long getTimeInMSFetchingChangeFiles() const {
@@ -130,6 +150,14 @@ namespace olu::osm {
         long getTimeInMSDeletingTriples() const {
             return std::chrono::duration_cast<std::chrono::milliseconds>(_endTimeDeletingTriples - _startTimeDeletingTriples).count();
         }
+        // Time in which the triples were deleted while osm2rdf converted the osm data
+        long getTimeInMSDeletingDuringConversion() const {
+            const auto start = std::max(_startTimeOsm2RdfConversion, _startTimeDeletingTriples);
+            const auto end = std::min(_endTimeOsm2RdfConversion, _endTimeDeletingTriples);
+            return end > start
+                       ? std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+                       : 0;
+        }
 
         void startTimeFilteringTriples() { _startTimeFilteringTriples = std::chrono::system_clock::now(); }
         void endTimeFilteringTriples() { _endTimeFilteringTriples = std::chrono::system_clock::now(); }
@@ -199,14 +227,84 @@ namespace olu::osm {
         void setWayReferenceCount(const size_t &count) { _numOfReferencesToWays = count; }
         void setRelationReferenceCount(const size_t &count) { _numOfReferencesToRelations = count; }
 
-        void countQuery() { ++_queriesCount; }
+        void countNodeLocationIndexLookups(const size_t &hits, const size_t &misses) {
+            _numOfNodeLocationIndexHits += hits;
+            _numOfNodeLocationIndexMisses += misses;
+        }
+        void countFetcherCacheLookups(const OsmObjectType &type, const size_t &hits,
+                                      const size_t &misses) {
+            std::lock_guard lock(_queryMutex);
+            _fetcherCacheHits[static_cast<size_t>(type)] += hits;
+            _fetcherCacheMisses[static_cast<size_t>(type)] += misses;
+        }
+        void countWayNodeIndexLookups(const size_t &nodes) { _numOfWayNodeIndexLookups += nodes; }
+        void countRelationMemberIndexLookups(const size_t &hits, const size_t &misses) {
+            _numOfRelationMemberIndexHits += hits;
+            _numOfRelationMemberIndexMisses += misses;
+        }
+
+        void countQuery() {
+            std::lock_guard lock(_queryMutex);
+            ++_queriesCount;
+        }
         void countDeleteOp() { ++_deleteOpCount; }
         void countInsertOp() { ++_insertOpCount; }
+        void countDeleteAndInsertOp() { ++_deleteAndInsertOpCount; }
         void countTriple() { ++_numOfConvertedTriples; }
 
+        /**
+         * Records the size of the batches for a kind of requests at the end of the update and
+         * the number of batches that had to be split because they were too large.
+         */
+        void setBatchSize(std::string requestKind, const size_t &batchSize,
+                          const size_t &numOfSplits) {
+            _batchSizes.push_back({std::move(requestKind), batchSize, numOfSplits});
+        }
+
+        /**
+         * Records the stages of the processing of the change files that bounded its duration.
+         */
+        void setCriticalPath(std::vector<util::StageTiming> criticalPath) {
+            _criticalPath = std::move(criticalPath);
+        }
+
+        void countInsertBatch(const size_t &numOfTriples, const size_t &numOfBytes) {
+            _insertBatchTriples.add(numOfTriples);
+            _insertBatchBytes.add(numOfBytes);
+        }
+
+        void countQueryCompression(const util::CompressionInfo &info) {
+            std::lock_guard lock(_queryMutex);
+            _queryCompression.add(info);
+        }
+        void countUpdateCompression(const util::CompressionInfo &info,
+                                    const sparql::UpdateOperation &updateOp) {
+            switch (updateOp) {
+                case sparql::UpdateOperation::INSERT:
+                    _insertCompression.add(info);
+                    break;
+                case sparql::UpdateOperation::DELETE:
+                    _deleteCompression.add(info);
+                    break;
+                case sparql::UpdateOperation::DELETE_AND_INSERT:
+                    _deleteAndInsertCompression.add(info);
+                    break;
+            }
+        }
+
         void logQleverQueryInfo(simdjson::ondemand::object qleverResponse);
         void logQLeverUpdateInfo(const simdjson::padded_string &qleverResponse, const sparql::UpdateOperation &updateOp);
 
+        /**
+         * Logs the info of each operation in the response of QLever to an update request.
+         *
+         * @param qleverResponse The JSON array that QLever returns for an update request, which
+         * contains one object per update operation in the request.
+         * @param updateOp The kind of the update operations in the request.
+         */
+        void logQLeverUpdateResponse(const std::string &qleverResponse,
+                                     const sparql::UpdateOperation &updateOp);
+
         [[nodiscard]] size_t getQleverUpdateTimeMs() const { return _qleverInsertTimeMs + _qleverDeleteTimeMs; }
 
     private:
@@ -243,12 +341,34 @@ namespace olu::osm {
         // geometry needs to be updated, that are not already in the change file.
         size_t _numOfReferencesToRelations = 0;
 
+        // Node locations that were found in the local node location index and the ones that had
+        // to be fetched from the SPARQL endpoint instead.
+        size_t _numOfNodeLocationIndexHits = 0;
+        size_t _numOfNodeLocationIndexMisses = 0;
+        // Moved nodes for which the referencing ways were looked up in the local way node index
+        // instead of the SPARQL endpoint.
+        size_t _numOfWayNodeIndexLookups = 0;
+        // Dummy relations that were created from the local relation member index and the ones
+        // that had to be fetched from the SPARQL endpoint instead.
+        size_t _numOfRelationMemberIndexHits = 0;
+        size_t _numOfRelationMemberIndexMisses = 0;
+
+        // Objects that were requested from the caching data fetcher and found in its cache, and
+        // the ones that had to be fetched from the SPARQL endpoint, indexed by OsmObjectType.
+        // Guards the statistics about queries, because the objects are fetched by several
+        // stages of the update at the same time
+        std::mutex _queryMutex;
+
+        std::array<size_t, 3> _fetcherCacheHits{};
+        std::array<size_t, 3> _fetcherCacheMisses{};
+
         size_t _numOfConvertedTriples = 0;
         size_t _numOfTriplesToInsert = 0;
 
         size_t _queriesCount = 0;
         size_t _deleteOpCount = 0;
         size_t _insertOpCount = 0;
+        size_t _deleteAndInsertOpCount = 0;
         size_t _updateOpCount = _deleteOpCount + _insertOpCount;
 
         size_t _qleverResponseTimeMs = 0;
@@ -259,6 +379,31 @@ namespace olu::osm {
         size_t _qleverInsertedTriplesCount = 0;
         size_t _qleverDeletedTriplesCount = 0;
 
+        // Total sizes and durations of the compression of the request bodies for queries,
+        // insert and delete operations.
+        util::CompressionInfo _queryCompression;
+        util::CompressionInfo _insertCompression;
+        util::CompressionInfo _deleteCompression;
+        util::CompressionInfo _deleteAndInsertCompression;
+        static void printCompressionStatistics(std::string_view requestType,
+                                               const util::CompressionInfo &compression);
+
+        // Batch sizes for the kinds of requests at the end of the update, if they were adapted
+        struct BatchSizeInfo {
+            std::string requestKind;
+            size_t batchSize;
+            size_t numOfSplits;
+        };
+        std::vector<BatchSizeInfo> _batchSizes;
+
+        // Number of triples and bytes of the insert operations
+        util::Histogram _insertBatchTriples;
+        util::Histogram _insertBatchBytes;
+        static void printHistogram(std::string_view description, std::string_view unit,
+                                   const util::Histogram &histogram);
+
+        std::vector<util::StageTiming> _criticalPath;
+
         time_point_t _startTime;
         time_point_t _endTime;
 
@@ -271,6 +416,12 @@ namespace olu::osm {
         time_point_t _startTimeApplyingBoundaries;
         time_point_t _endTimeApplyingBoundaries;
 
+        time_point_t _startTimeBuildingIndexes;
+        time_point_t _endTimeBuildingIndexes;
+
+        time_point_t _startTimeUpdatingIndexes;
+        time_point_t _endTimeUpdatingIndexes;
+
         time_point_t _startTimeFetchingChangeFiles;
         time_point_t _endTimeFetchingChangeFiles;
 
@@ -0,0 +1,49 @@
+// Copyright 2025, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef OSM_LIVE_UPDATES_WAY_H
+#define OSM_LIVE_UPDATES_WAY_H
+
+#include <string>
+
+#include "util/Types.h"
+
+namespace olu::osm {
+
+    class Way {
+    public:
+        explicit Way(id_t id, member_ids_t members, bool hasTag);
+
+        /**
+         * Returns the way as an XML osm object, which only contains the node members and a dummy
+         * tag if the way has tags.
+         */
+        [[nodiscard]] std::string getXml() const;
+
+        [[nodiscard]] id_t getId() const { return id; }
+        [[nodiscard]] const member_ids_t& getMembers() const { return members; }
+        [[nodiscard]] bool hasTag() const { return tagged; }
+    protected:
+        id_t id;
+        member_ids_t members;
+        bool tagged;
+    };
+
+}
+
+#endif //OSM_LIVE_UPDATES_WAY_H
@@ -0,0 +1,88 @@
+// Copyright 2025, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef WAYNODEINDEX_H
+#define WAYNODEINDEX_H
+
+#include <filesystem>
+#include <memory>
+#include <set>
+
+#include "osmium/handler.hpp"
+#include "osmium/osm/way.hpp"
+
+#include "util/PersistentMultiMap.h"
+#include "util/Types.h"
+
+namespace olu::osm {
+
+    /**
+     * File backed index of the node members of all ways. Next to the node ids of each way, the
+     * index stores the reverse mapping from node ids to the ids of the ways that reference them,
+     * so that the ways that are affected by a moved node can be found without a SPARQL query.
+     *
+     * The index has to be built once from a complete data set (PBF file) between `beginBuild()`
+     * and `endBuild()`. After that, it can be used as an osmium handler for change files: The old
+     * node members of each way in the change file are replaced by the new ones, and the changes
+     * are written to disk on `commit()`. An index that was never built is not maintained and
+     * contains no entries.
+     */
+    class WayNodeIndex: public osmium::handler::Handler {
+    public:
+        explicit WayNodeIndex(const std::filesystem::path &indexDir);
+
+        // Iterator for osmium::apply
+        void way(const osmium::Way& way);
+
+        /**
+         * Rebuilds the index: The ways that are passed to `way()` between `beginBuild()` and
+         * `endBuild()` replace the previous content of the index.
+         */
+        void beginBuild();
+        void endBuild();
+
+        /**
+         * @return True if the index was built from a complete data set and can be used for
+         * lookups.
+         */
+        [[nodiscard]] bool isBuilt() const { return _waysOfNodes.isBuilt(); }
+
+        /**
+         * @return The ids of all ways that reference at least one of the given nodes.
+         */
+        [[nodiscard]] std::set<id_t> getWaysReferencingNodes(const std::set<id_t> &nodeIds) const;
+
+        /**
+         * Writes the changes of the last change file to the index files.
+         */
+        void commit();
+
+    private:
+        // Maps way ids to the ids of their node members
+        util::PersistentMultiMap<id_t> _nodesOfWays;
+        // Maps node ids to the ids of the ways that reference them
+        util::PersistentMultiMap<id_t> _waysOfNodes;
+
+        // Only present while the index is built
+        std::unique_ptr<util::PersistentMultiMap<id_t>::Builder> _nodesOfWaysBuilder;
+        std::unique_ptr<util::PersistentMultiMap<id_t>::Builder> _waysOfNodesBuilder;
+    };
+
+} // namespace olu::osm
+
+#endif //WAYNODEINDEX_H
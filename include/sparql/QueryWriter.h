@@ -41,6 +41,13 @@ namespace olu::sparql {
          */
         [[nodiscard]] std::string writeInsertQuery(const std::vector<std::string>& triples) const;
 
+        /**
+         * @returns A SPARQL update operation that inserts a list of triples in to the database,
+         * which can be sent together with other update operations
+         */
+        [[nodiscard]] std::string
+        writeInsertDataQuery(const std::vector<std::string>& triples) const;
+
         /**
          * @returns A SPARQL query that deletes all triples for an osm object with subjec
          * `osmTag:id` and all triples
@@ -73,6 +80,13 @@ namespace olu::sparql {
         [[nodiscard]] std::string
         writeDeleteTripleQuery(const std::vector<ttl::Triple>& triples) const;
 
+        /**
+         * @returns A SPARQL update that runs the given update operations in order, so they can be
+         * sent to the endpoint in one request
+         */
+        [[nodiscard]] static std::string
+        writeUpdateSequence(const std::vector<std::string>& updates);
+
         /**
         * @returns A SPARQL query for the locations of the nodes with the given ID in WKT format
         */
@@ -19,16 +19,36 @@
 #ifndef OSM_LIVE_UPDATES_SPARQLWRAPPER_H
 #define OSM_LIVE_UPDATES_SPARQLWRAPPER_H
 
+#include <functional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "config/Config.h"
+#include "util/Compressor.h"
+#include "util/HttpRequest.h"
 
 namespace olu::sparql {
 
     enum class UpdateOperation {
         INSERT,
-        DELETE
+        DELETE,
+        // Delete operations followed by one INSERT DATA operation, sent as one SPARQL update
+        DELETE_AND_INSERT
+    };
+
+    /**
+     * Body of an update that was built, and compressed if configured, before it is sent. This
+     * allows to prepare the next update while the previous one is still being sent.
+     */
+    struct PreparedUpdate {
+        UpdateOperation updateOp = UpdateOperation::INSERT;
+        std::string_view contentType;
+        std::string body;
+        // Only used if the body was compressed
+        std::string compressedBody;
+        util::CompressionType encoding = util::CompressionType::NONE;
+        util::CompressionInfo compression;
     };
 
     /**
@@ -45,13 +65,14 @@ namespace olu::sparql {
      */
     class SparqlWrapper {
     public:
-        explicit SparqlWrapper(config::Config  config): _config(std::move(config)) { }
+        explicit SparqlWrapper(config::Config  config): _config(std::move(config)),
+            _compressor(util::Compressor::typeFromString(_config.requestCompression)) { }
 
         /**
          * Sets the query to send to the SPARQL endpoint. The prefixes must be set
          * with `setPrefixes`.
          */
-        void setQuery(const std::string& query);
+        void setQuery(std::string query);
 
         /**
          * Sets the prefixes for the query to send to the SPARQL endpoint.
@@ -64,32 +85,100 @@ namespace olu::sparql {
         void clearCache() const;
 
         /**
-         * Sends a POST request with the encoded prefixes and query as body to the SPARQL endpoint.
+         * Sends a POST request with the prefixes and query as body to the SPARQL endpoint. The
+         * body is sent with the "application/sparql-query" content type, or URL-encoded as form
+         * data if `useFormEncoding` is set in the config.
          *
          * @return The response from the SPARQL endpoint.
          */
         std::string runQuery();
 
         /**
-         * Sends a POST request with the encoded prefixes and the update query as body to the SPARQL
-         * endpoint.
+         * Like `runQuery()`, but passes each chunk of the response to `onData` as soon as it was
+         * received, so the response can be processed while it is downloaded.
+         */
+        void runQuery(const std::function<void(std::string_view)> &onData);
+
+        /**
+         * Sends a POST request with the prefixes and the update query as body to the SPARQL
+         * endpoint. Delete operations are sent with the "application/sparql-update" content type,
+         * or URL-encoded as form data if `useFormEncoding` is set in the config.
          *
          * @return The response from the SPARQL endpoint.
          */
         std::string runUpdate(const UpdateOperation &updateOp);
+
+        /**
+         * Builds the body for the update with the current prefixes and query, and compresses it
+         * if `requestCompression` is set in the config. The buffers of the given update are
+         * reused.
+         */
+        void prepareUpdate(const UpdateOperation &updateOp, PreparedUpdate &update);
+
+        /**
+         * Sends the prepared update to the SPARQL endpoint. Does not change the state of the
+         * wrapper, so it can be called from another thread than `prepareUpdate()`.
+         *
+         * @return The response from the SPARQL endpoint.
+         */
+        std::string runUpdate(const PreparedUpdate &update) const;
+
+        /**
+         * @return The sizes and duration of the compression of the body of the last query.
+         */
+        [[nodiscard]] const util::CompressionInfo &getLastQueryCompression() const {
+            return _lastQueryCompression;
+        }
     private:
         config::Config _config;
         std::string _query;
         std::string _prefixes;
 
+        // Body of the current query. The buffers are reused for all queries, so they only grow
+        // to the size of the largest query, and curl sends them without copying them.
+        std::string _body;
+        std::string _compressedBody;
+        util::Compressor _compressor;
+        util::CompressionInfo _lastQueryCompression;
+
+        // Buffers of the update that is sent by `runUpdate(updateOp)`
+        PreparedUpdate _update;
+
         void writeQueryToFileOutput(const bool &isInsertOperation) const;
 
         /**
-         * Sends a HTTP request to the sparql endpoint.
+         * Sends a HTTP request to the sparql endpoint and passes the response chunks to `onData`.
+         */
+        void sendQuery(const std::function<void(std::string_view)> &onData);
+
+        /**
+         * Writes the prefixes and query to the given body buffer, as needed for the
+         * "application/sparql-query", "application/sparql-update" and "text/turtle" content types.
+         */
+        void buildBody(std::string &body) const;
+
+        /**
+         * Writes the URL-encoded prefixes and query as value of the given form key to the given
+         * body buffer.
+         */
+        void buildFormBody(std::string &body, std::string_view key) const;
+
+        /**
+         * Compresses the body into the compressed body buffer, if the compression is enabled
+         * and the request is sent to the endpoint.
+         *
+         * @return The encoding of the compressed body, or `NONE` if it was not compressed.
          */
-        std::string sendQuery();
+        util::CompressionType compressBody(const std::string &body, std::string &compressedBody,
+                                           util::CompressionInfo &info);
 
-        std::string sendUpdate(const UpdateOperation &updateOp);
+        /**
+         * Throws a `util::BatchTooLargeException` with the given message if the failed request
+         * might succeed for a smaller batch (timeout, HTTP 413 or 5xx), and a
+         * `SparqlWrapperException` otherwise.
+         */
+        [[noreturn]] static void throwRequestException(const util::HttpRequestException &e,
+                                                       const std::string &msg);
     };
 
     /**
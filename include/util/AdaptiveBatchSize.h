@@ -0,0 +1,87 @@
+// Copyright 2025, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef ADAPTIVEBATCHSIZE_H
+#define ADAPTIVEBATCHSIZE_H
+
+#include <chrono>
+#include <mutex>
+
+namespace olu::util {
+
+    /**
+     * Thread safe controller for the number of elements per batch of one kind of request to the
+     * SPARQL endpoint.
+     *
+     * The size is adapted AIMD-style: it grows by a fixed step as long as the time per element
+     * of a full batch does not get worse, moves one step back if it does, and is halved if a
+     * batch failed because it was too large. A controller that is not adaptive always returns
+     * the initial size.
+     */
+    class AdaptiveBatchSize {
+    public:
+        // The size of an adaptive batch is at most the initial size times this factor
+        static constexpr size_t MAX_SIZE_FACTOR = 8;
+        // The size grows by the size after the last decrease divided by this value
+        static constexpr size_t STEP_DIVISOR = 8;
+        // Increase of the time per element that is still accepted as no change
+        static constexpr double LATENCY_TOLERANCE = 0.1;
+
+        explicit AdaptiveBatchSize(size_t batchSize, bool adaptive = false);
+
+        AdaptiveBatchSize(const AdaptiveBatchSize&) = delete;
+        AdaptiveBatchSize& operator=(const AdaptiveBatchSize&) = delete;
+
+        [[nodiscard]] bool isAdaptive() const { return _adaptive; }
+
+        /**
+         * @return The number of elements for the next batch.
+         */
+        [[nodiscard]] size_t get() const;
+
+        /**
+         * Records that a batch with the given number of elements was processed in the given time.
+         * Batches that are smaller than the current size, like the last batch of a set, do not
+         * change the size.
+         */
+        void onSuccess(size_t numOfElements, std::chrono::nanoseconds duration);
+
+        /**
+         * Records that a batch with the given number of elements failed because it was too large.
+         */
+        void onFailure(size_t numOfElements);
+
+        /**
+         * @return The number of batches that failed because they were too large.
+         */
+        [[nodiscard]] size_t getNumOfFailures() const;
+
+    private:
+        bool _adaptive;
+        size_t _maxSize;
+        size_t _size;
+        size_t _step;
+        // Time per element of the last full batch, zero if there is none
+        double _nsPerElement = 0;
+        size_t _numOfFailures = 0;
+        mutable std::mutex _mutex;
+    };
+
+} // namespace olu::util
+
+#endif //ADAPTIVEBATCHSIZE_H
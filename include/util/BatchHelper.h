@@ -19,56 +19,254 @@
 #ifndef BATCHHELPER_H
 #define BATCHHELPER_H
 
-#include <set>
+#include <atomic>
+#include <chrono>
+#include <exception>
 #include <functional>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <thread>
+#include <type_traits>
+#include <vector>
 
-#include "osm2rdf/util/ProgressBar.h"
-
+#include "util/AdaptiveBatchSize.h"
+#include "util/Exceptions.h"
+#include "util/Logger.h"
 #include "util/Types.h"
 
 namespace olu::util {
 
+    /**
+     * Order in which the results of concurrently processed batches are passed on.
+     */
+    enum class BatchCompletion {
+        // In the order of the batches
+        ORDERED,
+        // As soon as a batch is finished
+        UNORDERED
+    };
+
     class BatchHelper {
     public :
         static void doInBatches(const std::set<id_t>& set,
                          const size_t elementsPerBatch,
                          const std::function<void(std::set<id_t>)> &func) {
-            std::vector vector(set.begin(), set.end());
-            std::vector<std::set<id_t> > vectorBatches;
-            for (auto it = vector.cbegin(), e = vector.cend(); it != vector.cend(); it = e) {
-                e = it + std::min<std::size_t>(vector.end() - it, elementsPerBatch);
-                vectorBatches.emplace_back(it, e);
+            for (const auto &vectorBatch: getBatches(set, elementsPerBatch)) {
+                func(vectorBatch);
             }
+        }
 
-            for (const auto &vectorBatch: vectorBatches) {
-                func(vectorBatch);
+        /**
+         * Calls `func` for the batches of the set one after the other. The size of each batch is
+         * taken from `batchSize`, which is updated with the time needed for the batch. If the
+         * batch size is adaptive and `func` throws a `BatchTooLargeException`, the batch is split
+         * in halves which are processed separately.
+         */
+        static void doInBatches(const std::set<id_t>& set,
+                                AdaptiveBatchSize &batchSize,
+                                const std::function<void(const std::set<id_t>&)> &func) {
+            doInBatchesConcurrently(set, batchSize, 1,
+                [&func](const std::set<id_t> &batch, size_t) {
+                    func(batch);
+                    return true;
+                },
+                [](bool, size_t) { });
+        }
+
+        /**
+         * Processes the batches of the set on up to `maxConcurrentBatches` threads at once, for
+         * example to have several requests to the SPARQL endpoint in flight.
+         *
+         * `func` is called with a batch and the index of the worker that processes it, which is
+         * in [0, maxConcurrentBatches), so that callers can give each worker its own resources.
+         * It has to be safe to call `func` from several threads at once. `onComplete` is called
+         * with the result of `func` and the number of the batch, one call at a time, either in
+         * the order of the batches or as soon as a batch is finished. Shared state should
+         * therefore only be changed in `onComplete`.
+         *
+         * If a batch throws an exception, no further batches are started, and the exception of
+         * the failed batch with the lowest number is rethrown after the running batches are
+         * finished. With at most one concurrent batch, the batches are processed in order on the
+         * calling thread.
+         */
+        template <typename Func, typename OnComplete>
+        static void doInBatchesConcurrently(const std::set<id_t>& set,
+                                            const size_t elementsPerBatch,
+                                            const size_t maxConcurrentBatches,
+                                            Func &&func, OnComplete &&onComplete,
+                                            const BatchCompletion completion =
+                                                BatchCompletion::UNORDERED) {
+            AdaptiveBatchSize batchSize(elementsPerBatch);
+            doInBatchesConcurrently(set, batchSize, maxConcurrentBatches, func, onComplete,
+                                    completion);
+        }
+
+        /**
+         * Like above, but the size of each batch is taken from `batchSize` when the batch is
+         * started, and `batchSize` is updated with the time needed for the batch. If the batch
+         * size is adaptive and `func` throws a `BatchTooLargeException`, the batch is split in
+         * halves which are processed one after the other by the same worker. `onComplete` is then
+         * called for each part, with the number of the original batch.
+         */
+        template <typename Func, typename OnComplete>
+        static void doInBatchesConcurrently(const std::set<id_t>& set,
+                                            AdaptiveBatchSize &batchSize,
+                                            const size_t maxConcurrentBatches,
+                                            Func &&func, OnComplete &&onComplete,
+                                            const BatchCompletion completion =
+                                                BatchCompletion::UNORDERED) {
+            using result_t = std::invoke_result_t<Func&, const std::set<id_t>&, size_t>;
+            static_assert(!std::is_void_v<result_t>, "The batch function must return a result");
+
+            std::mutex mutex;
+            auto nextElement = set.cbegin();
+            size_t numOfBatches = 0;
+
+            // Takes the next batch from the set, returns false if all batches were taken
+            const auto takeBatch = [&](std::set<id_t> &batch, size_t &batchNumber) {
+                std::lock_guard lock(mutex);
+                if (nextElement == set.cend()) {
+                    return false;
+                }
+
+                batch.clear();
+                for (size_t size = batchSize.get(); size > 0 && nextElement != set.cend(); --size) {
+                    batch.insert(batch.end(), *nextElement++);
+                }
+                batchNumber = numOfBatches++;
+                return true;
+            };
+
+            const size_t elementsPerBatch = batchSize.get();
+            const size_t numOfWorkers = std::min(maxConcurrentBatches,
+                                                 (set.size() + elementsPerBatch - 1)
+                                                 / elementsPerBatch);
+            if (numOfWorkers <= 1) {
+                std::set<id_t> batch;
+                size_t batchNumber = 0;
+                while (takeBatch(batch, batchNumber)) {
+                    runBatch(batch, batchSize,
+                        [&func](const std::set<id_t> &part) { return func(part, 0); },
+                        [&onComplete, &batchNumber](result_t &&result) {
+                            onComplete(std::move(result), batchNumber);
+                        });
+                }
+                return;
+            }
+
+            std::atomic<bool> failed = false;
+            std::exception_ptr error;
+            size_t failedBatch = std::numeric_limits<size_t>::max();
+
+            // Results of finished batches that wait for the preceding batches, if the results
+            // are passed on in order
+            std::map<size_t, std::vector<result_t>> pendingResults;
+            size_t nextBatchToComplete = 0;
+
+            const auto work = [&](const size_t worker) {
+                std::set<id_t> batch;
+                size_t batchNumber = 0;
+                while (!failed && takeBatch(batch, batchNumber)) {
+                    try {
+                        std::vector<result_t> results;
+                        runBatch(batch, batchSize,
+                            [&func, worker](const std::set<id_t> &part) {
+                                return func(part, worker);
+                            },
+                            [&results](result_t &&result) {
+                                results.push_back(std::move(result));
+                            });
+
+                        std::lock_guard lock(mutex);
+                        if (completion == BatchCompletion::UNORDERED) {
+                            for (auto &&result: results) {
+                                onComplete(std::move(result), batchNumber);
+                            }
+                            continue;
+                        }
+
+                        pendingResults.emplace(batchNumber, std::move(results));
+                        for (auto it = pendingResults.begin();
+                             it != pendingResults.end() && it->first == nextBatchToComplete;
+                             it = pendingResults.erase(it), ++nextBatchToComplete) {
+                            for (auto &&result: it->second) {
+                                onComplete(std::move(result), it->first);
+                            }
+                        }
+                    } catch (...) {
+                        std::lock_guard lock(mutex);
+                        if (batchNumber < failedBatch) {
+                            error = std::current_exception();
+                            failedBatch = batchNumber;
+                        }
+                        failed = true;
+                    }
+                }
+            };
+
+            // The calling thread is the first worker
+            std::vector<std::thread> workers;
+            workers.reserve(numOfWorkers - 1);
+            for (size_t worker = 1; worker < numOfWorkers; ++worker) {
+                workers.emplace_back(work, worker);
+            }
+            work(0);
+            for (auto &worker: workers) {
+                worker.join();
+            }
+
+            if (error) {
+                std::rethrow_exception(error);
             }
         }
 
-        static void doInBatchesWithProgressBar(const std::set<id_t>& set,
-                         const size_t elementsPerBatch,
-                         const std::function<void(std::set<id_t>, size_t)> &func) {
-            std::vector vector(set.begin(), set.end());
-            std::vector<std::set<id_t> > vectorBatches;
+    private:
+        /**
+         * Calls `func` for the batch and passes the result to `onResult`. If the batch size is
+         * adaptive and the batch was too large, the batch is split in halves which are processed
+         * one after the other.
+         */
+        template <typename Func, typename OnResult>
+        static void runBatch(const std::set<id_t> &batch, AdaptiveBatchSize &batchSize,
+                             const Func &func, const OnResult &onResult) {
+            const auto start = std::chrono::steady_clock::now();
+            std::optional<std::invoke_result_t<const Func&, const std::set<id_t>&>> result;
+            try {
+                result.emplace(func(batch));
+            } catch (const BatchTooLargeException &e) {
+                batchSize.onFailure(batch.size());
+                if (!batchSize.isAdaptive() || batch.size() <= 1) {
+                    throw;
+                }
+                Logger::log(LogEvent::WARNING, "Request for a batch of "
+                                               + std::to_string(batch.size())
+                                               + " elements failed, retrying in two parts: "
+                                               + e.what());
+            }
 
-            osm2rdf::util::ProgressBar progress(set.size(),
-                                                vectorBatches.size() > 1);
-            size_t counter = 0;
-            progress.update(counter);
+            if (!result) {
+                const auto middle = std::next(batch.begin(), batch.size() / 2);
+                runBatch(std::set(batch.begin(), middle), batchSize, func, onResult);
+                runBatch(std::set(middle, batch.end()), batchSize, func, onResult);
+                return;
+            }
+
+            batchSize.onSuccess(batch.size(), std::chrono::steady_clock::now() - start);
+            onResult(std::move(*result));
+        }
 
+        static std::vector<std::set<id_t>> getBatches(const std::set<id_t>& set,
+                                                      const size_t elementsPerBatch) {
+            std::vector vector(set.begin(), set.end());
+            std::vector<std::set<id_t> > vectorBatches;
             for (auto it = vector.cbegin(), e = vector.cend(); it != vector.cend(); it = e) {
                 e = it + std::min<std::size_t>(vector.end() - it, elementsPerBatch);
                 vectorBatches.emplace_back(it, e);
             }
-
-            size_t batchNumber = 0;
-            for (const auto &vectorBatch: vectorBatches) {
-                func(vectorBatch, batchNumber++);
-                counter += elementsPerBatch;
-                progress.update(counter);
-            }
-
-            progress.done();
+            return vectorBatches;
         }
     };
 
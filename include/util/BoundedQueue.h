@@ -0,0 +1,101 @@
+// Copyright 2025, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef BOUNDEDQUEUE_H
+#define BOUNDEDQUEUE_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <optional>
+
+namespace olu::util {
+
+    /**
+     * Thread safe FIFO queue with a fixed capacity, used to hand work from a producer to a
+     * consumer thread. `push()` blocks while the queue is full, which keeps the memory used by a
+     * pipeline bounded, and `pop()` blocks while the queue is empty.
+     */
+    template <typename T>
+    class BoundedQueue {
+    public:
+        explicit BoundedQueue(const size_t capacity): _capacity(capacity > 0 ? capacity : 1) {}
+
+        /**
+         * Appends an element to the queue. Blocks while the queue is full.
+         *
+         * @return False if the queue was closed and the element was discarded, true otherwise.
+         */
+        bool push(T element) {
+            std::unique_lock lock(_mutex);
+            _notFull.wait(lock, [this] { return _queue.size() < _capacity || _closed; });
+            if (_closed) {
+                return false;
+            }
+
+            _queue.push_back(std::move(element));
+            _notEmpty.notify_one();
+            return true;
+        }
+
+        /**
+         * Removes the first element from the queue. Blocks while the queue is empty and not
+         * closed.
+         *
+         * @return The first element, or an empty optional if the queue is closed and drained.
+         */
+        std::optional<T> pop() {
+            std::unique_lock lock(_mutex);
+            _notEmpty.wait(lock, [this] { return !_queue.empty() || _closed; });
+            if (_queue.empty()) {
+                return std::nullopt;
+            }
+
+            T element = std::move(_queue.front());
+            _queue.pop_front();
+            _notFull.notify_one();
+            return element;
+        }
+
+        /**
+         * Closes the queue. Elements that are already in the queue can still be popped, but no
+         * new elements are accepted, and all waiting threads are woken up.
+         */
+        void close() {
+            {
+                std::lock_guard lock(_mutex);
+                _closed = true;
+            }
+            _notEmpty.notify_all();
+            _notFull.notify_all();
+        }
+
+        [[nodiscard]] size_t capacity() const { return _capacity; }
+
+    private:
+        size_t _capacity;
+        bool _closed = false;
+        std::deque<T> _queue;
+        std::mutex _mutex;
+        std::condition_variable _notEmpty;
+        std::condition_variable _notFull;
+    };
+
+} // namespace olu::util
+
+#endif //BOUNDEDQUEUE_H
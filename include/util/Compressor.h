@@ -0,0 +1,120 @@
+// Copyright 2025, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef OSM_LIVE_UPDATES_COMPRESSOR_H
+#define OSM_LIVE_UPDATES_COMPRESSOR_H
+
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <string>
+#include <string_view>
+
+struct z_stream_s;
+struct ZSTD_CCtx_s;
+
+namespace olu::util {
+
+    enum class CompressionType {
+        NONE,
+        GZIP,
+        ZSTD
+    };
+
+    /**
+     * Sizes and duration of one compression.
+     */
+    struct CompressionInfo {
+        size_t inputSize = 0;
+        size_t outputSize = 0;
+        std::chrono::nanoseconds duration{0};
+
+        void add(const CompressionInfo &other) {
+            inputSize += other.inputSize;
+            outputSize += other.outputSize;
+            duration += other.duration;
+        }
+    };
+
+    /**
+     * Compresses the bodies of HTTP requests with gzip or zstd, so that they can be sent with the
+     * corresponding "Content-Encoding" header. The compression context is kept between the
+     * calls of `compress()`, so a compressor should be reused for all bodies that are sent from
+     * one thread.
+     *
+     * zstd is only available if the project was built with zstd (`OLU_WITH_ZSTD`).
+     */
+    class Compressor {
+    public:
+        static constexpr int GZIP_LEVEL = 1;
+        static constexpr int ZSTD_LEVEL = 3;
+
+        explicit Compressor(CompressionType type);
+        ~Compressor();
+
+        Compressor(const Compressor &) = delete;
+        Compressor &operator=(const Compressor &) = delete;
+
+        /**
+         * @return The compression type for the given name ("gzip" or "zstd"). An empty name
+         * means no compression.
+         */
+        static CompressionType typeFromString(std::string_view name);
+
+        [[nodiscard]] static bool isSupported(CompressionType type);
+
+        /**
+         * @return The value for the "Content-Encoding" header of bodies that are compressed with
+         * the given type.
+         */
+        [[nodiscard]] static std::string_view getContentEncoding(CompressionType type);
+
+        [[nodiscard]] CompressionType getType() const { return _type; }
+
+        /**
+         * Replaces the content of `output` with the compressed input. The capacity of `output`
+         * is kept, so the buffer can be reused for the next body.
+         */
+        CompressionInfo compress(std::string_view input, std::string &output);
+
+    private:
+        CompressionType _type;
+        std::unique_ptr<z_stream_s> _gzipStream;
+        ZSTD_CCtx_s* _zstdContext = nullptr;
+
+        void compressGzip(std::string_view input, std::string &output);
+        void compressZstd(std::string_view input, std::string &output);
+    };
+
+    /**
+     * Exception that can appear inside the `Compressor` class.
+     */
+    class CompressorException final : public std::exception {
+        std::string message;
+
+    public:
+        explicit CompressorException(const char* msg) : message(msg) { }
+
+        [[nodiscard]] const char* what() const noexcept override {
+            return message.c_str();
+        }
+    };
+
+} // namespace olu::util
+
+#endif //OSM_LIVE_UPDATES_COMPRESSOR_H
@@ -22,6 +22,21 @@ namespace olu::util {
         }
     };
 
+    /**
+     * Exception that is thrown when a request for a batch failed in a way that a request for a
+     * smaller batch might succeed, for example because of a timeout or because the request body
+     * was too large.
+     */
+    class BatchTooLargeException final : public std::exception {
+        std::string message;
+    public:
+        explicit BatchTooLargeException(const char* msg) : message(msg) { }
+
+        [[nodiscard]] const char* what() const noexcept override {
+            return message.c_str();
+        }
+    };
+
 }
 
 #endif //EXCEPTIONS_H
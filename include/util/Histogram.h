@@ -0,0 +1,91 @@
+// Copyright 2025, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace olu::util {
+
+    /**
+     * Histogram of non-negative values with power of two buckets, which also keeps the number,
+     * minimum, maximum and sum of the values.
+     */
+    class Histogram {
+    public:
+        struct Bucket {
+            // Inclusive
+            size_t lowerBound;
+            // Inclusive, so that the top bucket can contain the largest value of size_t
+            size_t upperBound;
+            size_t count;
+        };
+
+        void add(const size_t value) {
+            ++_buckets[std::bit_width(value)];
+            ++_count;
+            _sum += value;
+            _min = std::min(_min, value);
+            _max = std::max(_max, value);
+        }
+
+        [[nodiscard]] size_t count() const { return _count; }
+        [[nodiscard]] size_t sum() const { return _sum; }
+        [[nodiscard]] size_t min() const { return _count == 0 ? 0 : _min; }
+        [[nodiscard]] size_t max() const { return _max; }
+        [[nodiscard]] double mean() const {
+            return _count == 0 ? 0 : static_cast<double>(_sum) / static_cast<double>(_count);
+        }
+
+        /**
+         * @return The buckets that contain at least one value, in ascending order. Bucket i > 0
+         * contains the values in [2^(i-1), 2^i - 1], bucket 0 only contains zero.
+         */
+        [[nodiscard]] std::vector<Bucket> getBuckets() const {
+            std::vector<Bucket> buckets;
+            for (size_t i = 0; i < _buckets.size(); ++i) {
+                if (_buckets[i] == 0) {
+                    continue;
+                }
+
+                const size_t lowerBound = i == 0 ? 0 : size_t{1} << (i - 1);
+                const size_t upperBound = i < std::numeric_limits<size_t>::digits
+                                              ? (size_t{1} << i) - 1
+                                              : std::numeric_limits<size_t>::max();
+                buckets.push_back({lowerBound, upperBound, _buckets[i]});
+            }
+            return buckets;
+        }
+
+    private:
+        std::array<size_t, std::numeric_limits<size_t>::digits + 1> _buckets{};
+        size_t _count = 0;
+        size_t _sum = 0;
+        size_t _min = std::numeric_limits<size_t>::max();
+        size_t _max = 0;
+    };
+
+} // namespace olu::util
+
+#endif //HISTOGRAM_H
@@ -0,0 +1,111 @@
+// Copyright 2025, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef OSM_LIVE_UPDATES_HTTPCLIENT_H
+#define OSM_LIVE_UPDATES_HTTPCLIENT_H
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <curl/curl.h>
+
+namespace olu::util {
+
+    /**
+     * Process-wide HTTP client that is shared by all `HttpRequest`s.
+     *
+     * Instead of creating a new curl handle for each request, the easy handles are kept in a
+     * pool and reused. Each handle keeps its own connection cache, so consecutive requests
+     * against the same host, e.g. the batches of SPARQL queries and updates, reuse an open
+     * keep-alive connection instead of opening a new one. Only the DNS cache and the TLS
+     * sessions are shared between the handles (`CURLSH`), because libcurl does not support
+     * sharing connections between threads. The client is thread safe, requests can be performed
+     * from several threads at once, each with its own handle.
+     */
+    class HttpClient {
+    public:
+        /**
+         * Enables HTTP/2 for all requests (over TLS, with a fallback to HTTP/1.1 if the server
+         * does not support it).
+         */
+        static void setUseHttp2(bool useHttp2);
+
+        /**
+         * @return A configured easy handle from the pool, or a new one if the pool is empty.
+         */
+        static CURL* acquireHandle();
+
+        /**
+         * Resets the options of the handle and returns it to the pool. The connections that
+         * were opened with the handle stay open for the next request that uses it.
+         */
+        static void releaseHandle(CURL* handle);
+
+        /**
+         * Counts a performed request, and the connections that had to be opened for it.
+         */
+        static void countRequest(CURL* handle);
+
+        // Aggregated over all handles, the numbers are not tracked per connection
+        [[nodiscard]] static size_t getNumOfRequests();
+        [[nodiscard]] static size_t getNumOfConnections();
+        [[nodiscard]] static size_t getNumOfRequestsWithoutNewConnection();
+
+        HttpClient(const HttpClient &) = delete;
+        HttpClient &operator=(const HttpClient &) = delete;
+
+    private:
+        HttpClient();
+        ~HttpClient();
+
+        static HttpClient &instance();
+
+        void configureHandle(CURL* handle) const;
+
+        static void lockShare(CURL* handle, curl_lock_data data, curl_lock_access access,
+                              void* userptr);
+        static void unlockShare(CURL* handle, curl_lock_data data, void* userptr);
+
+        CURLSH* _share;
+        std::array<std::mutex, CURL_LOCK_DATA_LAST> _shareLocks;
+
+        std::mutex _poolMutex;
+        std::vector<CURL*> _freeHandles;
+
+        std::atomic<bool> _useHttp2 = false;
+        std::atomic<size_t> _numOfRequests = 0;
+        std::atomic<size_t> _numOfConnections = 0;
+    };
+
+    class HttpClientException final : public std::exception {
+        std::string message;
+
+    public:
+        explicit HttpClientException(const char* msg) : message(msg) { }
+
+        [[nodiscard]] const char* what() const noexcept override {
+            return message.c_str();
+        }
+    };
+
+} // namespace olu::util
+
+#endif //OSM_LIVE_UPDATES_HTTPCLIENT_H
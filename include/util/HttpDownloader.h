@@ -0,0 +1,82 @@
+// Copyright 2025, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef OSM_LIVE_UPDATES_HTTPDOWNLOADER_H
+#define OSM_LIVE_UPDATES_HTTPDOWNLOADER_H
+
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace olu::util {
+
+    /**
+     * Downloads files with the curl multi interface.
+     *
+     * Up to `maxConcurrentDownloads` transfers are in flight at once, all driven by the calling
+     * thread, so the number of parallel downloads does not depend on the number of threads. The
+     * response bodies are written to disk while they arrive, or kept in memory. The easy handles
+     * are taken from the shared `HttpClient` and therefore reuse its open connections.
+     */
+    class HttpDownloader {
+    public:
+        struct Download {
+            std::string url;
+            // The file the response body is written to. If empty, the body is kept in memory
+            // and passed to the completion callback.
+            std::filesystem::path path;
+        };
+
+        // Called with the index of a finished download and its body, which is empty if the
+        // body was written to a file.
+        using completion_callback_t = std::function<void(size_t, std::string &)>;
+
+        explicit HttpDownloader(size_t maxConcurrentDownloads);
+
+        /**
+         * Downloads all files and calls `onComplete` for each finished download. The calls are
+         * made in the order of the downloads, even if a later download finishes first. Bodies
+         * that are kept in memory are only stored until they are passed to `onComplete`. A
+         * finished download that waits for an earlier one still counts against
+         * `maxConcurrentDownloads`, so no more than that many bodies are kept at once.
+         *
+         * @throws HttpDownloaderException if one of the downloads fails. The transfers that are
+         * still in flight are aborted.
+         */
+        void run(const std::vector<Download> &downloads,
+                 const completion_callback_t &onComplete) const;
+
+    private:
+        size_t _maxConcurrentDownloads;
+    };
+
+    class HttpDownloaderException final : public std::exception {
+        std::string message;
+
+    public:
+        explicit HttpDownloaderException(const char* msg) : message(msg) { }
+
+        [[nodiscard]] const char* what() const noexcept override {
+            return message.c_str();
+        }
+    };
+
+} // namespace olu::util
+
+#endif //OSM_LIVE_UPDATES_HTTPDOWNLOADER_H
@@ -19,7 +19,10 @@
 #ifndef OSM_LIVE_UPDATES_HTTPREQUEST_H
 #define OSM_LIVE_UPDATES_HTTPREQUEST_H
 
+#include <exception>
+#include <functional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <curl/curl.h>
@@ -28,6 +31,10 @@
 
 namespace olu::util {
 
+    /**
+     * A single HTTP request. The curl handle is taken from the pool of the shared `HttpClient`
+     * and returned to it when the request is destroyed, so open connections are reused.
+     */
     class HttpRequest {
     public:
         explicit HttpRequest(
@@ -36,7 +43,27 @@ namespace olu::util {
         ~HttpRequest();
         void addHeader(const std::string& key, const std::string& value);
         void addBody(std::string body);
+
+        /**
+         * Sends the given data as body without copying it. The data has to stay valid until
+         * `perform()` returns.
+         */
+        void addBodyReference(std::string_view body);
+
+        /**
+         * Accepts responses that are compressed with any encoding supported by curl. The
+         * response is decompressed before it is returned or passed on.
+         */
+        void acceptCompressedResponses();
+
         std::string perform();
+
+        /**
+         * Performs the request and passes each chunk of the response to `onData` as soon as it
+         * was received, instead of collecting the response. An exception thrown by `onData`
+         * aborts the request and is rethrown.
+         */
+        void perform(const std::function<void(std::string_view)> &onData);
     private:
         CURL *_curl;
         HttpMethod _method;
@@ -44,19 +71,38 @@ namespace olu::util {
         std::string _url;
         std::string _data;
         std::string _body;
+        std::string_view _bodyReference = "";
 
         curl_slist *_chunk = nullptr;
+
+        // Receiver of the response chunks if the response is streamed, and the exception that
+        // was thrown by it
+        const std::function<void(std::string_view)>* _onData = nullptr;
+        std::exception_ptr _onDataError;
+
+        static size_t streamCallback(void* contents, size_t size, size_t nmemb, void* userp);
+
+        void performRequest();
     };
 
     class HttpRequestException final : public std::exception {
         std::string message;
+        long httpCode = 0;
+        bool timedOut = false;
 
     public:
         explicit HttpRequestException(const char* msg) : message(msg) { }
+        HttpRequestException(const char* msg, const long httpCode, const bool timedOut) :
+            message(msg), httpCode(httpCode), timedOut(timedOut) { }
 
         [[nodiscard]] const char* what() const noexcept override {
             return message.c_str();
         }
+
+        // The HTTP status code of the response, 0 if there was none
+        [[nodiscard]] long getHttpCode() const { return httpCode; }
+
+        [[nodiscard]] bool isTimeout() const { return timedOut; }
     };
 
 } // namespace olu::util
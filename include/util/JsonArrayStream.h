@@ -0,0 +1,98 @@
+// Copyright 2025, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef OSM_LIVE_UPDATES_JSONARRAYSTREAM_H
+#define OSM_LIVE_UPDATES_JSONARRAYSTREAM_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace olu::util {
+
+    /**
+     * Splits the elements of one array out of a JSON document that arrives in chunks, so that
+     * the elements can be parsed while the rest of the document is still being received.
+     *
+     * The array is the value of the first member with the name `key`. Each element of the array
+     * is passed to the callback as soon as it is complete. The element is stored in a buffer
+     * that is reused for all elements and has a capacity of at least `padding` bytes more than
+     * its size, so it can be parsed with simdjson without being copied. Everything except the
+     * elements of the array is kept as the rest of the document, for example
+     * `{"res":[],"time":{...}}`, which can be parsed when the document is complete.
+     *
+     * The document is expected to be valid JSON, it is only scanned for strings and brackets.
+     */
+    class JsonArrayStream {
+    public:
+        using element_callback_t = std::function<void(const std::string &element)>;
+
+        JsonArrayStream(std::string key, element_callback_t onElement, size_t padding = 64);
+
+        /**
+         * Scans the next chunk of the document and calls the callback for each element of the
+         * array that is completed by the chunk.
+         */
+        void feed(std::string_view chunk);
+
+        /**
+         * @return True if the end of the array was reached.
+         */
+        [[nodiscard]] bool isArrayComplete() const { return _mode == Mode::AFTER_ARRAY; }
+
+        [[nodiscard]] size_t getNumOfElements() const { return _numOfElements; }
+
+        /**
+         * @return The document without the elements of the array.
+         */
+        [[nodiscard]] const std::string &getRest() const { return _rest; }
+
+    private:
+        enum class Mode : uint8_t { BEFORE_ARRAY, IN_ARRAY, IN_ELEMENT, AFTER_ARRAY };
+        // State of the recognition of `"key" : [` before the array
+        enum class KeyState : uint8_t { NONE, KEY, COLON };
+
+        std::string _key;
+        element_callback_t _onElement;
+        size_t _padding;
+
+        Mode _mode = Mode::BEFORE_ARRAY;
+        KeyState _keyState = KeyState::NONE;
+        bool _isInString = false;
+        bool _isEscaped = false;
+        size_t _depth = 0;
+        size_t _arrayDepth = 0;
+
+        // The string that is currently read before the array, only up to one character more
+        // than the key
+        std::string _currentString;
+        std::string _element;
+        std::string _rest;
+        size_t _numOfElements = 0;
+
+        void scanString(char c, std::string &output);
+        void scanBeforeArray(char c);
+        void scanInArray(char c);
+        void scanInElement(char c);
+        void emitElement();
+    };
+
+} // namespace olu::util
+
+#endif //OSM_LIVE_UPDATES_JSONARRAYSTREAM_H
@@ -0,0 +1,173 @@
+// Copyright 2025, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef MMAPARRAY_H
+#define MMAPARRAY_H
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <type_traits>
+
+namespace olu::util {
+
+    /**
+     * Exception that can appear inside the `MmapArray` class.
+     */
+    class MmapArrayException final : public std::exception {
+        std::string message;
+    public:
+        explicit MmapArrayException(const char* msg) : message(msg) { }
+
+        [[nodiscard]] const char* what() const noexcept override {
+            return message.c_str();
+        }
+    };
+
+    /**
+     * Array of trivially copyable elements that is stored in a file and mapped into memory. The
+     * file is created if it does not exist. Growing the array extends the file, which is sparse on
+     * most file systems, so parts of the array that were never written are read as zero bytes and
+     * take up no space on disk.
+     */
+    template <typename T>
+    class MmapArray {
+        static_assert(std::is_trivially_copyable_v<T>,
+                      "MmapArray can only store trivially copyable types");
+    public:
+        MmapArray() = default;
+        explicit MmapArray(const std::filesystem::path &path) { open(path); }
+        ~MmapArray() { close(); }
+
+        MmapArray(const MmapArray&) = delete;
+        MmapArray& operator=(const MmapArray&) = delete;
+
+        /**
+         * Opens (or creates) the file at the given path and maps its content into memory.
+         */
+        void open(const std::filesystem::path &path) {
+            close();
+            _path = path;
+            _fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+            if (_fd < 0) {
+                throwError("Cannot open file");
+            }
+
+            struct stat fileStat{};
+            if (fstat(_fd, &fileStat) != 0) {
+                throwError("Cannot read size of file");
+            }
+
+            map(static_cast<size_t>(fileStat.st_size) / sizeof(T));
+        }
+
+        /**
+         * Changes the number of elements in the array. New elements are zero-initialized.
+         */
+        void resize(const size_t size) {
+            unmap();
+            if (ftruncate(_fd, static_cast<off_t>(size * sizeof(T))) != 0) {
+                throwError("Cannot resize file");
+            }
+            map(size);
+        }
+
+        /**
+         * Ensures that the array has at least `size` elements. The array grows by at least half of
+         * its current size, to avoid remapping the file for each new element.
+         */
+        void grow(const size_t size) {
+            if (size <= _size) {
+                return;
+            }
+            resize(std::max(size, _size + _size / 2));
+        }
+
+        /**
+         * Writes the changes to the mapped memory back to the file.
+         */
+        void sync() const {
+            if (_data != nullptr && msync(_data, _size * sizeof(T), MS_SYNC) != 0) {
+                throwError("Cannot sync file");
+            }
+        }
+
+        void close() {
+            unmap();
+            if (_fd >= 0) {
+                ::close(_fd);
+                _fd = -1;
+            }
+        }
+
+        [[nodiscard]] size_t size() const { return _size; }
+        [[nodiscard]] bool empty() const { return _size == 0; }
+        [[nodiscard]] bool isOpen() const { return _fd >= 0; }
+
+        [[nodiscard]] T* data() { return _data; }
+        [[nodiscard]] const T* data() const { return _data; }
+        T& operator[](const size_t index) { return _data[index]; }
+        const T& operator[](const size_t index) const { return _data[index]; }
+
+    private:
+        std::filesystem::path _path;
+        int _fd = -1;
+        T* _data = nullptr;
+        size_t _size = 0;
+
+        void map(const size_t size) {
+            _size = size;
+            if (size == 0) {
+                _data = nullptr;
+                return;
+            }
+
+            void* address = mmap(nullptr, size * sizeof(T), PROT_READ | PROT_WRITE, MAP_SHARED,
+                                 _fd, 0);
+            if (address == MAP_FAILED) {
+                _size = 0;
+                throwError("Cannot map file");
+            }
+            _data = static_cast<T*>(address);
+        }
+
+        void unmap() {
+            if (_data != nullptr) {
+                munmap(_data, _size * sizeof(T));
+                _data = nullptr;
+            }
+            _size = 0;
+        }
+
+        [[noreturn]] void throwError(const std::string &description) const {
+            const std::string msg = description + " " + _path.string() + ": "
+                                    + std::strerror(errno);
+            throw MmapArrayException(msg.c_str());
+        }
+    };
+
+} // namespace olu::util
+
+#endif //MMAPARRAY_H
@@ -0,0 +1,78 @@
+// Copyright 2025, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef PARALLELSORT_H
+#define PARALLELSORT_H
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+namespace olu::util {
+
+    // Ranges with fewer elements per thread are sorted on a single thread.
+    inline constexpr size_t MIN_ELEMENTS_PER_SORT_THREAD = 1 << 14;
+
+    /**
+     * Sorts the range with OpenMP. The range is split into one chunk per thread. The chunks are
+     * sorted in parallel and then merged pairwise, with the merges of each level also running in
+     * parallel. Falls back to `std::sort` for small ranges or without OpenMP.
+     */
+    template <std::random_access_iterator TIterator, typename TCompare>
+    void parallelSort(TIterator first, TIterator last, TCompare compare) {
+        const auto size = static_cast<size_t>(std::distance(first, last));
+        size_t numOfChunks = 1;
+#if defined(_OPENMP)
+        numOfChunks = static_cast<size_t>(omp_get_max_threads());
+#endif
+        numOfChunks = std::min(numOfChunks,
+                               std::max<size_t>(size / MIN_ELEMENTS_PER_SORT_THREAD, 1));
+        if (numOfChunks <= 1) {
+            std::sort(first, last, compare);
+            return;
+        }
+
+        std::vector<size_t> bounds(numOfChunks + 1);
+        for (size_t i = 0; i <= numOfChunks; ++i) {
+            bounds[i] = size * i / numOfChunks;
+        }
+
+#pragma omp parallel for
+        for (size_t chunk = 0; chunk < numOfChunks; ++chunk) {
+            std::sort(first + bounds[chunk], first + bounds[chunk + 1], compare);
+        }
+
+        for (size_t width = 1; width < numOfChunks; width *= 2) {
+#pragma omp parallel for
+            for (size_t chunk = 0; chunk < numOfChunks; chunk += 2 * width) {
+                if (chunk + width < numOfChunks) {
+                    std::inplace_merge(first + bounds[chunk], first + bounds[chunk + width],
+                                       first + bounds[std::min(chunk + 2 * width, numOfChunks)],
+                                       compare);
+                }
+            }
+        }
+    }
+
+} // namespace olu::util
+
+#endif //PARALLELSORT_H
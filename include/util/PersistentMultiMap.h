@@ -0,0 +1,362 @@
+// Copyright 2025, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef PERSISTENTMULTIMAP_H
+#define PERSISTENTMULTIMAP_H
+
+#include <algorithm>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <queue>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "util/MmapArray.h"
+#include "util/Types.h"
+
+namespace olu::util {
+
+    /**
+     * Persistent multimap from ids to values, which is stored in memory mapped files.
+     *
+     * All (key, value) entries are kept in a base file that is sorted by key and value, so the
+     * values for a key are found with a binary search and form one contiguous range (like the
+     * rows of a CSR matrix). Changes are staged in memory and written to a small, also sorted,
+     * delta file on `commit()`, so that the base file does not have to be rewritten for each
+     * change file. The delta is merged into the base file once it grows too large.
+     *
+     * The multimap only exists on disk after it was built from a complete data set with a
+     * `Builder`. Until then, `isBuilt()` returns false and all lookups return no values.
+     *
+     * @tparam V Trivially copyable value type with a defaulted `operator<=>`
+     */
+    template <typename V>
+    class PersistentMultiMap {
+    public:
+        // Number of entries that are sorted in memory at once while building the multimap.
+        static constexpr size_t DEFAULT_ENTRIES_PER_RUN = 1 << 24;
+        // The delta file is merged into the base file when it has more than
+        // max(MIN_ENTRIES_FOR_COMPACTION, base size / COMPACTION_RATIO) entries.
+        static constexpr size_t MIN_ENTRIES_FOR_COMPACTION = 1 << 20;
+        static constexpr size_t COMPACTION_RATIO = 16;
+
+        struct Entry {
+            id_t key;
+            V value;
+
+            auto operator<=>(const Entry &other) const = default;
+        };
+
+        struct DeltaEntry {
+            Entry entry;
+            // True if the entry was removed from the base, false if it was added.
+            bool erased;
+        };
+
+        /**
+         * Writes a multimap from entries in arbitrary order. The entries are sorted in runs of
+         * `entriesPerRun` elements, which are written to temporary files and merged into the
+         * base file on `finish()`, so the memory usage does not depend on the number of entries.
+         */
+        class Builder {
+        public:
+            explicit Builder(PersistentMultiMap &map,
+                             const size_t entriesPerRun = DEFAULT_ENTRIES_PER_RUN):
+                _map(&map), _entriesPerRun(entriesPerRun) {
+                _run.reserve(std::min<size_t>(entriesPerRun, 1 << 16));
+            }
+
+            void add(const id_t &key, const V &value) {
+                _run.push_back({key, value});
+                if (_run.size() >= _entriesPerRun) {
+                    writeRun();
+                }
+            }
+
+            /**
+             * Merges all runs into the base file of the multimap and removes the delta file.
+             */
+            void finish() {
+                writeRun();
+
+                std::vector<std::unique_ptr<MmapArray<Entry>>> runs;
+                size_t numOfEntries = 0;
+                for (const auto &runPath: _runPaths) {
+                    runs.push_back(std::make_unique<MmapArray<Entry>>(runPath));
+                    numOfEntries += runs.back()->size();
+                }
+
+                _map->reset();
+                MmapArray<Entry> base(_map->_basePath);
+                base.resize(numOfEntries);
+
+                // K-way merge of the sorted runs, duplicate entries are only written once
+                using position_t = std::pair<size_t, size_t>;
+                auto greater = [&runs](const position_t &a, const position_t &b) {
+                    return (*runs[b.first])[b.second] < (*runs[a.first])[a.second];
+                };
+                std::priority_queue<position_t, std::vector<position_t>, decltype(greater)>
+                    queue(greater);
+                for (size_t i = 0; i < runs.size(); ++i) {
+                    if (!runs[i]->empty()) {
+                        queue.emplace(i, 0);
+                    }
+                }
+
+                size_t written = 0;
+                while (!queue.empty()) {
+                    auto [run, position] = queue.top();
+                    queue.pop();
+
+                    const Entry &entry = (*runs[run])[position];
+                    if (written == 0 || !(base[written - 1] == entry)) {
+                        base[written++] = entry;
+                    }
+
+                    if (position + 1 < runs[run]->size()) {
+                        queue.emplace(run, position + 1);
+                    }
+                }
+
+                base.resize(written);
+                base.sync();
+                base.close();
+
+                runs.clear();
+                for (const auto &runPath: _runPaths) {
+                    std::filesystem::remove(runPath);
+                }
+                _runPaths.clear();
+
+                _map->open();
+            }
+
+        private:
+            PersistentMultiMap* _map;
+            size_t _entriesPerRun;
+            std::vector<Entry> _run;
+            std::vector<std::filesystem::path> _runPaths;
+
+            void writeRun() {
+                if (_run.empty()) {
+                    return;
+                }
+
+                std::ranges::sort(_run);
+                const auto [first, last] = std::ranges::unique(_run);
+                _run.erase(first, last);
+
+                const auto runPath = _map->_basePath.string() + ".run"
+                                     + std::to_string(_runPaths.size());
+                MmapArray<Entry> run(runPath);
+                run.resize(_run.size());
+                std::ranges::copy(_run, run.data());
+                run.sync();
+
+                _runPaths.emplace_back(runPath);
+                _run.clear();
+            }
+        };
+
+        /**
+         * @param path The path of the base file. The delta file is stored next to it at
+         * "<path>.delta".
+         */
+        explicit PersistentMultiMap(const std::filesystem::path &path):
+            _basePath(path), _deltaPath(path.string() + ".delta") {
+            if (std::filesystem::exists(_basePath)) {
+                open();
+            }
+        }
+
+        [[nodiscard]] bool isBuilt() const { return _base.isOpen(); }
+
+        /**
+         * @return All values for the given key, including the staged changes.
+         */
+        [[nodiscard]] std::vector<V> get(const id_t &key) const {
+            std::vector<V> values;
+            if (!isBuilt()) {
+                return values;
+            }
+
+            for (const auto &entry: std::ranges::equal_range(
+                     std::span(_base.data(), _base.size()), key, {}, &Entry::key)) {
+                values.push_back(entry.value);
+            }
+
+            const auto applyChange = [&values](const V &value, const bool erased) {
+                const auto it = std::ranges::find(values, value);
+                if (erased && it != values.end()) {
+                    values.erase(it);
+                } else if (!erased && it == values.end()) {
+                    values.push_back(value);
+                }
+            };
+
+            for (const auto &[entry, erased]: std::ranges::equal_range(
+                     std::span(_delta.data(), _delta.size()), key, {},
+                     [](const DeltaEntry &delta) { return delta.entry.key; })) {
+                applyChange(entry.value, erased);
+            }
+
+            if (const auto staged = _staged.find(key); staged != _staged.end()) {
+                for (const auto &[value, erased]: staged->second) {
+                    applyChange(value, erased);
+                }
+            }
+
+            return values;
+        }
+
+        void insert(const id_t &key, const V &value) { _staged[key][value] = false; }
+        void erase(const id_t &key, const V &value) { _staged[key][value] = true; }
+
+        /**
+         * Writes the staged changes to the delta file, and merges the delta file into the base
+         * file if it became too large.
+         */
+        void commit() {
+            if (!isBuilt() || _staged.empty()) {
+                _staged.clear();
+                return;
+            }
+
+            const std::span base(_base.data(), _base.size());
+            const auto isChange = [&base](const DeltaEntry &delta) {
+                return std::ranges::binary_search(base, delta.entry) == delta.erased;
+            };
+
+            // Merge the staged changes with the existing delta, the staged change wins if both
+            // contain the same entry. Changes that do not change the base are dropped.
+            std::vector<DeltaEntry> merged;
+            merged.reserve(_delta.size());
+            size_t deltaPosition = 0;
+            for (const auto &[key, values]: _staged) {
+                for (const auto &[value, erased]: values) {
+                    const DeltaEntry staged{{key, value}, erased};
+                    while (deltaPosition < _delta.size() &&
+                           _delta[deltaPosition].entry < staged.entry) {
+                        if (isChange(_delta[deltaPosition])) {
+                            merged.push_back(_delta[deltaPosition]);
+                        }
+                        ++deltaPosition;
+                    }
+
+                    if (deltaPosition < _delta.size() &&
+                        _delta[deltaPosition].entry == staged.entry) {
+                        ++deltaPosition;
+                    }
+
+                    if (isChange(staged)) {
+                        merged.push_back(staged);
+                    }
+                }
+            }
+            for (; deltaPosition < _delta.size(); ++deltaPosition) {
+                if (isChange(_delta[deltaPosition])) {
+                    merged.push_back(_delta[deltaPosition]);
+                }
+            }
+            _staged.clear();
+
+            _delta.resize(merged.size());
+            std::ranges::copy(merged, _delta.data());
+            _delta.sync();
+
+            if (_delta.size() > std::max(MIN_ENTRIES_FOR_COMPACTION,
+                                         _base.size() / COMPACTION_RATIO)) {
+                compact();
+            }
+        }
+
+    private:
+        std::filesystem::path _basePath;
+        std::filesystem::path _deltaPath;
+        MmapArray<Entry> _base;
+        MmapArray<DeltaEntry> _delta;
+        std::map<id_t, std::map<V, bool>> _staged;
+
+        void open() {
+            _base.open(_basePath);
+            _delta.open(_deltaPath);
+        }
+
+        /**
+         * Removes the files of the multimap.
+         */
+        void reset() {
+            _base.close();
+            _delta.close();
+            _staged.clear();
+            std::filesystem::remove(_basePath);
+            std::filesystem::remove(_deltaPath);
+        }
+
+        /**
+         * Merges the delta file into the base file. The new base file is written to a temporary
+         * file first, which then replaces the old one.
+         */
+        void compact() {
+            const auto compactedPath = _basePath.string() + ".tmp";
+            {
+                MmapArray<Entry> compacted(compactedPath);
+                compacted.resize(_base.size() + _delta.size());
+
+                size_t written = 0;
+                size_t deltaPosition = 0;
+                for (size_t basePosition = 0; basePosition < _base.size(); ++basePosition) {
+                    const Entry &entry = _base[basePosition];
+                    for (; deltaPosition < _delta.size() &&
+                           _delta[deltaPosition].entry < entry; ++deltaPosition) {
+                        if (!_delta[deltaPosition].erased) {
+                            compacted[written++] = _delta[deltaPosition].entry;
+                        }
+                    }
+
+                    if (deltaPosition < _delta.size() && _delta[deltaPosition].entry == entry) {
+                        // The delta only contains changes of the base, so an entry that is in
+                        // both was erased
+                        ++deltaPosition;
+                        continue;
+                    }
+
+                    compacted[written++] = entry;
+                }
+                for (; deltaPosition < _delta.size(); ++deltaPosition) {
+                    if (!_delta[deltaPosition].erased) {
+                        compacted[written++] = _delta[deltaPosition].entry;
+                    }
+                }
+
+                compacted.resize(written);
+                compacted.sync();
+            }
+
+            _base.close();
+            std::filesystem::rename(compactedPath, _basePath);
+            _base.open(_basePath);
+            _delta.resize(0);
+        }
+    };
+
+} // namespace olu::util
+
+#endif //PERSISTENTMULTIMAP_H
@@ -0,0 +1,109 @@
+// Copyright 2025, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef OSM_LIVE_UPDATES_POLYGONINDEX_H
+#define OSM_LIVE_UPDATES_POLYGONINDEX_H
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace olu::util {
+
+    /**
+     * Prepared polygon for fast point-in-polygon tests.
+     *
+     * The bounding box of the polygon is divided into a grid. Cells that are not touched by any
+     * edge are completely inside or outside the polygon, which is decided once when the index is
+     * built, so most points are classified by a single lookup. For points in the remaining cells,
+     * the even-odd rule is evaluated only with the edges that overlap the row of the cell. The
+     * edges of a row are stored as separate coordinate arrays, so the crossing tests can be
+     * vectorized by the compiler.
+     *
+     * A polygon consists of one or more rings. Inner rings (holes) are handled by the even-odd
+     * rule, so it does not matter if a ring is an outer or an inner ring.
+     */
+    class PolygonIndex {
+    public:
+        // A point given as (longitude, latitude)
+        using point_t = std::pair<double, double>;
+        using ring_t = std::vector<point_t>;
+
+        /**
+         * @param rings The rings of the polygon. A ring does not have to be closed explicitly.
+         * @param cellsPerAxis The number of grid cells per axis, or 0 to choose it from the
+         * number of edges.
+         */
+        explicit PolygonIndex(const std::vector<ring_t> &rings, size_t cellsPerAxis = 0);
+
+        /**
+         * Reads a polygon in the osmosis polygon filter file format
+         * (https://wiki.openstreetmap.org/wiki/Osmosis/Polygon_Filter_File_Format).
+         */
+        static PolygonIndex fromPolyFile(const std::filesystem::path &path);
+
+        [[nodiscard]] bool contains(double lon, double lat) const;
+
+    private:
+        enum class CellState : uint8_t { OUTSIDE, INSIDE, BOUNDARY };
+
+        // The non-horizontal edges that overlap a row of the grid
+        struct Row {
+            std::vector<double> x1;
+            std::vector<double> y1;
+            std::vector<double> y2;
+            // Change of x per change of y along the edge
+            std::vector<double> slope;
+        };
+
+        double _minLon = 0;
+        double _minLat = 0;
+        double _maxLon = 0;
+        double _maxLat = 0;
+        double _cellWidth = 1;
+        double _cellHeight = 1;
+        size_t _cellsPerAxis = 1;
+
+        std::vector<CellState> _cells;
+        std::vector<Row> _rows;
+
+        [[nodiscard]] size_t getColumn(double lon) const;
+        [[nodiscard]] size_t getRow(double lat) const;
+
+        /**
+         * Even-odd test with the edges of the given row.
+         */
+        [[nodiscard]] bool containsInRow(size_t row, double lon, double lat) const;
+    };
+
+    class PolygonIndexException final : public std::exception {
+        std::string message;
+
+    public:
+        explicit PolygonIndexException(const char* msg) : message(msg) { }
+
+        [[nodiscard]] const char* what() const noexcept override {
+            return message.c_str();
+        }
+    };
+
+} // namespace olu::util
+
+#endif //OSM_LIVE_UPDATES_POLYGONINDEX_H
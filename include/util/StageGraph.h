@@ -0,0 +1,105 @@
+// Copyright 2025, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+#ifndef STAGEGRAPH_H
+#define STAGEGRAPH_H
+
+#include <chrono>
+#include <functional>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "util/WorkStealingPool.h"
+
+namespace olu::util {
+
+    struct StageTiming {
+        std::string name;
+        std::chrono::system_clock::time_point start;
+        std::chrono::system_clock::time_point end;
+
+        [[nodiscard]] long getTimeInMS() const {
+            return std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+        }
+    };
+
+    /**
+     * Dependency graph of named stages. Each stage declares the data it reads (inputs) and the
+     * data it produces (outputs), and a stage is started on the pool as soon as all stages that
+     * produce one of its inputs are finished. Data that exists before the graph runs has to be
+     * declared with `addInput()`.
+     */
+    class StageGraph {
+    public:
+        void addInput(const std::string &name);
+
+        void addStage(std::string name, std::vector<std::string> inputs,
+                      std::vector<std::string> outputs, std::function<void()> run);
+
+        /**
+         * Runs all stages on the given pool and blocks until they are finished. If a stage throws
+         * an exception, no further stages are started and the exception is rethrown after the
+         * running stages are finished.
+         *
+         * @throws StageGraphException if an input is not produced by exactly one stage or the
+         * stages depend on each other in a cycle.
+         */
+        void run(WorkStealingPool &pool);
+
+        /**
+         * @return The start and end time of each stage that was run, in the order in which the
+         * stages were added.
+         */
+        [[nodiscard]] std::vector<StageTiming> getTimings() const;
+
+        /**
+         * @return The chain of stages that bounded the run time of the graph: Starting with the
+         * stage that finished last, each stage is preceded by the dependency that finished last.
+         */
+        [[nodiscard]] std::vector<StageTiming> getCriticalPath() const;
+
+    private:
+        struct Stage {
+            StageTiming timing;
+            std::vector<std::string> inputs;
+            std::vector<std::string> outputs;
+            std::function<void()> run;
+            std::vector<size_t> dependencies;
+            std::vector<size_t> dependents;
+            bool finished = false;
+        };
+
+        std::set<std::string> _inputs;
+        std::vector<Stage> _stages;
+
+        void resolveDependencies();
+    };
+
+    class StageGraphException final : public std::exception {
+        std::string message;
+    public:
+        explicit StageGraphException(const char* msg) : message(msg) { }
+
+        [[nodiscard]] const char* what() const noexcept override {
+            return message.c_str();
+        }
+    };
+
+} // namespace olu::util
+
+#endif //STAGEGRAPH_H
@@ -20,6 +20,8 @@
 #define OLU_UTIL_TIME_H
 
 #include <chrono>
+#include <cstdint>
+#include <ctime>
 #include <iomanip>
 #include <sstream>
 #include <string>
@@ -62,6 +64,15 @@ namespace olu::util {
         return std::difftime(now_c, time_c);
     }
 
+    // Returns the seconds since the epoch for an ISO-formatted UTC timestamp
+    // ("YYYY-MM-DDTHH:MM:SS", optionally followed by "Z").
+    inline int64_t secondsSinceEpoch(const std::string& isoTimestamp) {
+        std::tm tm = {};
+        std::istringstream ss(isoTimestamp);
+        ss >> std::get_time(&tm, "%Y-%m-%dT%H:%M:%S");
+        return timegm(&tm);
+    }
+
     inline int minutesBetweenNowAndTimestamp(const std::string& isoTimestamp) {
         return secondsBetweenNowAndTimestamp(isoTimestamp) / 60;
     }
@@ -0,0 +1,83 @@
+// Copyright 2025, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef OSM_LIVE_UPDATES_TSVSTREAM_H
+#define OSM_LIVE_UPDATES_TSVSTREAM_H
+
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace olu::util {
+
+    /**
+     * Splits a SPARQL result in the tab-separated values format
+     * (https://www.w3.org/TR/sparql11-results-csv-tsv/) that arrives in chunks into rows.
+     *
+     * The header line with the variable names is skipped. Each row is passed to the callback as
+     * soon as its line is complete, as views of the values. Lines that lie completely in one
+     * chunk are split without copying them. Unbound values are empty.
+     *
+     * Tabs, line breaks and other special characters in values are escaped like in Turtle
+     * (`\t`, `\n`, `\\`, ...). Values that contain an escape sequence are unescaped into a
+     * buffer, which is only valid until the callback returns.
+     */
+    class TsvStream {
+    public:
+        using row_t = std::vector<std::string_view>;
+        using row_callback_t = std::function<void(const row_t &row)>;
+
+        explicit TsvStream(row_callback_t onRow);
+
+        /**
+         * Splits the next chunk of the result and calls the callback for each row that is
+         * completed by the chunk.
+         */
+        void feed(std::string_view chunk);
+
+        /**
+         * Passes the last row to the callback if the result does not end with a line break.
+         */
+        void finish();
+
+        [[nodiscard]] size_t getNumOfRows() const { return _numOfRows; }
+
+    private:
+        row_callback_t _onRow;
+        bool _isHeaderSkipped = false;
+        size_t _numOfRows = 0;
+
+        // Beginning of a line that continues in the next chunk
+        std::string _partialLine;
+        row_t _row;
+        // Unescaped values of the current row, at the index of the value
+        std::vector<std::string> _unescapedValues;
+
+        void handleLine(std::string_view line);
+
+        /**
+         * Replaces the escape sequences `\t`, `\b`, `\n`, `\r`, `\f`, `\"`, `\'` and `\\`
+         * in the value with the characters they stand for. Other sequences are kept unchanged.
+         */
+        static void unescape(std::string_view value, std::string &output);
+    };
+
+} // namespace olu::util
+
+#endif //OSM_LIVE_UPDATES_TSVSTREAM_H
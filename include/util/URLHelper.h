@@ -20,6 +20,7 @@
 #define OSM_LIVE_UPDATES_URLHELPER_H
 
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace olu::util {
@@ -37,6 +38,9 @@ public:
     // Url encodes the given string
     static std::string encodeForUrlQuery(const std::string& value);
 
+    // Url encodes the given string and appends it to `output`, so that a buffer can be reused
+    static void appendEncodedForUrlQuery(std::string& output, std::string_view value);
+
     static bool isValidUri(const std::string& uri);
 };
 
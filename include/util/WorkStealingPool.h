@@ -0,0 +1,90 @@
+// Copyright 2025, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+#ifndef WORKSTEALINGPOOL_H
+#define WORKSTEALINGPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace olu::util {
+
+    /**
+     * Thread pool in which each worker has its own queue of tasks. A worker runs the newest task
+     * of its own queue and steals the oldest task from the queue of another worker once its own
+     * queue is empty. Tasks that are submitted from a worker of the pool are added to the queue
+     * of that worker, so a task that spawns follow-up tasks tends to keep them on its thread.
+     *
+     * Tasks must not throw, exceptions have to be handled inside the task.
+     */
+    class WorkStealingPool {
+    public:
+        explicit WorkStealingPool(size_t numOfThreads);
+
+        /**
+         * Runs all tasks that are still queued and joins the worker threads.
+         */
+        ~WorkStealingPool();
+
+        WorkStealingPool(const WorkStealingPool&) = delete;
+        WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+        void submit(std::function<void()> task);
+
+        /**
+         * Blocks until all submitted tasks, including the ones they submitted, are finished.
+         */
+        void wait();
+
+        [[nodiscard]] size_t size() const { return _threads.size(); }
+        [[nodiscard]] size_t getNumOfStolenTasks() const { return _numOfStolenTasks; }
+
+    private:
+        struct TaskQueue {
+            std::mutex mutex;
+            std::deque<std::function<void()>> tasks;
+        };
+
+        std::vector<std::unique_ptr<TaskQueue>> _queues;
+        std::vector<std::thread> _threads;
+
+        // Guards the counters below, a worker reserves a task by decrementing
+        // `_numOfQueuedTasks` before it takes one from a queue.
+        std::mutex _mutex;
+        std::condition_variable _taskAvailable;
+        std::condition_variable _allTasksFinished;
+        size_t _numOfQueuedTasks = 0;
+        size_t _numOfUnfinishedTasks = 0;
+        bool _stopped = false;
+
+        std::atomic<size_t> _nextQueue = 0;
+        std::atomic<size_t> _numOfStolenTasks = 0;
+
+        void work(size_t worker);
+
+        std::function<void()> takeTask(size_t worker);
+    };
+
+} // namespace olu::util
+
+#endif //WORKSTEALINGPOOL_H
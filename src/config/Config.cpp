@@ -26,6 +26,7 @@
 
 #include "config/Constants.h"
 #include "config/ExitCode.h"
+#include "util/Compressor.h"
 #include "util/HttpRequest.h"
 #include "util/URLHelper.h"
 #include "util/Logger.h"
@@ -111,12 +112,78 @@ void olu::config::Config::fromArgs(const int argc, char **argv) {
         constants::BATCH_SIZE_OPTION_LONG,
         constants::BATCH_SIZE_OPTION_HELP);
 
+    const auto insertBatchSizeMbOp = parser.add<popl::Value<u_int32_t>,
+        popl::Attribute::advanced>(
+        constants::INSERT_BATCH_SIZE_MB_OPTION_SHORT,
+        constants::INSERT_BATCH_SIZE_MB_OPTION_LONG,
+        constants::INSERT_BATCH_SIZE_MB_OPTION_HELP);
+
+    const auto adaptiveBatchSizeOp = parser.add<popl::Switch,
+        popl::Attribute::advanced>(
+        constants::ADAPTIVE_BATCH_SIZE_OPTION_SHORT,
+        constants::ADAPTIVE_BATCH_SIZE_OPTION_LONG,
+        constants::ADAPTIVE_BATCH_SIZE_OPTION_HELP);
+
     const auto isQleverEndpointOp = parser.add<popl::Switch,
         popl::Attribute::advanced>(
         constants::QLEVER_ENDPOINT_OPTION_SHORT,
         constants::QLEVER_ENDPOINT_OPTION_LONG,
         constants::QLEVER_ENDPOINT_OPTION_HELP);
 
+    const auto maxDownloadsOp = parser.add<popl::Value<u_int16_t>,
+        popl::Attribute::advanced>(
+        constants::MAX_DOWNLOADS_OPTION_SHORT,
+        constants::MAX_DOWNLOADS_OPTION_LONG,
+        constants::MAX_DOWNLOADS_OPTION_HELP);
+
+    const auto maxConcurrentRequestsOp = parser.add<popl::Value<u_int16_t>,
+        popl::Attribute::advanced>(
+        constants::MAX_CONCURRENT_REQUESTS_OPTION_SHORT,
+        constants::MAX_CONCURRENT_REQUESTS_OPTION_LONG,
+        constants::MAX_CONCURRENT_REQUESTS_OPTION_HELP);
+
+    const auto streamChangeFilesOp = parser.add<popl::Switch,
+        popl::Attribute::advanced>(
+        constants::STREAM_CHANGE_FILES_OPTION_SHORT,
+        constants::STREAM_CHANGE_FILES_OPTION_LONG,
+        constants::STREAM_CHANGE_FILES_OPTION_HELP);
+
+    const auto mergeMemoryLimitOp = parser.add<popl::Value<u_int32_t>,
+        popl::Attribute::advanced>(
+        constants::MERGE_MEMORY_LIMIT_OPTION_SHORT,
+        constants::MERGE_MEMORY_LIMIT_OPTION_LONG,
+        constants::MERGE_MEMORY_LIMIT_OPTION_HELP);
+
+    const auto http2Op = parser.add<popl::Switch,
+        popl::Attribute::advanced>(
+        constants::HTTP2_OPTION_SHORT,
+        constants::HTTP2_OPTION_LONG,
+        constants::HTTP2_OPTION_HELP);
+
+    const auto formEncodingOp = parser.add<popl::Switch,
+        popl::Attribute::advanced>(
+        constants::FORM_ENCODING_OPTION_SHORT,
+        constants::FORM_ENCODING_OPTION_LONG,
+        constants::FORM_ENCODING_OPTION_HELP);
+
+    const auto compressionOp = parser.add<popl::Value<std::string>,
+        popl::Attribute::advanced>(
+        constants::COMPRESSION_OPTION_SHORT,
+        constants::COMPRESSION_OPTION_LONG,
+        constants::COMPRESSION_OPTION_HELP);
+
+    const auto tsvResultsOp = parser.add<popl::Switch,
+        popl::Attribute::advanced>(
+        constants::TSV_RESULTS_OPTION_SHORT,
+        constants::TSV_RESULTS_OPTION_LONG,
+        constants::TSV_RESULTS_OPTION_HELP);
+
+    const auto interleaveUpdatesOp = parser.add<popl::Switch,
+        popl::Attribute::advanced>(
+        constants::INTERLEAVE_UPDATES_OPTION_SHORT,
+        constants::INTERLEAVE_UPDATES_OPTION_LONG,
+        constants::INTERLEAVE_UPDATES_OPTION_HELP);
+
     const auto showStatisticsOp = parser.add<popl::Switch,
         popl::Attribute::advanced>(
         constants::STATISTICS_OPTION_SHORT,
@@ -147,6 +214,18 @@ void olu::config::Config::fromArgs(const int argc, char **argv) {
         constants::TMP_FILE_DIR_OPTION_LONG,
         constants::TMP_FILE_DIR_OPTION_HELP);
 
+    const auto indexDirOp = parser.add<popl::Value<std::string>,
+    popl::Attribute::advanced>(
+        constants::INDEX_DIR_OPTION_SHORT,
+        constants::INDEX_DIR_OPTION_LONG,
+        constants::INDEX_DIR_OPTION_HELP);
+
+    const auto indexBootstrapOp = parser.add<popl::Value<std::string>,
+    popl::Attribute::advanced>(
+        constants::INDEX_BOOTSTRAP_OPTION_SHORT,
+        constants::INDEX_BOOTSTRAP_OPTION_LONG,
+        constants::INDEX_BOOTSTRAP_OPTION_HELP);
+
     try {
         parser.parse(argc, argv);
 
@@ -226,6 +305,39 @@ void olu::config::Config::fromArgs(const int argc, char **argv) {
             }
         }
 
+        if (indexDirOp->is_set()) {
+            indexDir = indexDirOp->value();
+            if (!std::filesystem::exists(indexDir)) {
+                std::filesystem::create_directories(indexDir);
+            }
+            if (!std::filesystem::is_directory(indexDir)) {
+                std::stringstream errorDescription;
+                errorDescription << "Directory for local indexes is not a directory: " << indexDir
+                                 << std::endl;
+                util::Logger::log(util::LogEvent::ERROR, errorDescription.str());
+                exit(INDEX_DIR_IS_NOT_DIRECTORY);
+            }
+        }
+
+        if (indexBootstrapOp->is_set()) {
+            indexBootstrapFile = indexBootstrapOp->value();
+            if (!indexDirOp->is_set()) {
+                std::stringstream errorDescription;
+                errorDescription << "Specified a file to build the local indexes from without "
+                                    "specifying a directory for the indexes (--index-dir)."
+                                 << std::endl;
+                util::Logger::log(util::LogEvent::ERROR, errorDescription.str());
+                exit(INCORRECT_ARGUMENTS);
+            }
+            if (!std::filesystem::is_regular_file(indexBootstrapFile)) {
+                std::stringstream errorDescription;
+                errorDescription << "File to build the local indexes from does not exist: "
+                                 << indexBootstrapFile << std::endl;
+                util::Logger::log(util::LogEvent::ERROR, errorDescription.str());
+                exit(INDEX_BOOTSTRAP_FILE_NOT_EXISTS);
+            }
+        }
+
         if (replicationServerUriOp->is_set()) {
             replicationServerUri = replicationServerUriOp->value();
             if (!util::URLHelper::isValidUri(replicationServerUri)) {
@@ -273,17 +385,6 @@ void olu::config::Config::fromArgs(const int argc, char **argv) {
             exit(INCORRECT_ARGUMENTS);
         }
 
-        if ((bboxOp->is_set() || polyFileOp->is_set()) &&
-            std::system("osmium >/dev/null 2>&1") != 0) {
-            std::stringstream errorDescription;
-            errorDescription << "Missing dependency: 'osmium-tool' is required for bounding box "
-                                "(--bbox) or polygon file (--polygon-file) support.\n"
-                                "Please install 'osmium-tool' and ensure it is available as "
-                                "'osmium' in your PATH.";
-            util::Logger::log(util::LogEvent::ERROR, errorDescription.str());
-            exit(FAILURE);
-        }
-
         if (bboxOp->is_set()) {
             bbox = bboxOp->value();
             // Check if the bounding box is in the correct format "LEFT,BOTTOM,RIGHT,TOP"
@@ -370,10 +471,96 @@ void olu::config::Config::fromArgs(const int argc, char **argv) {
             batchSize = batchSizeOp->value();
         }
 
+        if (insertBatchSizeMbOp->is_set()) {
+            if (insertBatchSizeMbOp->value() == 0) {
+                util::Logger::log(util::LogEvent::ERROR,
+                                  "The maximum size of an insert operation must be positive");
+                exit(INCORRECT_ARGUMENTS);
+            }
+            insertBatchBytes = static_cast<size_t>(insertBatchSizeMbOp->value()) << 20;
+        }
+
+        if (adaptiveBatchSizeOp->is_set()) {
+            adaptiveBatchSize = true;
+        }
+
         if (isQleverEndpointOp->is_set()) {
             isQLever = true;
         }
 
+        if (maxDownloadsOp->is_set()) {
+            if (maxDownloadsOp->value() == 0) {
+                util::Logger::log(util::LogEvent::ERROR,
+                                  "The maximum number of concurrent downloads must be positive");
+                exit(INCORRECT_ARGUMENTS);
+            }
+            maxConcurrentDownloads = maxDownloadsOp->value();
+        }
+
+        if (maxConcurrentRequestsOp->is_set()) {
+            if (maxConcurrentRequestsOp->value() == 0) {
+                util::Logger::log(util::LogEvent::ERROR,
+                                  "The maximum number of concurrent requests must be positive");
+                exit(INCORRECT_ARGUMENTS);
+            }
+            maxConcurrentRequests = maxConcurrentRequestsOp->value();
+        }
+
+        if (streamChangeFilesOp->is_set()) {
+            streamChangeFiles = true;
+        }
+
+        if (mergeMemoryLimitOp->is_set()) {
+            if (mergeMemoryLimitOp->value() == 0) {
+                util::Logger::log(util::LogEvent::ERROR,
+                                  "The memory limit for merging change files must be positive");
+                exit(INCORRECT_ARGUMENTS);
+            }
+            mergeMemoryLimit = static_cast<size_t>(mergeMemoryLimitOp->value()) << 20;
+        }
+
+        if (http2Op->is_set()) {
+            useHttp2 = true;
+        }
+
+        if (formEncodingOp->is_set()) {
+            useFormEncoding = true;
+        }
+
+        if (compressionOp->is_set()) {
+            requestCompression = compressionOp->value();
+            if (requestCompression != "gzip" && requestCompression != "zstd") {
+                util::Logger::log(util::LogEvent::ERROR,
+                                  "Invalid compression specified: " + requestCompression
+                                  + ". Valid compressions are 'gzip' and 'zstd'.");
+                exit(INCORRECT_ARGUMENTS);
+            }
+
+            if (!util::Compressor::isSupported(
+                    util::Compressor::typeFromString(requestCompression))) {
+                util::Logger::log(util::LogEvent::ERROR,
+                                  "This build does not support the compression: "
+                                  + requestCompression);
+                exit(INCORRECT_ARGUMENTS);
+            }
+        }
+
+        if (tsvResultsOp->is_set()) {
+            if (!isQLever) {
+                util::Logger::log(util::LogEvent::ERROR,
+                                  "Query results as tab-separated values are only supported for "
+                                  "QLever endpoints, use the --" +
+                                  constants::QLEVER_ENDPOINT_OPTION_LONG + " option");
+                exit(INCORRECT_ARGUMENTS);
+            }
+
+            useTsvResults = true;
+        }
+
+        if (interleaveUpdatesOp->is_set()) {
+            interleaveUpdates = true;
+        }
+
         if (showStatisticsOp->is_set()) {
             showDetailedStatistics = true;
         }
@@ -427,6 +614,49 @@ void olu::config::Config::printInfo() const {
         util::Logger::log(util::LogEvent::CONFIG, constants::QLEVER_ENDPOINT_INFO);
     }
 
+    if (maxConcurrentDownloads != DEFAULT_MAX_CONCURRENT_DOWNLOADS) {
+        util::Logger::log(util::LogEvent::CONFIG,
+                          constants::MAX_DOWNLOADS_INFO + " "
+                          + std::to_string(maxConcurrentDownloads));
+    }
+
+    if (maxConcurrentRequests != DEFAULT_MAX_CONCURRENT_REQUESTS) {
+        util::Logger::log(util::LogEvent::CONFIG,
+                          constants::MAX_CONCURRENT_REQUESTS_INFO + " "
+                          + std::to_string(maxConcurrentRequests));
+    }
+
+    if (streamChangeFiles) {
+        util::Logger::log(util::LogEvent::CONFIG, constants::STREAM_CHANGE_FILES_INFO);
+    }
+
+    if (mergeMemoryLimit != static_cast<size_t>(DEFAULT_MERGE_MEMORY_LIMIT_MB) << 20) {
+        util::Logger::log(util::LogEvent::CONFIG,
+                          constants::MERGE_MEMORY_LIMIT_INFO + " "
+                          + std::to_string(mergeMemoryLimit >> 20));
+    }
+
+    if (useHttp2) {
+        util::Logger::log(util::LogEvent::CONFIG, constants::HTTP2_INFO);
+    }
+
+    if (useFormEncoding) {
+        util::Logger::log(util::LogEvent::CONFIG, constants::FORM_ENCODING_INFO);
+    }
+
+    if (!requestCompression.empty()) {
+        util::Logger::log(util::LogEvent::CONFIG,
+                          constants::COMPRESSION_INFO + " " + requestCompression);
+    }
+
+    if (useTsvResults) {
+        util::Logger::log(util::LogEvent::CONFIG, constants::TSV_RESULTS_INFO);
+    }
+
+    if (interleaveUpdates) {
+        util::Logger::log(util::LogEvent::CONFIG, constants::INTERLEAVE_UPDATES_INFO);
+    }
+
     if (!graphUri.empty()) {
         util::Logger::log(util::LogEvent::CONFIG,
                           constants::SPARQL_GRAPH_URI_INFO + " " + graphUri);
@@ -477,6 +707,26 @@ void olu::config::Config::printInfo() const {
                           constants::BATCH_SIZE_INFO + " " + std::to_string(batchSize));
     }
 
+    if (insertBatchBytes != static_cast<size_t>(DEFAULT_INSERT_BATCH_SIZE_MB) << 20) {
+        util::Logger::log(util::LogEvent::CONFIG,
+                          constants::INSERT_BATCH_SIZE_MB_INFO + " "
+                          + std::to_string(insertBatchBytes >> 20));
+    }
+
+    if (adaptiveBatchSize) {
+        util::Logger::log(util::LogEvent::CONFIG, constants::ADAPTIVE_BATCH_SIZE_INFO);
+    }
+
+    if (!indexDir.empty()) {
+        util::Logger::log(util::LogEvent::CONFIG,
+                          constants::INDEX_DIR_INFO + " " + indexDir.string());
+    }
+
+    if (!indexBootstrapFile.empty()) {
+        util::Logger::log(util::LogEvent::CONFIG,
+                          constants::INDEX_BOOTSTRAP_INFO + " " + indexBootstrapFile.string());
+    }
+
     util::Logger::log(util::LogEvent::CONFIG,
         constants::TMP_FILE_DIR_INFO + " " + tmpDir.string());
 }
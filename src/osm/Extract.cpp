@@ -0,0 +1,250 @@
+// Copyright 2025, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "osm/Extract.h"
+
+#include <sstream>
+
+#include "osmium/osm/node.hpp"
+#include "osmium/osm/relation.hpp"
+#include "osmium/osm/way.hpp"
+
+// _________________________________________________________________________________________________
+olu::osm::Extract::Extract(const config::Config &config):
+    _strategy(strategyFromString(config.extractStrategy)) {
+    if (!config.bbox.empty()) {
+        // The bounding box has the format "LEFT,BOTTOM,RIGHT,TOP", which is checked by the config
+        std::istringstream bbox(config.bbox);
+        double coordinates[4];
+        char separator;
+        bbox >> coordinates[0] >> separator >> coordinates[1] >> separator >> coordinates[2]
+             >> separator >> coordinates[3];
+        if (!bbox) {
+            const std::string msg = "Invalid bounding box: " + config.bbox;
+            throw ExtractException(msg.c_str());
+        }
+        _box = osmium::Box(coordinates[0], coordinates[1], coordinates[2], coordinates[3]);
+    } else if (!config.pathToPolygonFile.empty()) {
+        try {
+            _polygon = util::PolygonIndex::fromPolyFile(config.pathToPolygonFile);
+        } catch (const util::PolygonIndexException &e) {
+            throw ExtractException(e.what());
+        }
+    } else {
+        throw ExtractException("No bounding box or polygon file specified.");
+    }
+}
+
+// _________________________________________________________________________________________________
+olu::osm::Extract::Extract(const osmium::Box &box, const ExtractStrategy strategy):
+    _strategy(strategy), _box(box) { }
+
+// _________________________________________________________________________________________________
+olu::osm::Extract::Extract(util::PolygonIndex polygon, const ExtractStrategy strategy):
+    _strategy(strategy), _polygon(std::move(polygon)) { }
+
+// _________________________________________________________________________________________________
+olu::osm::ExtractStrategy olu::osm::Extract::strategyFromString(const std::string &strategy) {
+    if (strategy == "simple") {
+        return ExtractStrategy::SIMPLE;
+    }
+    if (strategy == "complete_ways") {
+        return ExtractStrategy::COMPLETE_WAYS;
+    }
+    if (strategy == "smart") {
+        return ExtractStrategy::SMART;
+    }
+
+    const std::string msg = "Unknown extract strategy: " + strategy;
+    throw ExtractException(msg.c_str());
+}
+
+// _________________________________________________________________________________________________
+bool olu::osm::Extract::contains(const osmium::Location &location) const {
+    if (!location.valid()) {
+        return false;
+    }
+
+    if (_box) {
+        return _box->contains(location);
+    }
+    return _polygon->contains(location.lon(), location.lat());
+}
+
+// _________________________________________________________________________________________________
+void olu::osm::Extract::prepare(const osmium::OSMObject &object) {
+    switch (object.type()) {
+        case osmium::item_type::node:
+            prepareNode(object);
+            break;
+        case osmium::item_type::way:
+            prepareWay(object);
+            break;
+        case osmium::item_type::relation:
+            prepareRelation(object);
+            break;
+        default:
+            break;
+    }
+}
+
+// _________________________________________________________________________________________________
+void olu::osm::Extract::prepareNode(const osmium::OSMObject &object) {
+    if (const auto &node = static_cast<const osmium::Node &>(object); contains(node.location())) {
+        _nodesInRegion.insert(node.id());
+    }
+}
+
+// _________________________________________________________________________________________________
+void olu::osm::Extract::prepareWay(const osmium::OSMObject &object) {
+    const auto &way = static_cast<const osmium::Way &>(object);
+    bool isIncluded = false;
+    for (const auto &nodeRef: way.nodes()) {
+        if (_nodesInRegion.contains(nodeRef.ref())) {
+            isIncluded = true;
+            break;
+        }
+    }
+
+    if (isIncluded) {
+        _ways.insert(way.id());
+    }
+
+    if (_strategy == ExtractStrategy::SIMPLE) {
+        return;
+    }
+
+    if (isIncluded) {
+        for (const auto &nodeRef: way.nodes()) {
+            if (!_nodesInRegion.contains(nodeRef.ref())) {
+                _extraNodes.insert(nodeRef.ref());
+            }
+        }
+    } else if (_strategy == ExtractStrategy::SMART) {
+        // The way might become a member of an included multipolygon relation
+        auto &nodes = _nodesOfWays[way.id()];
+        for (const auto &nodeRef: way.nodes()) {
+            nodes.push_back(nodeRef.ref());
+        }
+    }
+}
+
+// _________________________________________________________________________________________________
+void olu::osm::Extract::prepareRelation(const osmium::OSMObject &object) {
+    const auto &relation = static_cast<const osmium::Relation &>(object);
+    bool isIncluded = false;
+    for (const auto &member: relation.members()) {
+        switch (member.type()) {
+            case osmium::item_type::node:
+                isIncluded |= _nodesInRegion.contains(member.ref());
+                break;
+            case osmium::item_type::way:
+                isIncluded |= _ways.contains(member.ref());
+                break;
+            case osmium::item_type::relation:
+                if (_strategy != ExtractStrategy::SIMPLE) {
+                    _parentsOfRelations[member.ref()].push_back(relation.id());
+                }
+                break;
+            default:
+                break;
+        }
+    }
+
+    if (!isIncluded) {
+        return;
+    }
+    _relations.insert(relation.id());
+
+    // Like osmium extract, only multipolygons that directly reference a node or way of the
+    // extract are completed, not the ones that are included as parents of other relations
+    if (_strategy == ExtractStrategy::SMART && relation.tags().has_tag("type", "multipolygon")) {
+        for (const auto &member: relation.members()) {
+            if (member.type() == osmium::item_type::node &&
+                !_nodesInRegion.contains(member.ref())) {
+                _extraNodes.insert(member.ref());
+            } else if (member.type() == osmium::item_type::way) {
+                _waysOfMultipolygons.push_back(member.ref());
+            }
+        }
+    }
+}
+
+// _________________________________________________________________________________________________
+void olu::osm::Extract::finish() {
+    if (_strategy != ExtractStrategy::SIMPLE) {
+        // Add the parents of included relations until no relation is added anymore
+        std::vector<id_t> relationsToCheck(_relations.begin(), _relations.end());
+        while (!relationsToCheck.empty()) {
+            const id_t relationId = relationsToCheck.back();
+            relationsToCheck.pop_back();
+            if (const auto parents = _parentsOfRelations.find(relationId);
+                parents != _parentsOfRelations.end()) {
+                for (const auto &parentId: parents->second) {
+                    if (_relations.insert(parentId).second) {
+                        relationsToCheck.push_back(parentId);
+                    }
+                }
+            }
+        }
+    }
+
+    if (_strategy == ExtractStrategy::SMART) {
+        // Add the member ways of the completed multipolygon relations with all their nodes
+        for (const auto &wayId: _waysOfMultipolygons) {
+            const auto nodes = _nodesOfWays.find(wayId);
+            if (nodes == _nodesOfWays.end() || !_ways.insert(wayId).second) {
+                continue;
+            }
+
+            for (const auto &nodeId: nodes->second) {
+                if (!_nodesInRegion.contains(nodeId)) {
+                    _extraNodes.insert(nodeId);
+                }
+            }
+        }
+    }
+
+    _nodesOfWays.clear();
+    _parentsOfRelations.clear();
+    _waysOfMultipolygons.clear();
+    _isFinished = true;
+}
+
+// _________________________________________________________________________________________________
+bool olu::osm::Extract::includes(const osmium::OSMObject &object) {
+    if (!_isFinished) {
+        if (needsPreparation()) {
+            throw ExtractException("The extract has to be prepared with all objects first.");
+        }
+
+        // With the simple strategy, an object only depends on the objects before it
+        prepare(object);
+    }
+
+    switch (object.type()) {
+        case osmium::item_type::node:
+            return _nodesInRegion.contains(object.id()) || _extraNodes.contains(object.id());
+        case osmium::item_type::way:
+            return _ways.contains(object.id());
+        case osmium::item_type::relation:
+            return _relations.contains(object.id());
+        default:
+            return false;
+    }
+}
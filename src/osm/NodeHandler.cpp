@@ -18,7 +18,8 @@
 
 #include "osm/NodeHandler.h"
 
-#include <ranges>
+#include <algorithm>
+#include <utility>
 
 #include "osmium/osm/node.hpp"
 
@@ -34,8 +35,13 @@ void olu::osm::NodeHandler::node(const osmium::Node& node) {
             _stats->countCreatedNode();
             break;
         case ChangeAction::MODIFY:
-            _modifiedNodesBuffer.emplace(node.id(), node.location());
+            if (_modifiedNodesBuffer.emplace(node.id(), node.location()).second) {
+                _nodesToRequest.insert(_nodesToRequest.end(), node.id());
+            }
             _stats->countModifiedNode();
+            if (_nodesToRequest.size() >= _batchSizes->nodeLocations.get()) {
+                requestLocations();
+            }
             break;
         case ChangeAction::DELETE:
             _deletedNodes.insert(node.id());
@@ -45,22 +51,84 @@ void olu::osm::NodeHandler::node(const osmium::Node& node) {
 }
 
 // _________________________________________________________________________________________________
-void olu::osm::NodeHandler::checkNodesForLocationChange() {
-    auto keysView = std::views::keys(_modifiedNodesBuffer);
-    const auto nodeIds = std::set(keysView.begin(), keysView.end());
-
-    std::map<id_t, osmium::Location> remoteNodes;
-    util::BatchHelper::doInBatches(
-        nodeIds,
-        _config.batchSize,
-        [this, &remoteNodes](std::set<id_t> const& batch) mutable {
-            for (const auto& node : _odf->fetchNodes(batch)) {
-                remoteNodes.emplace(node.getId(), node.getLocation());
+void olu::osm::NodeHandler::requestLocations() {
+    if (_nodesToRequest.empty()) {
+        return;
+    }
+
+    // Reading the change file only waits for the endpoint if it is slower than the parsing
+    if (_locationRequests.size() >= std::max<size_t>(_config.maxConcurrentRequests, 1)) {
+        auto request = std::move(_locationRequests.front());
+        _locationRequests.pop_front();
+        collectLocations(request);
+    }
+
+    _locationRequests.push_back(std::async(
+        std::launch::async,
+        [odf = _odf, batchSizes = _batchSizes, nodeLocationIndex = _nodeLocationIndex,
+         nodeIds = std::move(_nodesToRequest)]() mutable {
+            LocationRequestResult result;
+            if (nodeLocationIndex != nullptr) {
+                std::vector<Node> indexedNodes;
+                nodeIds = nodeLocationIndex->lookup(nodeIds, indexedNodes);
+                for (const auto& node : indexedNodes) {
+                    result.locations.emplace(node.getId(), node.getLocation());
+                }
+                result.indexHits = indexedNodes.size();
+                result.indexMisses = nodeIds.size();
             }
-    });
+
+            util::BatchHelper::doInBatches(
+                nodeIds,
+                batchSizes->nodeLocations,
+                [odf, &result](std::set<id_t> const& batch) {
+                    for (const auto& node : odf->fetchNodes(batch)) {
+                        result.locations.emplace(node.getId(), node.getLocation());
+                    }
+                });
+
+            return result;
+        }));
+    _nodesToRequest.clear();
+}
+
+// _________________________________________________________________________________________________
+void olu::osm::NodeHandler::collectLocations(std::future<LocationRequestResult> &request) {
+    auto result = request.get();
+    _previousLocations.merge(result.locations);
+    if (_nodeLocationIndex != nullptr) {
+        _stats->countNodeLocationIndexLookups(result.indexHits, result.indexMisses);
+    }
+}
+
+// _________________________________________________________________________________________________
+void olu::osm::NodeHandler::waitForLocationRequests() noexcept {
+    for (const auto &request : _locationRequests) {
+        if (request.valid()) {
+            request.wait();
+        }
+    }
+    _locationRequests.clear();
+}
+
+// _________________________________________________________________________________________________
+void olu::osm::NodeHandler::checkNodesForLocationChange() {
+    try {
+        requestLocations();
+        while (!_locationRequests.empty()) {
+            auto request = std::move(_locationRequests.front());
+            _locationRequests.pop_front();
+            collectLocations(request);
+        }
+    } catch (...) {
+        // The other requests must not outlive the handler
+        waitForLocationRequests();
+        throw;
+    }
 
     for (const auto&[localId, localLocation] : _modifiedNodesBuffer) {
-        if (const auto remoteNode = remoteNodes.find(localId); remoteNode != remoteNodes.end()) {
+        if (const auto remoteNode = _previousLocations.find(localId);
+            remoteNode != _previousLocations.end()) {
             if (localLocation == remoteNode->second) {
                 _modifiedNodes.insert(localId);
             } else {
@@ -77,4 +145,5 @@ void olu::osm::NodeHandler::checkNodesForLocationChange() {
     }
 
     _modifiedNodesBuffer.clear();
-}
\ No newline at end of file
+    _previousLocations.clear();
+}
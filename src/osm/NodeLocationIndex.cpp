@@ -0,0 +1,77 @@
+// Copyright 2025, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "osm/NodeLocationIndex.h"
+
+#include "osmium/osm/node.hpp"
+
+#include "osm/OsmObjectHelper.h"
+
+// _________________________________________________________________________________________________
+void olu::osm::NodeLocationIndex::node(const osmium::Node &node) {
+    if (OsmObjectHelper::getChangeAction(node) == ChangeAction::DELETE) {
+        remove(node.id());
+        return;
+    }
+
+    set(node.id(), node.location());
+}
+
+// _________________________________________________________________________________________________
+osmium::Location olu::osm::NodeLocationIndex::get(const id_t &nodeId) const {
+    if (nodeId < 0 || static_cast<size_t>(nodeId) >= _locations.size()) {
+        return {};
+    }
+
+    const auto& [x, y] = _locations[nodeId];
+    return osmium::Location(x ^ UNDEFINED_MASK, y ^ UNDEFINED_MASK);
+}
+
+// _________________________________________________________________________________________________
+void olu::osm::NodeLocationIndex::set(const id_t &nodeId, const osmium::Location &location) {
+    if (nodeId < 0) {
+        return;
+    }
+
+    _locations.grow(nodeId + 1);
+    _locations[nodeId] = {location.x() ^ UNDEFINED_MASK, location.y() ^ UNDEFINED_MASK};
+}
+
+// _________________________________________________________________________________________________
+void olu::osm::NodeLocationIndex::remove(const id_t &nodeId) {
+    if (nodeId < 0 || static_cast<size_t>(nodeId) >= _locations.size()) {
+        return;
+    }
+
+    _locations[nodeId] = {0, 0};
+}
+
+// _________________________________________________________________________________________________
+std::set<olu::id_t> olu::osm::NodeLocationIndex::lookup(const std::set<id_t> &nodeIds,
+                                                        std::vector<Node> &nodes) const {
+    std::set<id_t> missingNodeIds;
+    for (const auto &nodeId: nodeIds) {
+        if (const auto location = get(nodeId); location.is_defined()) {
+            nodes.emplace_back(nodeId, location);
+        } else {
+            missingNodeIds.insert(missingNodeIds.end(), nodeId);
+        }
+    }
+
+    return missingNodeIds;
+}
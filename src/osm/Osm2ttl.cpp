@@ -35,6 +35,15 @@
 
 namespace cnst = olu::config::constants;
 
+// _________________________________________________________________________________________________
+void olu::osm::Osm2ttl::fetchOptions() {
+    _config->osm2rdfOptions = _odf->fetchOsm2RdfOptions();
+    if (_config->osm2rdfOptions.empty()) {
+        util::Logger::log(util::LogEvent::WARNING, "No osm2rdf options found on SPARQL "
+                                                   "endpoint, using default options.");
+    }
+}
+
 // _________________________________________________________________________________________________
 void olu::osm::Osm2ttl::convert() {
     // Create a directory for scratch, if not already existent
@@ -121,7 +130,7 @@ bool olu::osm::Osm2ttl::hasTripleForOption(const std::string& option, const std:
 }
 
 // _________________________________________________________________________________________________
-std::vector<std::string> olu::osm::Osm2ttl::getArgsFromEndpoint() {
+std::vector<std::string> olu::osm::Osm2ttl::getArgsFromEndpoint() const {
     // Osm2rdf options that are supported by the current version of osm2rdf
     // Has to be updated when new options are added to osm2rdf
     std::vector supportedOsm2rdfOptions = {
@@ -167,13 +176,7 @@ std::vector<std::string> olu::osm::Osm2ttl::getArgsFromEndpoint() {
        "none"
     };
 
-    _config->osm2rdfOptions = _odf->fetchOsm2RdfOptions();
-    if (_config->osm2rdfOptions.empty()) {
-        util::Logger::log(util::LogEvent::WARNING, "No osm2rdf options found on SPARQL "
-                                                   "endpoint, using default options.");
-        return arguments;
-    }
-
+    // The options were fetched by `fetchOptions()`
     for (const auto& [optionName, optionValue] : _config->osm2rdfOptions) {
         // Only add arguments for supported osm2rdf options to avoid errors when the osm2rdf dump
         // was created with a newer version of osm2rdf than the one olu uses internally
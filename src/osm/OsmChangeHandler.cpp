@@ -18,10 +18,15 @@
 
 #include "osm/OsmChangeHandler.h"
 
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
 #include <fstream>
 #include <string>
 #include <iosfwd>
+#include <iterator>
 #include <set>
+#include <thread>
 #include <vector>
 
 #include <osmium/io/reader.hpp>
@@ -37,24 +42,102 @@
 #include "util/XmlHelper.h"
 #include "util/TtlHelper.h"
 #include "util/BatchHelper.h"
+#include "util/BoundedQueue.h"
+#include "util/Exceptions.h"
 #include "util/Logger.h"
+#include "util/StageGraph.h"
+#include "util/WorkStealingPool.h"
 
 namespace cnst = olu::config::constants;
 namespace osm2rdfCnst = osm2rdf::config::constants;
 
+namespace {
+    /**
+     * Folds triples with a blank node as object together with the triples of the blank node,
+     * which directly follow them in the osm2rdf output: "s p [ p1 o1; p2 o2; ]"
+     */
+    class BlankNodeFolder {
+    public:
+        /**
+         * Adds the triple and passes the triples that are complete to `emit`.
+         */
+        template <typename Emit>
+        void add(const olu::triple_t &triple, const Emit &emit) {
+            const auto& [s, p, o] = triple;
+            if (!_foldedTriple.empty()) {
+                if (s.starts_with("_")) {
+                    _foldedTriple += p;
+                    _foldedTriple += " ";
+                    _foldedTriple += o;
+                    _foldedTriple += "; ";
+                    return;
+                }
+
+                finish(emit);
+            }
+
+            if (o.starts_with("_")) {
+                _foldedTriple += s;
+                _foldedTriple += " ";
+                _foldedTriple += p;
+                _foldedTriple += "[ ";
+                return;
+            }
+
+            emit(olu::util::TtlHelper::getTripleString(triple));
+        }
+
+        /**
+         * Passes the triple that is currently folded to `emit`, if there is one.
+         */
+        template <typename Emit>
+        void finish(const Emit &emit) {
+            if (_foldedTriple.empty()) {
+                return;
+            }
+
+            _foldedTriple += " ]";
+            emit(std::move(_foldedTriple));
+            _foldedTriple.clear();
+        }
+
+    private:
+        std::string _foldedTriple;
+    };
+
+    std::set<olu::id_t> getIntersection(const std::set<olu::id_t> &a,
+                                        const std::set<olu::id_t> &b) {
+        std::set<olu::id_t> intersection;
+        std::ranges::set_intersection(a, b, std::inserter(intersection, intersection.end()));
+        return intersection;
+    }
+} // namespace
+
 // _________________________________________________________________________________________________
 olu::osm::OsmChangeHandler::OsmChangeHandler(config::Config &config, OsmDataFetcher &odf,
-                                             StatisticsHandler &stats) :
+                                             StatisticsHandler &stats,
+                                             const NodeLocationIndex *nodeLocationIndex,
+                                             const WayNodeIndex *wayNodeIndex,
+                                             const RelationMemberIndex *relationMemberIndex) :
     _config(&config),
     _sparql(config),
     _queryWriter(config),
     _odf(&odf),
     _stats(&stats),
     _osm2ttl(_config, _odf, _stats),
-    _nodeHandler(config, odf, stats),
+    _nodeLocationIndex(nodeLocationIndex),
+    _wayNodeIndex(wayNodeIndex),
+    _relationMemberIndex(relationMemberIndex),
+    _batchSizes(config),
+    _nodeHandler(config, odf, stats, _batchSizes, nodeLocationIndex),
     _wayHandler(config, odf, stats),
     _relationHandler(config, odf, stats),
-    _referencesHandler(config, odf, _nodeHandler, _wayHandler, _relationHandler) { }
+    _referencesHandler(config, odf, _nodeHandler, _wayHandler, _relationHandler, _batchSizes,
+                       relationMemberIndex) {
+    for (size_t worker = 1; worker < getMaxConcurrentUpdates(); ++worker) {
+        _updateWorkers.push_back(std::make_unique<UpdateWorker>(config));
+    }
+}
 
 // _________________________________________________________________________________________________
 void olu::osm::OsmChangeHandler::run() {
@@ -64,117 +147,192 @@ void olu::osm::OsmChangeHandler::run() {
     // corresponding set
     // (_createdNodes/Ways/Relations, _modifiedNodes/Ways/Relations,
     // _deletedNodes/Ways/Relations).
-    osmium::io::Reader nodeReader{ cnst::getPathToChangeFile(_config->tmpDir),
-        osmium::osm_entity_bits::node,
-        osmium::io::read_meta::no};
-    osmium::apply(nodeReader, _nodeHandler);
-    // Check for modified nodes if the location has changed.
-    // If so, the node is added to the _modifiedNodesWithChangedLocation set, otherwise to the
-    // _modifiedNodes set
-    _stats->startTimeCheckingNodeLocations();
-    _nodeHandler.checkNodesForLocationChange();
-    _stats->endTimeCheckingNodeLocations();
-    nodeReader.close();
-
-    osmium::io::Reader wayReader{ cnst::getPathToChangeFile(_config->tmpDir),
-        osmium::osm_entity_bits::way,
-        osmium::io::read_meta::no};
-    osmium::apply(wayReader, _wayHandler);
-    // Check for modified ways if the members have changed.
-    // If so, the way is added to the _modifiedWaysWithChangedMembers set, otherwise to the
-    // _modifiedWays set
-    wayReader.close();
-
-    osmium::io::Reader relationReader{ cnst::getPathToChangeFile(_config->tmpDir),
-        osmium::osm_entity_bits::relation,
+    // The references handler only records the member lists of the ways and relations in the same
+    // pass, because we can only decide which members are missing from the change file after all
+    // objects have been read.
+    osmium::io::Reader reader{ cnst::getPathToChangeFile(_config->tmpDir),
+        osmium::osm_entity_bits::object,
         osmium::io::read_meta::no};
-    osmium::apply(relationReader, _relationHandler);
-    relationReader.close();
+    try {
+        osmium::apply(reader, _nodeHandler, _wayHandler, _relationHandler, _referencesHandler);
+        reader.close();
+    } catch (...) {
+        // The node handler already requests the previous locations of the modified nodes
+        _nodeHandler.waitForLocationRequests();
+        throw;
+    }
+    _stats->endTimeProcessingChangeFiles();
 
     if (_nodeHandler.empty() && _wayHandler.empty() && _relationHandler.empty()) {
         util::Logger::log(util::LogEvent::WARNING, "Change file is empty, no updates to process.");
+        _nodeHandler.waitForLocationRequests();
         return;
     }
 
-    _stats->endTimeProcessingChangeFiles();
-    util::Logger::log(util::LogEvent::INFO, "Fetching ways and relations to update geometry...");
+    // The remaining steps are stages of a dependency graph. Each stage declares the data it
+    // reads and the data it produces, and stages that do not depend on each other run at the
+    // same time.
+    util::StageGraph graph;
+    // The ids of the objects and the member lists from the change file
+    graph.addInput("changeFile");
+
+    // The osm2rdf options the triples in the database were generated with. Both the conversion
+    // and the delete operations depend on them, so they are only read after this stage.
+    graph.addStage("Fetching osm2rdf options", {}, {"osm2rdfOptions"}, [this] {
+        _osm2ttl.fetchOptions();
+    });
+
+    // Check for modified nodes if the location has changed.
+    // If so, the node is added to the _modifiedNodesWithChangedLocation set, otherwise to the
+    // _modifiedNodes set
+    graph.addStage("Checking node locations", {"changeFile"}, {"nodeChanges"}, [this] {
+        _stats->startTimeCheckingNodeLocations();
+        _nodeHandler.checkNodesForLocationChange();
+        _stats->endTimeCheckingNodeLocations();
+    });
+
     // Fetch the ids of all ways and relations that need to be updated, meaning they reference an
     // OSM object that changed their geometry because of elements in the change file.
-    _stats->startTimeFetchingObjectsToUpdateGeo();
-    getIdsOfWaysToUpdateGeo();
-    getIdsOfRelationsToUpdateGeo();
-    _stats->endTimeFetchingObjectsToUpdateGeo();
-
-    // Loop over the ways and relations a second time to store the ids of the referenced
-    // elements.
+    graph.addStage("Fetching ways to update geometry", {"nodeChanges"},
+                   {"waysToUpdateGeometry"}, [this] {
+        util::Logger::log(util::LogEvent::INFO,
+                          "Fetching ways and relations to update geometry...");
+        _stats->startTimeFetchingObjectsToUpdateGeo();
+        getIdsOfWaysToUpdateGeo();
+    });
+    graph.addStage("Fetching relations to update geometry",
+                   {"nodeChanges", "waysToUpdateGeometry"}, {"relationsToUpdateGeometry"}, [this] {
+        getIdsOfRelationsToUpdateGeo();
+        _stats->endTimeFetchingObjectsToUpdateGeo();
+    });
+
+    // Resolve the member lists that were recorded while reading the change file to the ids of the
+    // referenced elements.
     // We will need to retrieve them later from the endpoint (if they are not already
     // in the change file) for osm2rdf to calculate the geometries.
-    _stats->startTimeFetchingReferences();
-    util::Logger::log(util::LogEvent::INFO, "Reading and fetching references...");
-    osmium::io::Reader referencesReader{ cnst::getPathToChangeFile(_config->tmpDir),
-        osmium::osm_entity_bits::way | osmium::osm_entity_bits::relation,
-        osmium::io::read_meta::no};
-    osmium::apply(referencesReader, _referencesHandler);
-    referencesReader.close();
+    graph.addStage("Resolving references", {"changeFile", "nodeChanges"},
+                   {"referencedElements"}, [this] {
+        _stats->startTimeFetchingReferences();
+        util::Logger::log(util::LogEvent::INFO, "Resolving and fetching references...");
+        _referencesHandler.resolveReferences();
+    });
+
+    // Fetch the ids of all nodes that are referenced by ways which are not in the change file
+    std::set<id_t> waysWithFetchedNodes;
+    graph.addStage("Fetching nodes of referenced ways",
+                   {"referencedElements", "waysToUpdateGeometry"}, {"nodesOfWays"},
+                   [this, &waysWithFetchedNodes] {
+        waysWithFetchedNodes = _referencesHandler.getReferencedWays();
+        waysWithFetchedNodes.insert(_waysToUpdateGeometry.begin(), _waysToUpdateGeometry.end());
+        _referencesHandler.getReferencesForWays(waysWithFetchedNodes);
+    });
 
     // Fetch the ids of all nodes and ways that are referenced by relations which are not in the
     // change file.
-    std::set relationIds(_referencesHandler.getReferencedRelations());
-    relationIds.insert(_relationsToUpdateGeometry.begin(),
-                        _relationsToUpdateGeometry.end());
-    _referencesHandler.getReferencesForRelations(relationIds);
-
-    // Fetch the ids of all nodes that are referenced by ways which are not in the change file
-    std::set wayIds(_referencesHandler.getReferencedWays());
-    wayIds.insert(_waysToUpdateGeometry.begin(), _waysToUpdateGeometry.end());
-    _referencesHandler.getReferencesForWays(wayIds);
-    _stats->endTimeFetchingReferences();
+    graph.addStage("Fetching members of referenced relations",
+                   {"referencedElements", "relationsToUpdateGeometry"}, {"membersOfRelations"},
+                   [this] {
+        std::set relationIds(_referencesHandler.getReferencedRelations());
+        relationIds.insert(_relationsToUpdateGeometry.begin(), _relationsToUpdateGeometry.end());
+        _referencesHandler.getReferencesForRelations(relationIds);
+    });
+
+    // The members of the relations can contain ways whose nodes were not fetched yet
+    graph.addStage("Fetching nodes of ways referenced by relations",
+                   {"nodesOfWays", "membersOfRelations"}, {"referencedNodes"},
+                   [this, &waysWithFetchedNodes] {
+        std::set<id_t> wayIds;
+        std::ranges::set_difference(_referencesHandler.getReferencedWays(), waysWithFetchedNodes,
+                                    std::inserter(wayIds, wayIds.end()));
+        _referencesHandler.getReferencesForWays(wayIds);
+        _stats->endTimeFetchingReferences();
+    });
 
     // Create the dummy objects for the nodes, ways and relations that are referenced by
     // elements in the change file,
     // as well as the ways and relations for which the geometry needs to be updated.
-    _stats->startTimeCreatingDummyNodes();
-    util::Logger::log(util::LogEvent::INFO, "Creating objects for referenced nodes...");
-    createDummyNodes();
-    _stats->endTimeCreatingDummyNodes();
-
-    util::Logger::log(util::LogEvent::INFO, "Creating objects for referenced ways...");
-    _stats->startTimeCreatingDummyWays();
-    createDummyWays();
-    _stats->endTimeCreatingDummyWays();
-
-    util::Logger::log(util::LogEvent::INFO, "Creating objects for referenced relations...");
-    _stats->startTimeCreatingDummyRelations();
-    createDummyRelations();
-    _stats->endTimeCreatingDummyRelations();
-
-    util::Logger::log(util::LogEvent::INFO, "Merging and sorting dummy objects...");
-    _stats->startTimeMergingAndSortingDummyFiles();
-    mergeAndSortDummyFiles();
-    _stats->endTimeMergingAndSortingDummyFiles();
+    graph.addStage("Creating objects for referenced nodes", {"referencedNodes"},
+                   {"dummyNodes"}, [this] {
+        _stats->startTimeCreatingDummyNodes();
+        util::Logger::log(util::LogEvent::INFO, "Creating objects for referenced nodes...");
+        createDummyNodes();
+        _stats->endTimeCreatingDummyNodes();
+    });
+    graph.addStage("Creating objects for referenced ways",
+                   {"membersOfRelations", "waysToUpdateGeometry"}, {"dummyWays"}, [this] {
+        util::Logger::log(util::LogEvent::INFO, "Creating objects for referenced ways...");
+        _stats->startTimeCreatingDummyWays();
+        createDummyWays();
+        _stats->endTimeCreatingDummyWays();
+    });
+    graph.addStage("Creating objects for referenced relations",
+                   {"referencedElements", "relationsToUpdateGeometry"}, {"dummyRelations"},
+                   [this] {
+        util::Logger::log(util::LogEvent::INFO, "Creating objects for referenced relations...");
+        _stats->startTimeCreatingDummyRelations();
+        createDummyRelations();
+        _stats->endTimeCreatingDummyRelations();
+    });
+
+    graph.addStage("Merging and sorting dummy objects",
+                   {"dummyNodes", "dummyWays", "dummyRelations"}, {"osm2rdfInput"}, [this] {
+        util::Logger::log(util::LogEvent::INFO, "Merging and sorting dummy objects...");
+        _stats->startTimeMergingAndSortingDummyFiles();
+        mergeAndSortDummyFiles();
+        _stats->endTimeMergingAndSortingDummyFiles();
+    });
+
+    graph.addStage("Converting osm data to triples", {"osm2rdfInput", "osm2rdfOptions"},
+                   {"convertedTriples"}, [this] {
+        try {
+            util::Logger::log(util::LogEvent::INFO, "Converting osm data to triples...");
+            _osm2ttl.convert();
+        } catch (std::exception &e) {
+            util::Logger::log(util::LogEvent::ERROR, e.what());
+            throw OsmChangeHandlerException("Exception while trying to convert osm element to"
+                                            " ttl");
+        }
+    });
+
+    if (_config->interleaveUpdates) {
+        // The triples of each batch of objects are deleted and inserted in one update, so the
+        // updates can only be sent after the conversion
+        graph.addStage("Deleting and inserting triples", {"convertedTriples", "osm2rdfOptions"},
+                       {}, [this] {
+            deleteAndInsertTriples();
+        });
+    } else {
+        // The delete operations only depend on the ids of the elements, but the database must
+        // not change before all objects are fetched from it. The triples are deleted while
+        // osm2rdf converts the osm data.
+        graph.addStage("Deleting triples",
+                       {"nodeChanges", "waysToUpdateGeometry", "relationsToUpdateGeometry",
+                        "dummyNodes", "dummyWays", "dummyRelations", "osm2rdfOptions"},
+                       {"deletedTriples"}, [this] {
+            _stats->startTimeDeletingTriples();
+            deleteTriplesFromDatabase();
+            _stats->endTimeDeletingTriples();
+        });
 
-    try {
-        util::Logger::log(util::LogEvent::INFO, "Converting osm data to triples...");
-        _osm2ttl.convert();
-    } catch (std::exception &e) {
-        util::Logger::log(util::LogEvent::ERROR, e.what());
-        throw OsmChangeHandlerException("Exception while trying to convert osm element to"
-                                        " ttl");
+        graph.addStage("Filtering and inserting triples", {"convertedTriples", "deletedTriples"},
+                       {}, [this] {
+            _stats->startTimeInsertingTriples();
+            filterAndInsertRelevantTriples();
+            _stats->endTimeInsertingTriples();
+        });
     }
 
-    // Delete and insert elements from database
-    _stats->startTimeDeletingTriples();
-    deleteTriplesFromDatabase();
-    _stats->endTimeDeletingTriples();
-
-    util::Logger::log(util::LogEvent::INFO, "Filtering converted triples...");
-    _stats->startTimeFilteringTriples();
-    const auto triples = filterRelevantTriples();
-    _stats->endTimeFilteringTriples();
+    util::WorkStealingPool pool(MAX_CONCURRENT_STAGES);
+    try {
+        graph.run(pool);
+    } catch (...) {
+        // The node locations might not have been checked if an earlier stage failed
+        _nodeHandler.waitForLocationRequests();
+        throw;
+    }
+    _stats->setCriticalPath(graph.getCriticalPath());
 
-    _stats->startTimeInsertingTriples();
-    insertTriplesToDatabase(triples);
-    _stats->endTimeInsertingTriples();
+    countBatchSizes();
 }
 
 // _________________________________________________________________________________________________
@@ -213,12 +371,29 @@ void olu::osm::OsmChangeHandler::finalizeTmpFile(const std::string& filepath) {
 
 // _________________________________________________________________________________________________
 void olu::osm::OsmChangeHandler::getIdsOfWaysToUpdateGeo() {
-    if (!_nodeHandler.getModifiedNodesWithChangedLocation().empty()) {
-        util::BatchHelper::doInBatches(
+    if (_nodeHandler.getModifiedNodesWithChangedLocation().empty()) {
+        return;
+    }
+
+    if (_wayNodeIndex != nullptr && _wayNodeIndex->isBuilt()) {
+        const auto &nodeIds = _nodeHandler.getModifiedNodesWithChangedLocation();
+        for (const auto &wayId: _wayNodeIndex->getWaysReferencingNodes(nodeIds)) {
+            if (!_wayHandler.wayInChangeFile(wayId)) {
+                _waysToUpdateGeometry.insert(wayId);
+                _stats->countWayToUpdateGeometry();
+            }
+        }
+        _stats->countWayNodeIndexLookups(nodeIds.size());
+    } else {
+        util::BatchHelper::doInBatchesConcurrently(
             _nodeHandler.getModifiedNodesWithChangedLocation(),
-            _config->batchSize,
-            [this](const std::set<id_t> &batch) {
-                for (const auto &wayId: _odf->fetchWaysReferencingNodes(batch)) {
+            _batchSizes.referencingElements,
+            _config->maxConcurrentRequests,
+            [this](const std::set<id_t> &batch, size_t) {
+                return _odf->fetchWaysReferencingNodes(batch);
+            },
+            [this](const std::vector<id_t> &wayIds, size_t) {
+                for (const auto &wayId: wayIds) {
                     if (!_wayHandler.wayInChangeFile(wayId)) {
                         _waysToUpdateGeometry.insert(wayId);
                         _stats->countWayToUpdateGeometry();
@@ -230,18 +405,32 @@ void olu::osm::OsmChangeHandler::getIdsOfWaysToUpdateGeo() {
 
 // _________________________________________________________________________________________________
 void olu::osm::OsmChangeHandler::getIdsOfRelationsToUpdateGeo() {
+    const auto addRelationToUpdateGeometry = [this](const id_t &relId) {
+        if (!_relationHandler.relationInChangeFile(relId) &&
+            !_relationsToUpdateGeometry.contains(relId)) {
+            _relationsToUpdateGeometry.insert(relId);
+            _stats->countRelationToUpdateGeometry();
+        }
+    };
+    const bool useIndex = _relationMemberIndex != nullptr && _relationMemberIndex->isBuilt();
+
     // Get ids of relations that reference a modified node
-    if (!_nodeHandler.getModifiedNodesWithChangedLocation().empty()) {
-        util::BatchHelper::doInBatches(
-            _nodeHandler.getModifiedNodesWithChangedLocation(),
-            _config->batchSize,
-            [this](const std::set<id_t>& batch) {
-                for (const auto &relId: _odf->fetchRelationsReferencingNodes(batch)) {
-                    if (!_relationHandler.relationInChangeFile(relId)) {
-                        _relationsToUpdateGeometry.insert(relId);
-                        _stats->countRelationToUpdateGeometry();
-                    }
-                }
+    const auto movedNodes = _nodeHandler.getModifiedNodesWithChangedLocation();
+    if (!movedNodes.empty() && useIndex) {
+        for (const auto &relId: _relationMemberIndex->getRelationsReferencing(
+                 OsmObjectType::NODE, movedNodes)) {
+            addRelationToUpdateGeometry(relId);
+        }
+    } else if (!movedNodes.empty()) {
+        util::BatchHelper::doInBatchesConcurrently(
+            movedNodes,
+            _batchSizes.referencingElements,
+            _config->maxConcurrentRequests,
+            [this](const std::set<id_t>& batch, size_t) {
+                return _odf->fetchRelationsReferencingNodes(batch);
+            },
+            [&addRelationToUpdateGeometry](const std::vector<id_t> &relIds, size_t) {
+                std::ranges::for_each(relIds, addRelationToUpdateGeometry);
             });
     }
 
@@ -252,18 +441,21 @@ void olu::osm::OsmChangeHandler::getIdsOfRelationsToUpdateGeo() {
     }
     updatedWays.insert(_waysToUpdateGeometry.begin(), _waysToUpdateGeometry.end());
 
-    if (!updatedWays.empty()) {
-        util::BatchHelper::doInBatches(
+    if (!updatedWays.empty() && useIndex) {
+        for (const auto &relId: _relationMemberIndex->getRelationsReferencing(
+                 OsmObjectType::WAY, updatedWays)) {
+            addRelationToUpdateGeometry(relId);
+        }
+    } else if (!updatedWays.empty()) {
+        util::BatchHelper::doInBatchesConcurrently(
             updatedWays,
-            _config->batchSize,
-            [this](const std::set<id_t>& batch) {
-                for (const auto &relId: _odf->fetchRelationsReferencingWays(batch)) {
-                    if (!_relationHandler.relationInChangeFile(relId) &&
-                        !_relationsToUpdateGeometry.contains(relId)) {
-                        _relationsToUpdateGeometry.insert(relId);
-                        _stats->countRelationToUpdateGeometry();
-                    }
-                }
+            _batchSizes.referencingElements,
+            _config->maxConcurrentRequests,
+            [this](const std::set<id_t>& batch, size_t) {
+                return _odf->fetchRelationsReferencingWays(batch);
+            },
+            [&addRelationToUpdateGeometry](const std::vector<id_t> &relIds, size_t) {
+                std::ranges::for_each(relIds, addRelationToUpdateGeometry);
             });
     }
 
@@ -285,37 +477,60 @@ void olu::osm::OsmChangeHandler::getIdsOfRelationsToUpdateGeo() {
 //        }
 }
 
-// _________________________________________________________________________________________________
-void olu::osm::OsmChangeHandler::getReferencedRelations() {
-    if (!_relationsToUpdateGeometry.empty()) {
-        util::BatchHelper::doInBatches(
-                _relationsToUpdateGeometry,
-            _config->batchSize,
-            [this](const std::set<id_t>& batch) {
-                for (const auto &relId: _odf->fetchRelationsReferencingRelations(batch)) {
-                    if (!_relationsToUpdateGeometry.contains(relId) &&
-                        !_relationHandler.getCreatedRelations().contains(relId) &&
-                        !_relationHandler.getModifiedAreas().contains(relId)) {
-                        _referencesHandler.getReferencedRelations().insert(relId);
-                    }
-                }
-            });
-    }
-}
-
 // _________________________________________________________________________________________________
 void olu::osm::OsmChangeHandler::createDummyNodes() {
-    _stats->setNodeReferenceCount(_referencesHandler.getReferencedNodes().size());
+    const auto nodeIds = _referencesHandler.getReferencedNodes();
+    _stats->setNodeReferenceCount(nodeIds.size());
 
-    util::BatchHelper::doInBatchesWithProgressBar(
-        _referencesHandler.getReferencedNodes(),
+    struct NodeBatchResult {
+        size_t numOfNodes = 0;
+        size_t indexHits = 0;
+        size_t indexMisses = 0;
+    };
+
+    osm2rdf::util::ProgressBar progress(nodeIds.size(), _config->showProgress &&
+                                        !_config->showDetailedStatistics);
+    size_t counter = 0;
+    progress.update(counter);
+
+    // Each batch is written to its own file, so the batches can be fetched at the same time
+    std::atomic<size_t> fileIndex = 0;
+    util::BatchHelper::doInBatchesConcurrently(
+        nodeIds,
         _config->batchSize,
-        [this](std::set<id_t> const& batch, int const &batchNumber) {
-            const auto filePath = getPathToTempFile(OsmObjectType::NODE, batchNumber);
+        _config->maxConcurrentRequests,
+        [this, &fileIndex](const std::set<id_t> &batch, size_t) {
+            const auto filePath = getPathToTempFile(OsmObjectType::NODE, fileIndex++);
             initTmpFile(filePath);
-            _odf->fetchAndWriteNodesToFile(filePath, batch);
+
+            NodeBatchResult result{batch.size()};
+            std::set<id_t> nodesToFetch = batch;
+            if (_nodeLocationIndex != nullptr) {
+                std::vector<Node> indexedNodes;
+                nodesToFetch = _nodeLocationIndex->lookup(batch, indexedNodes);
+                result.indexHits = indexedNodes.size();
+                result.indexMisses = nodesToFetch.size();
+
+                std::ofstream file(filePath, std::ios::app);
+                for (const auto &node: indexedNodes) {
+                    file << node.getXml() << std::endl;
+                }
+                file.close();
+            }
+
+            if (!nodesToFetch.empty()) {
+                _odf->fetchAndWriteNodesToFile(filePath, nodesToFetch);
+            }
             finalizeTmpFile(filePath);
+            return result;
+        },
+        [this, &progress, &counter](const NodeBatchResult &result, size_t) {
+            if (_nodeLocationIndex != nullptr) {
+                _stats->countNodeLocationIndexLookups(result.indexHits, result.indexMisses);
+            }
+            progress.update(counter += result.numOfNodes);
         });
+    progress.done();
 }
 
 // _________________________________________________________________________________________________
@@ -326,16 +541,34 @@ void olu::osm::OsmChangeHandler::createDummyWays() {
     }
     wayIds.insert(_waysToUpdateGeometry.begin(), _waysToUpdateGeometry.end());
 
+    struct WayBatchResult {
+        size_t numOfWays = 0;
+        size_t count = 0;
+    };
+
+    osm2rdf::util::ProgressBar progress(wayIds.size(), _config->showProgress &&
+                                        !_config->showDetailedStatistics);
+    size_t counter = 0;
+    progress.update(counter);
+
     size_t countWayReferences = 0;
-    util::BatchHelper::doInBatchesWithProgressBar(
+    std::atomic<size_t> fileIndex = 0;
+    util::BatchHelper::doInBatchesConcurrently(
         wayIds,
         _config->batchSize,
-        [this, &countWayReferences](std::set<id_t> const& batch, int const &batchNumber) mutable {
-            const auto filePath = getPathToTempFile(OsmObjectType::WAY, batchNumber);
+        _config->maxConcurrentRequests,
+        [this, &fileIndex](const std::set<id_t> &batch, size_t) {
+            const auto filePath = getPathToTempFile(OsmObjectType::WAY, fileIndex++);
             initTmpFile(filePath);
-            countWayReferences += _odf->fetchAndWriteWaysToFile(filePath, batch);
+            const size_t count = _odf->fetchAndWriteWaysToFile(filePath, batch);
             finalizeTmpFile(filePath);
+            return WayBatchResult{batch.size(), count};
+        },
+        [&countWayReferences, &progress, &counter](const WayBatchResult &result, size_t) {
+            countWayReferences += result.count;
+            progress.update(counter += result.numOfWays);
         });
+    progress.done();
 
     // We need to save the number of created way references here, because some of the referenced
     // ways might not be on the SPARQL endpoint.
@@ -351,16 +584,60 @@ void olu::osm::OsmChangeHandler::createDummyRelations() {
     }
     relations.insert(_relationsToUpdateGeometry.begin(), _relationsToUpdateGeometry.end());
 
+    struct RelationBatchResult {
+        size_t numOfRelations = 0;
+        size_t count = 0;
+        size_t indexHits = 0;
+        size_t indexMisses = 0;
+    };
+
+    osm2rdf::util::ProgressBar progress(relations.size(), _config->showProgress &&
+                                        !_config->showDetailedStatistics);
+    size_t counter = 0;
+    progress.update(counter);
+
     size_t countRelationReferences = 0;
-    util::BatchHelper::doInBatchesWithProgressBar(
+    const bool useIndex = _relationMemberIndex != nullptr && _relationMemberIndex->isBuilt();
+    std::atomic<size_t> fileIndex = 0;
+    util::BatchHelper::doInBatchesConcurrently(
         relations,
         _config->batchSize,
-        [this, &countRelationReferences](std::set<id_t> const& batch, int const &batchNumber) mutable {
-            const auto filePath = getPathToTempFile(OsmObjectType::RELATION, batchNumber);
+        _config->maxConcurrentRequests,
+        [this, useIndex, &fileIndex](const std::set<id_t> &batch, size_t) {
+            const auto filePath = getPathToTempFile(OsmObjectType::RELATION, fileIndex++);
             initTmpFile(filePath);
-            countRelationReferences += _odf->fetchAndWriteRelationsToFile(filePath, batch);
+
+            RelationBatchResult result{batch.size()};
+            std::set<id_t> relationsToFetch = batch;
+            if (useIndex) {
+                std::vector<Relation> indexedRelations;
+                relationsToFetch = _relationMemberIndex->lookup(batch, indexedRelations);
+                result.indexHits = indexedRelations.size();
+                result.indexMisses = relationsToFetch.size();
+
+                std::ofstream file(filePath, std::ios::app);
+                for (const auto &relation: indexedRelations) {
+                    file << relation.getXml() << std::endl;
+                }
+                file.close();
+                result.count += indexedRelations.size();
+            }
+
+            if (!relationsToFetch.empty()) {
+                result.count += _odf->fetchAndWriteRelationsToFile(filePath, relationsToFetch);
+            }
             finalizeTmpFile(filePath);
+            return result;
+        },
+        [this, useIndex, &countRelationReferences, &progress, &counter](
+            const RelationBatchResult &result, size_t) {
+            countRelationReferences += result.count;
+            if (useIndex) {
+                _stats->countRelationMemberIndexLookups(result.indexHits, result.indexMisses);
+            }
+            progress.update(counter += result.numOfRelations);
         });
+    progress.done();
 
     // We need to save the number of created relation references here,
     // because some of the referenced relations might not be on the SPARQL endpoint.
@@ -381,40 +658,58 @@ void olu::osm::OsmChangeHandler::mergeAndSortDummyFiles() const {
 
     OsmFileHelper::mergeAndSortFiles(inputs, cnst::getPathToOsm2rdfInputFile(_config->tmpDir),
                                      osmium::object_order_type_id_version(),
-                                     inputs.size() > 1);
+                                     inputs.size() > 1, _config->mergeMemoryLimit,
+                                     cnst::getPathToMergeRunDir(_config->tmpDir));
 }
 
 // _________________________________________________________________________________________________
 void olu::osm::OsmChangeHandler::runUpdateQuery(const sparql::UpdateOperation & updateOp,
                                                 const std::string &query,
-                                                const std::vector<std::string> &prefixes) {
-    switch (updateOp) {
-        case sparql::UpdateOperation::INSERT:
-            _stats->countInsertOp();
-            break;
-        case sparql::UpdateOperation::DELETE:
-            _stats->countDeleteOp();
-            break;
-    }
+                                                const std::vector<std::string> &prefixes,
+                                                const size_t worker) {
+    auto &sparql = worker == 0 ? _sparql : _updateWorkers.at(worker - 1)->sparql;
+    auto &update = worker == 0 ? _update : _updateWorkers.at(worker - 1)->update;
+    sparql.setQuery(query);
+    sparql.setPrefixes(prefixes);
+    sparql.prepareUpdate(updateOp, update);
+    runPreparedUpdate(update);
+}
 
-    _sparql.setQuery(query);
-    _sparql.setPrefixes(prefixes);
+// _________________________________________________________________________________________________
+void olu::osm::OsmChangeHandler::runPreparedUpdate(const sparql::PreparedUpdate &update) {
+    {
+        std::lock_guard lock(_updateMutex);
+        switch (update.updateOp) {
+            case sparql::UpdateOperation::INSERT:
+                _stats->countInsertOp();
+                break;
+            case sparql::UpdateOperation::DELETE:
+                _stats->countDeleteOp();
+                break;
+            case sparql::UpdateOperation::DELETE_AND_INSERT:
+                _stats->countDeleteAndInsertOp();
+                break;
+        }
+        _stats->countUpdateCompression(update.compression, update.updateOp);
+    }
 
     std::string response;
     try {
-        response = _sparql.runUpdate(updateOp);
+        response = _sparql.runUpdate(update);
+    } catch (const util::BatchTooLargeException &) {
+        // Passed on unchanged, so that the batch can be split and sent again
+        throw;
     } catch (std::exception &e) {
         util::Logger::log(util::LogEvent::ERROR, e.what());
         const std::string msg = "Exception while trying to run sparql update query: "
-                                + query.substr(0, std::min<int>(query.size(), 100))
+                                + update.body.substr(0, 100)
                                 + " ...";
         throw OsmChangeHandlerException(msg.c_str());
     }
 
+    std::lock_guard lock(_updateMutex);
     if (_config->sparqlOutput == config::SparqlOutput::ENDPOINT && _config->isQLever) {
-        // Update responses are in "[]" so remove them before parsing
-        response = response.substr(1, response.size() - 2);
-        _stats->logQLeverUpdateInfo(response, updateOp);
+        _stats->logQLeverUpdateResponse(response, update.updateOp);
     }
 
     // Write SPARQL response to a file, if configured by the user
@@ -430,36 +725,32 @@ void olu::osm::OsmChangeHandler::runUpdateQuery(const sparql::UpdateOperation &
 }
 
 // _________________________________________________________________________________________________
-void olu::osm::OsmChangeHandler::deleteNodesFromDatabase(osm2rdf::util::ProgressBar &progress,
-                                                         size_t &counter) {
-    util::BatchHelper::doInBatches(
-        _nodeHandler.getAllNodes(),
-        _config->batchSize,
-        [this, progress, &counter](std::set<id_t> const &batch) mutable {
-            // First, delete the triple that are linked to the osm node (geometry and centroid)
-            // via a node
-            runUpdateQuery(sparql::UpdateOperation::DELETE,
-                           _queryWriter.writeDeleteOsmObjectGeometryQuery(OsmObjectType::NODE, batch),
-                           cnst::PREFIXES_FOR_NODE_DELETE_QUERY);
-
-            // Delete 'geo:hasCentroid' triples only if the option is activated
-            if (_osm2ttl.hasTripleForOption(osm2rdf::config::constants::ADD_CENTROID_OPTION_LONG)) {
-                runUpdateQuery(sparql::UpdateOperation::DELETE,
-                    _queryWriter.writeDeleteOsmObjectCentroidQuery(OsmObjectType::NODE, batch),
-                    cnst::PREFIXES_FOR_NODE_DELETE_QUERY);
-            }
+size_t olu::osm::OsmChangeHandler::getMaxConcurrentUpdates() const {
+    return _config->sparqlOutput == config::SparqlOutput::ENDPOINT
+               ? _config->maxConcurrentRequests
+               : 1;
+}
 
-            // Then delete the all triples for the nodes
-            runUpdateQuery(sparql::UpdateOperation::DELETE,
-                           _queryWriter.writeDeleteOsmObjectQuery(OsmObjectType::NODE, batch),
-                           cnst::PREFIXES_FOR_NODE_DELETE_QUERY);
-            progress.update(counter += batch.size());
+// _________________________________________________________________________________________________
+void olu::osm::OsmChangeHandler::deleteInBatches(
+    const std::set<id_t> &ids,
+    const std::function<void(const std::set<id_t> &, size_t)> &deleteBatch,
+    osm2rdf::util::ProgressBar &progress, size_t &counter) {
+    util::BatchHelper::doInBatchesConcurrently(
+        ids,
+        _batchSizes.deletes,
+        getMaxConcurrentUpdates(),
+        [&deleteBatch](const std::set<id_t> &batch, const size_t worker) {
+            deleteBatch(batch, worker);
+            return batch.size();
+        },
+        [&progress, &counter](const size_t batchSize, size_t) {
+            progress.update(counter += batchSize);
         });
 }
 
 // _________________________________________________________________________________________________
-void olu::osm::OsmChangeHandler::deleteWaysFromDatabase(osm2rdf::util::ProgressBar &progress,
-                                                        size_t &counter) {
+std::set<olu::id_t> olu::osm::OsmChangeHandler::getIdsOfWaysToDelete() const {
     std::set<id_t> waysToDelete;
     for (const auto &wayId: _wayHandler.getDeletedWays()) {
         waysToDelete.insert(wayId);
@@ -470,175 +761,243 @@ void olu::osm::OsmChangeHandler::deleteWaysFromDatabase(osm2rdf::util::ProgressB
     for (const auto &wayId: _wayHandler.getCreatedWays()) {
         waysToDelete.insert(wayId);
     }
+    return waysToDelete;
+}
 
-    util::BatchHelper::doInBatches(
-        waysToDelete,
-        _config->batchSize,
-        [this, &counter, progress](std::set<id_t> const &batch) mutable {
-            // First, triples that are linked to the osm way (members, geometry and centroid)
-            if (_osm2ttl.hasTripleForOption(osm2rdfCnst::NO_MEMBER_TRIPLES_OPTION_LONG, "false")) {
-                runUpdateQuery(sparql::UpdateOperation::DELETE,
-                    _queryWriter.writeDeleteWayMemberQuery(batch),
-                    cnst::PREFIXES_FOR_WAY_DELETE_QUERY);
-            }
+// _________________________________________________________________________________________________
+std::set<olu::id_t> olu::osm::OsmChangeHandler::getIdsOfRelationsToDelete() const {
+    std::set<id_t> relationsToDelete;
+    for (const auto &relationId: _relationHandler.getDeletedRelations()) {
+        relationsToDelete.insert(relationId);
+    }
+    for (const auto &relationId: _relationHandler.getModifiedRelations()) {
+        relationsToDelete.insert(relationId);
+    }
+    for (const auto &relationId: _relationHandler.getCreatedRelations()) {
+        relationsToDelete.insert(relationId);
+    }
+    return relationsToDelete;
+}
 
-            if (_osm2ttl.hasTripleForOption(osm2rdfCnst::ADD_CENTROID_OPTION_LONG)) {
-                runUpdateQuery(sparql::UpdateOperation::DELETE,
-                    _queryWriter.writeDeleteOsmObjectCentroidQuery(OsmObjectType::WAY, batch),
-                    cnst::PREFIXES_FOR_WAY_DELETE_QUERY);
-            }
+// _________________________________________________________________________________________________
+std::vector<std::string>
+olu::osm::OsmChangeHandler::getDeleteOperationsForNodes(const std::set<id_t> &nodeIds) const {
+    if (nodeIds.empty()) {
+        return {};
+    }
 
-            runUpdateQuery(sparql::UpdateOperation::DELETE,
-                _queryWriter.writeDeleteOsmObjectGeometryQuery(OsmObjectType::WAY, batch),
-                cnst::PREFIXES_FOR_WAY_DELETE_GEOMETRY_QUERY);
+    // First, delete the triple that are linked to the osm node (geometry and centroid) via a node
+    std::vector operations{
+        _queryWriter.writeDeleteOsmObjectGeometryQuery(OsmObjectType::NODE, nodeIds)};
 
-            // Then delete the all triples where the way is the subject
-            runUpdateQuery(sparql::UpdateOperation::DELETE,
-                           _queryWriter.writeDeleteOsmObjectQuery(OsmObjectType::WAY, batch),
-                           cnst::PREFIXES_FOR_WAY_DELETE_QUERY);
-            progress.update(counter += batch.size());
-        });
+    // Delete 'geo:hasCentroid' triples only if the option is activated
+    if (_osm2ttl.hasTripleForOption(osm2rdf::config::constants::ADD_CENTROID_OPTION_LONG)) {
+        operations.push_back(
+            _queryWriter.writeDeleteOsmObjectCentroidQuery(OsmObjectType::NODE, nodeIds));
+    }
+
+    // Then delete the all triples for the nodes
+    operations.push_back(_queryWriter.writeDeleteOsmObjectQuery(OsmObjectType::NODE, nodeIds));
+    return operations;
 }
 
-// ____________________________________________________________________________________________
+// _________________________________________________________________________________________________
+std::vector<std::string>
+olu::osm::OsmChangeHandler::getDeleteOperationsForWays(const std::set<id_t> &wayIds) const {
+    if (wayIds.empty()) {
+        return {};
+    }
 
-void olu::osm::OsmChangeHandler::deleteWaysGeometry(osm2rdf::util::ProgressBar &progress,
-                                                    size_t &counter) {
-    util::BatchHelper::doInBatches(
-        _waysToUpdateGeometry,
-        _config->batchSize,
-        [this, &counter, progress](std::set<id_t> const &batch) mutable {
-            runUpdateQuery(sparql::UpdateOperation::DELETE,
-                _queryWriter.writeDeleteOsmObjectGeometryQuery(OsmObjectType::WAY, batch),
-                cnst::PREFIXES_FOR_WAY_DELETE_GEOMETRY_QUERY);
-
-            // In principle, we would only have to delete either the length or the area,
-            // depending on whether the way covers an area.
-            // However, this information is not available here;
-            // it would have to be read from the change file
-            // (e.g., fetched from the SPARQL endpoint).
-            runUpdateQuery(sparql::UpdateOperation::DELETE,
-                           _queryWriter.writeDeleteOsmObjectLengthQuery(OsmObjectType::WAY, batch),
-                           cnst::PREFIXES_FOR_WAY_DELETE_GEOMETRY_QUERY);
+    // First, triples that are linked to the osm way (members, geometry and centroid)
+    std::vector<std::string> operations;
+    if (_osm2ttl.hasTripleForOption(osm2rdfCnst::NO_MEMBER_TRIPLES_OPTION_LONG, "false")) {
+        operations.push_back(_queryWriter.writeDeleteWayMemberQuery(wayIds));
+    }
 
-            runUpdateQuery(sparql::UpdateOperation::DELETE,
-                           _queryWriter.writeDeleteOsmObjectAreaQuery(OsmObjectType::WAY, batch),
-                           cnst::PREFIXES_FOR_WAY_DELETE_GEOMETRY_QUERY);
+    if (_osm2ttl.hasTripleForOption(osm2rdfCnst::ADD_CENTROID_OPTION_LONG)) {
+        operations.push_back(
+            _queryWriter.writeDeleteOsmObjectCentroidQuery(OsmObjectType::WAY, wayIds));
+    }
 
+    operations.push_back(
+        _queryWriter.writeDeleteOsmObjectGeometryQuery(OsmObjectType::WAY, wayIds));
 
-            if (_osm2ttl.hasTripleForOption(osm2rdfCnst::ADD_CENTROID_OPTION_LONG)) {
-                runUpdateQuery(sparql::UpdateOperation::DELETE,
-                    _queryWriter.writeDeleteOsmObjectCentroidQuery(OsmObjectType::WAY, batch),
-                    cnst::PREFIXES_FOR_WAY_DELETE_QUERY);
-            }
+    // Then delete the all triples where the way is the subject
+    operations.push_back(_queryWriter.writeDeleteOsmObjectQuery(OsmObjectType::WAY, wayIds));
+    return operations;
+}
 
-            if(_osm2ttl.hasTripleForOption(osm2rdfCnst::ADD_OBB_OPTION_LONG)) {
-                runUpdateQuery(sparql::UpdateOperation::DELETE,
-                    _queryWriter.writeDeleteOsmObjectOBBQuery(OsmObjectType::WAY, batch),
-                    cnst::PREFIXES_FOR_WAY_DELETE_GEOMETRY_QUERY);
-            }
+// _________________________________________________________________________________________________
+std::vector<std::string>
+olu::osm::OsmChangeHandler::getDeleteOperationsForWaysGeometry(
+    const std::set<id_t> &wayIds) const {
+    if (wayIds.empty()) {
+        return {};
+    }
 
-            if(_osm2ttl.hasTripleForOption(osm2rdfCnst::ADD_ENVELOPE_OPTION_LONG)) {
-                runUpdateQuery(sparql::UpdateOperation::DELETE,
-                    _queryWriter.writeDeleteOsmObjectEnvelopeQuery(OsmObjectType::WAY, batch),
-                    cnst::PREFIXES_FOR_WAY_DELETE_GEOMETRY_QUERY);
-            }
+    std::vector operations{
+        _queryWriter.writeDeleteOsmObjectGeometryQuery(OsmObjectType::WAY, wayIds)};
 
-            if(_osm2ttl.hasTripleForOption(osm2rdfCnst::ADD_CONVEX_HULL_OPTION_LONG)) {
-                runUpdateQuery(sparql::UpdateOperation::DELETE,
-                    _queryWriter.writeDeleteOsmObjectConvexHullQuery(OsmObjectType::WAY, batch),
-                    cnst::PREFIXES_FOR_WAY_DELETE_GEOMETRY_QUERY);
-            }
+    // In principle, we would only have to delete either the length or the area,
+    // depending on whether the way covers an area.
+    // However, this information is not available here;
+    // it would have to be read from the change file
+    // (e.g., fetched from the SPARQL endpoint).
+    operations.push_back(_queryWriter.writeDeleteOsmObjectLengthQuery(OsmObjectType::WAY, wayIds));
+    operations.push_back(_queryWriter.writeDeleteOsmObjectAreaQuery(OsmObjectType::WAY, wayIds));
 
-            progress.update(counter += batch.size());
-        });
+    if (_osm2ttl.hasTripleForOption(osm2rdfCnst::ADD_CENTROID_OPTION_LONG)) {
+        operations.push_back(
+            _queryWriter.writeDeleteOsmObjectCentroidQuery(OsmObjectType::WAY, wayIds));
+    }
+
+    if(_osm2ttl.hasTripleForOption(osm2rdfCnst::ADD_OBB_OPTION_LONG)) {
+        operations.push_back(_queryWriter.writeDeleteOsmObjectOBBQuery(OsmObjectType::WAY, wayIds));
+    }
+
+    if(_osm2ttl.hasTripleForOption(osm2rdfCnst::ADD_ENVELOPE_OPTION_LONG)) {
+        operations.push_back(
+            _queryWriter.writeDeleteOsmObjectEnvelopeQuery(OsmObjectType::WAY, wayIds));
+    }
+
+    if(_osm2ttl.hasTripleForOption(osm2rdfCnst::ADD_CONVEX_HULL_OPTION_LONG)) {
+        operations.push_back(
+            _queryWriter.writeDeleteOsmObjectConvexHullQuery(OsmObjectType::WAY, wayIds));
+    }
+    return operations;
 }
 
 // _________________________________________________________________________________________________
-void olu::osm::OsmChangeHandler::deleteRelationsFromDatabase(osm2rdf::util::ProgressBar &progress,
-                                                             size_t &counter) {
-    std::set<id_t> relationsToDelete;
-    for (const auto &relationId: _relationHandler.getDeletedRelations()) {
-        relationsToDelete.insert(relationId);
+std::vector<std::string>
+olu::osm::OsmChangeHandler::getDeleteOperationsForRelations(
+    const std::set<id_t> &relationIds) const {
+    if (relationIds.empty()) {
+        return {};
     }
-    for (const auto &relationId: _relationHandler.getModifiedRelations()) {
-        relationsToDelete.insert(relationId);
+
+    // First, triples that are linked to the osm relation (members, geometry and centroid)
+    std::vector<std::string> operations;
+    if (_osm2ttl.hasTripleForOption(osm2rdfCnst::NO_MEMBER_TRIPLES_OPTION_LONG, "false")) {
+        operations.push_back(_queryWriter.writeDeleteRelMemberQuery(relationIds));
     }
-    for (const auto &relationId: _relationHandler.getCreatedRelations()) {
-        relationsToDelete.insert(relationId);
+
+    if (_osm2ttl.hasTripleForOption(osm2rdfCnst::ADD_CENTROID_OPTION_LONG)) {
+        operations.push_back(
+            _queryWriter.writeDeleteOsmObjectCentroidQuery(OsmObjectType::RELATION, relationIds));
     }
 
-    util::BatchHelper::doInBatches(
-        relationsToDelete,
-        _config->batchSize,
-        [this, &counter, progress](std::set<id_t> const &batch) mutable {
-            // First, triples that are linked to the osm way (members, geometry and centroid)
-            if (_osm2ttl.hasTripleForOption(osm2rdfCnst::NO_MEMBER_TRIPLES_OPTION_LONG, "false")) {
-                runUpdateQuery(sparql::UpdateOperation::DELETE,
-                               _queryWriter.writeDeleteRelMemberQuery(batch),
-                               cnst::PREFIXES_FOR_RELATION_DELETE_QUERY);
-            }
+    operations.push_back(
+        _queryWriter.writeDeleteOsmObjectGeometryQuery(OsmObjectType::RELATION, relationIds));
 
-            if (_osm2ttl.hasTripleForOption(osm2rdfCnst::ADD_CENTROID_OPTION_LONG)) {
-                runUpdateQuery(sparql::UpdateOperation::DELETE,
-                    _queryWriter.writeDeleteOsmObjectCentroidQuery(OsmObjectType::RELATION, batch),
-                    cnst::PREFIXES_FOR_RELATION_DELETE_GEOMETRY_QUERY);
-            }
+    // Then delete the all triples where the relation is the subject
+    operations.push_back(
+        _queryWriter.writeDeleteOsmObjectQuery(OsmObjectType::RELATION, relationIds));
+    return operations;
+}
 
-            runUpdateQuery(sparql::UpdateOperation::DELETE,
-                _queryWriter.writeDeleteOsmObjectGeometryQuery(OsmObjectType::RELATION, batch),
-                cnst::PREFIXES_FOR_RELATION_DELETE_GEOMETRY_QUERY);
+// _________________________________________________________________________________________________
+std::vector<std::string>
+olu::osm::OsmChangeHandler::getDeleteOperationsForRelationsGeometry(
+    const std::set<id_t> &relationIds) const {
+    if (relationIds.empty()) {
+        return {};
+    }
 
-            // Then delete the all triples where the relation is the subject
-            runUpdateQuery(sparql::UpdateOperation::DELETE,
-                           _queryWriter.writeDeleteOsmObjectQuery(OsmObjectType::RELATION, batch),
-                           cnst::PREFIXES_FOR_RELATION_DELETE_QUERY);
+    std::vector operations{
+        _queryWriter.writeDeleteOsmObjectGeometryQuery(OsmObjectType::RELATION, relationIds),
+        _queryWriter.writeDeleteOsmObjectAreaQuery(OsmObjectType::RELATION, relationIds)};
 
-            progress.update(counter += batch.size());
-        });
+    if (_osm2ttl.hasTripleForOption(osm2rdfCnst::ADD_CENTROID_OPTION_LONG)) {
+        operations.push_back(
+            _queryWriter.writeDeleteOsmObjectCentroidQuery(OsmObjectType::RELATION, relationIds));
+    }
+
+    if(_osm2ttl.hasTripleForOption(osm2rdfCnst::ADD_OBB_OPTION_LONG)) {
+        operations.push_back(
+            _queryWriter.writeDeleteOsmObjectOBBQuery(OsmObjectType::RELATION, relationIds));
+    }
+
+    if(_osm2ttl.hasTripleForOption(osm2rdfCnst::ADD_ENVELOPE_OPTION_LONG)) {
+        operations.push_back(
+            _queryWriter.writeDeleteOsmObjectEnvelopeQuery(OsmObjectType::RELATION, relationIds));
+    }
+
+    if(_osm2ttl.hasTripleForOption(osm2rdfCnst::ADD_CONVEX_HULL_OPTION_LONG)) {
+        operations.push_back(_queryWriter.writeDeleteOsmObjectConvexHullQuery(
+            OsmObjectType::RELATION, relationIds));
+    }
+    return operations;
 }
 
 // _________________________________________________________________________________________________
-void olu::osm::OsmChangeHandler::deleteRelationsGeometry(osm2rdf::util::ProgressBar &progress,
+void olu::osm::OsmChangeHandler::deleteNodesFromDatabase(osm2rdf::util::ProgressBar &progress,
                                                          size_t &counter) {
-    util::BatchHelper::doInBatches(
-        _relationsToUpdateGeometry,
-        _config->batchSize,
-        [this, &counter, progress](std::set<id_t> const &batch) mutable {
+    deleteInBatches(
+        _nodeHandler.getAllNodes(),
+        [this](std::set<id_t> const &batch, const size_t worker) {
             runUpdateQuery(sparql::UpdateOperation::DELETE,
-                _queryWriter.writeDeleteOsmObjectGeometryQuery(OsmObjectType::RELATION, batch),
-                cnst::PREFIXES_FOR_RELATION_DELETE_GEOMETRY_QUERY);
+                           sparql::QueryWriter::writeUpdateSequence(
+                               getDeleteOperationsForNodes(batch)),
+                           cnst::PREFIXES_FOR_NODE_DELETE_QUERY, worker);
+        },
+        progress, counter);
+}
 
+// _________________________________________________________________________________________________
+void olu::osm::OsmChangeHandler::deleteWaysFromDatabase(osm2rdf::util::ProgressBar &progress,
+                                                        size_t &counter) {
+    deleteInBatches(
+        getIdsOfWaysToDelete(),
+        [this](std::set<id_t> const &batch, const size_t worker) {
             runUpdateQuery(sparql::UpdateOperation::DELETE,
-               _queryWriter.writeDeleteOsmObjectAreaQuery(OsmObjectType::RELATION, batch),
-               cnst::PREFIXES_FOR_RELATION_DELETE_GEOMETRY_QUERY);
-
-            if (_osm2ttl.hasTripleForOption(osm2rdfCnst::ADD_CENTROID_OPTION_LONG)) {
-                runUpdateQuery(sparql::UpdateOperation::DELETE,
-                    _queryWriter.writeDeleteOsmObjectCentroidQuery(OsmObjectType::RELATION, batch),
-                    cnst::PREFIXES_FOR_RELATION_DELETE_GEOMETRY_QUERY);
-            }
+                           sparql::QueryWriter::writeUpdateSequence(
+                               getDeleteOperationsForWays(batch)),
+                           cnst::PREFIXES_FOR_WAY_DELETE_GEOMETRY_QUERY, worker);
+        },
+        progress, counter);
+}
 
-            if(_osm2ttl.hasTripleForOption(osm2rdfCnst::ADD_OBB_OPTION_LONG)) {
-                runUpdateQuery(sparql::UpdateOperation::DELETE,
-                    _queryWriter.writeDeleteOsmObjectOBBQuery(OsmObjectType::RELATION, batch),
-                    cnst::PREFIXES_FOR_RELATION_DELETE_GEOMETRY_QUERY);
-            }
+// ____________________________________________________________________________________________
 
-            if(_osm2ttl.hasTripleForOption(osm2rdfCnst::ADD_ENVELOPE_OPTION_LONG)) {
-                runUpdateQuery(sparql::UpdateOperation::DELETE,
-                    _queryWriter.writeDeleteOsmObjectEnvelopeQuery(OsmObjectType::RELATION, batch),
-                    cnst::PREFIXES_FOR_RELATION_DELETE_GEOMETRY_QUERY);
-            }
+void olu::osm::OsmChangeHandler::deleteWaysGeometry(osm2rdf::util::ProgressBar &progress,
+                                                    size_t &counter) {
+    deleteInBatches(
+        _waysToUpdateGeometry,
+        [this](std::set<id_t> const &batch, const size_t worker) {
+            runUpdateQuery(sparql::UpdateOperation::DELETE,
+                           sparql::QueryWriter::writeUpdateSequence(
+                               getDeleteOperationsForWaysGeometry(batch)),
+                           cnst::PREFIXES_FOR_WAY_DELETE_GEOMETRY_QUERY, worker);
+        },
+        progress, counter);
+}
 
-            if(_osm2ttl.hasTripleForOption(osm2rdfCnst::ADD_CONVEX_HULL_OPTION_LONG)) {
-                runUpdateQuery(sparql::UpdateOperation::DELETE,
-                    _queryWriter.writeDeleteOsmObjectConvexHullQuery(OsmObjectType::RELATION, batch),
-                    cnst::PREFIXES_FOR_RELATION_DELETE_GEOMETRY_QUERY);
-            }
+// _________________________________________________________________________________________________
+void olu::osm::OsmChangeHandler::deleteRelationsFromDatabase(osm2rdf::util::ProgressBar &progress,
+                                                             size_t &counter) {
+    deleteInBatches(
+        getIdsOfRelationsToDelete(),
+        [this](std::set<id_t> const &batch, const size_t worker) {
+            runUpdateQuery(sparql::UpdateOperation::DELETE,
+                           sparql::QueryWriter::writeUpdateSequence(
+                               getDeleteOperationsForRelations(batch)),
+                           cnst::PREFIXES_FOR_RELATION_DELETE_GEOMETRY_QUERY, worker);
+        },
+        progress, counter);
+}
 
-            progress.update(counter += batch.size());
-        });
+// _________________________________________________________________________________________________
+void olu::osm::OsmChangeHandler::deleteRelationsGeometry(osm2rdf::util::ProgressBar &progress,
+                                                         size_t &counter) {
+    deleteInBatches(
+        _relationsToUpdateGeometry,
+        [this](std::set<id_t> const &batch, const size_t worker) {
+            runUpdateQuery(sparql::UpdateOperation::DELETE,
+                           sparql::QueryWriter::writeUpdateSequence(
+                               getDeleteOperationsForRelationsGeometry(batch)),
+                           cnst::PREFIXES_FOR_RELATION_DELETE_GEOMETRY_QUERY, worker);
+        },
+        progress, counter);
 }
 
 // _________________________________________________________________________________________________
@@ -672,68 +1031,342 @@ void olu::osm::OsmChangeHandler::deleteTriplesFromDatabase() {
 
 
 // _________________________________________________________________________________________________
-void olu::osm::OsmChangeHandler::insertTriplesToDatabase(const std::vector<triple_t> & triples) {
-    if (triples.empty()) {
-        util::Logger::log(util::LogEvent::INFO,"No triples to insert into database...");
-        return;
-    }
+void olu::osm::OsmChangeHandler::countBatchSizes() const {
+    const auto countBatchSize = [this](std::string requestKind,
+                                       const util::AdaptiveBatchSize &batchSize) {
+        _stats->setBatchSize(std::move(requestKind), batchSize.get(),
+                             batchSize.getNumOfFailures());
+    };
+    countBatchSize("node locations", _batchSizes.nodeLocations);
+    countBatchSize("way members", _batchSizes.wayMembers);
+    countBatchSize("relation members", _batchSizes.relationMembers);
+    countBatchSize("referencing elements", _batchSizes.referencingElements);
+    countBatchSize("delete operations", _batchSizes.deletes);
+}
 
-    util::Logger::log(util::LogEvent::INFO,"Inserting triples into database...");
+// _________________________________________________________________________________________________
+void olu::osm::OsmChangeHandler::filterAndInsertRelevantTriples() {
+    util::Logger::log(util::LogEvent::INFO,"Filtering and inserting triples into database...");
 
+    // The total size of the osm2rdf output is used for the progress, because the number of
+    // relevant triples is not known before the output has been filtered completely.
     // We do not show the progress bar here when detailed statistics for each update operation are
     // shown because that breaks the output format.
-    osm2rdf::util::ProgressBar insertProgress(triples.size(), _config->showProgress &&
-                                              !_config->showDetailedStatistics);
-    size_t counter = 0;
-    insertProgress.update(counter);
-
-    std::vector<std::string> tripleBatch;
-    for (size_t i = 0; i < triples.size(); ++i) {
-        auto [s, p, o] = triples[i];
-        std::string triple;
-        if (o.starts_with("_")) {
-            triple += s;
-            triple += " ";
-            triple += p;
-            triple += "[ ";
-
-            while (true) {
-                i++;
-                if (auto [next_s, next_p, next_o] = triples[i]; next_s.starts_with("_")) {
-                    triple += next_p;
-                    triple += " ";
-                    triple += next_o;
-                    triple += "; ";
-                } else {
-                    i--;
+    osm2rdf::util::ProgressBar insertProgress(
+        std::filesystem::file_size(cnst::getPathToOsm2rdfOutputFile(_config->tmpDir)),
+        _config->showProgress && !_config->showDetailedStatistics);
+    size_t bytesRead = 0;
+    insertProgress.update(bytesRead);
+
+    // Filled batches are written as update bodies, which are compressed if configured, by one
+    // thread and sent to the endpoint by another thread, so that the next batches can be built
+    // and compressed while the previous one is sent.
+    util::BoundedQueue<std::vector<std::string>> batchQueue(
+        config::Config::DEFAULT_INSERT_QUEUE_SIZE);
+    util::BoundedQueue<sparql::PreparedUpdate> updateQueue(
+        config::Config::DEFAULT_INSERT_QUEUE_SIZE);
+    std::exception_ptr preparerException;
+    std::thread preparer([this, &batchQueue, &updateQueue, &preparerException] {
+        try {
+            while (auto batch = batchQueue.pop()) {
+                sparql::PreparedUpdate update;
+                _sparql.setQuery(_queryWriter.writeInsertQuery(*batch));
+                _sparql.setPrefixes(cnst::DEFAULT_PREFIXES);
+                _sparql.prepareUpdate(sparql::UpdateOperation::INSERT, update);
+                if (!updateQueue.push(std::move(update))) {
+                    // The sender thread has stopped
                     break;
                 }
             }
+        } catch (...) {
+            preparerException = std::current_exception();
+            batchQueue.close();
+        }
+        updateQueue.close();
+    });
+
+    std::exception_ptr senderException;
+    std::thread sender([this, &batchQueue, &updateQueue, &senderException] {
+        try {
+            while (auto update = updateQueue.pop()) {
+                runPreparedUpdate(*update);
+            }
+        } catch (...) {
+            senderException = std::current_exception();
+            updateQueue.close();
+            batchQueue.close();
+        }
+    });
+
+    const auto joinThreads = [&batchQueue, &preparer, &sender, &preparerException,
+                              &senderException] {
+        batchQueue.close();
+        preparer.join();
+        sender.join();
+        if (senderException) {
+            std::rethrow_exception(senderException);
+        }
+        if (preparerException) {
+            std::rethrow_exception(preparerException);
+        }
+    };
 
-            triple += " ]";
-        } else {
-            triple += util::TtlHelper::getTripleString(std::move<triple_t>({s, p, o}));
+    std::vector<std::string> tripleBatch;
+    // Size of the triples in the batch, as they are written to the body of the insert operation
+    size_t batchBytes = 0;
+    const auto sendBatch = [this, &batchQueue, &tripleBatch, &batchBytes, &insertProgress,
+                            &bytesRead] {
+        {
+            std::lock_guard lock(_updateMutex);
+            _stats->countInsertBatch(tripleBatch.size(), batchBytes);
+        }
+        if (!batchQueue.push(std::move(tripleBatch))) {
+            // The preparer or sender thread has stopped, its exception is rethrown below
+            throw OsmChangeHandlerException("Sending of the insert batches was aborted.");
+        }
+        tripleBatch.clear();
+        batchBytes = 0;
+        insertProgress.update(bytesRead);
+    };
+
+    // The batch is sent before a triple is added if the triple would exceed the maximum size of
+    // the body, and after it was added if the batch has the maximum number of triples. A triple
+    // that is larger than the maximum size is sent in its own batch.
+    const auto addToBatch = [this, &tripleBatch, &batchBytes, &sendBatch](std::string triple) {
+        // Each triple is followed by " . " in the body
+        const size_t tripleBytes = triple.size() + 3;
+        if (!tripleBatch.empty() && batchBytes + tripleBytes > _config->insertBatchBytes) {
+            sendBatch();
         }
 
-        tripleBatch.emplace_back(triple);
+        batchBytes += tripleBytes;
+        tripleBatch.emplace_back(std::move(triple));
+        if (tripleBatch.size() >= _config->batchSize) {
+            sendBatch();
+        }
+    };
 
-        if (tripleBatch.size() == _config->batchSize || i == triples.size() - 1) {
-            runUpdateQuery(sparql::UpdateOperation::INSERT,
-                           _queryWriter.writeInsertQuery(tripleBatch),
-                           cnst::DEFAULT_PREFIXES);
-            tripleBatch.clear();
+    BlankNodeFolder folder;
+    size_t numOfTriplesToInsert = 0;
+    const auto addTriple = [&folder, &numOfTriplesToInsert, &addToBatch](const triple_t &triple) {
+        ++numOfTriplesToInsert;
+        folder.add(triple, addToBatch);
+    };
 
-            if (i == triples.size() - 1) {
-                insertProgress.done();
-            } else {
-                insertProgress.update(counter += _config->batchSize);
-            }
+    try {
+        _stats->startTimeFilteringTriples();
+        filterRelevantTriples(addTriple, [&bytesRead](const size_t bytes) {
+            bytesRead += bytes;
+        });
+        folder.finish(addToBatch);
+
+        if (!tripleBatch.empty()) {
+            sendBatch();
         }
+        _stats->endTimeFilteringTriples();
+    } catch (...) {
+        joinThreads();
+        throw;
+    }
+
+    joinThreads();
+
+    insertProgress.done();
+    _stats->setNumberOfTriplesToInsert(numOfTriplesToInsert);
+    if (numOfTriplesToInsert == 0) {
+        util::Logger::log(util::LogEvent::INFO,"No triples to insert into database...");
+    }
+}
+
+// _________________________________________________________________________________________________
+olu::osm::OsmChangeHandler::TriplesByObject
+olu::osm::OsmChangeHandler::groupRelevantTriplesByObject() const {
+    TriplesByObject triples;
+
+    // Triples of the object that the current triple belongs to. Triples that do not have an osm
+    // object as subject, for example the ones of a geometry, directly follow the triples of their
+    // object in the osm2rdf output.
+    std::vector<std::string>* objectTriples = nullptr;
+    const auto addToObject = [&objectTriples](std::string triple) {
+        if (objectTriples == nullptr) {
+            const std::string msg = "Triple does not follow the triples of an osm object: "
+                                    + triple.substr(0, 100);
+            throw OsmChangeHandlerException(msg.c_str());
+        }
+        objectTriples->emplace_back(std::move(triple));
+    };
+
+    BlankNodeFolder folder;
+    filterRelevantTriples(
+        [&triples, &objectTriples, &folder, &addToObject](const triple_t &triple) {
+            ++triples.numOfTriples;
+            if (const auto &subject = std::get<0>(triple); !subject.starts_with("_")) {
+                // A folded triple belongs to the object of the triples before it
+                folder.finish(addToObject);
+
+                if (util::TtlHelper::isInNamespaceForOsmObject(subject, OsmObjectType::NODE)) {
+                    objectTriples = &triples.nodes[util::TtlHelper::parseId(subject)];
+                } else if (util::TtlHelper::isInNamespaceForOsmObject(subject,
+                                                                      OsmObjectType::WAY)) {
+                    objectTriples = &triples.ways[util::TtlHelper::parseId(subject)];
+                } else if (util::TtlHelper::isInNamespaceForOsmObject(subject,
+                                                                      OsmObjectType::RELATION)) {
+                    objectTriples = &triples.relations[util::TtlHelper::parseId(subject)];
+                }
+            }
+
+            folder.add(triple, addToObject);
+        },
+        [](size_t) { });
+    folder.finish(addToObject);
+
+    return triples;
+}
+
+// _________________________________________________________________________________________________
+void olu::osm::OsmChangeHandler::deleteAndInsertTriples() {
+    util::Logger::log(util::LogEvent::INFO,"Filtering triples...");
+    _stats->startTimeFilteringTriples();
+    const auto triples = groupRelevantTriplesByObject();
+    _stats->endTimeFilteringTriples();
+    _stats->setNumberOfTriplesToInsert(triples.numOfTriples);
+
+    const auto nodeIds = _nodeHandler.getAllNodes();
+
+    const auto waysToDelete = getIdsOfWaysToDelete();
+    std::set wayIds(waysToDelete);
+    wayIds.insert(_waysToUpdateGeometry.begin(), _waysToUpdateGeometry.end());
+
+    const auto relationsToDelete = getIdsOfRelationsToDelete();
+    std::set relationIds(relationsToDelete);
+    relationIds.insert(_relationsToUpdateGeometry.begin(), _relationsToUpdateGeometry.end());
+
+    const std::size_t count = nodeIds.size() + wayIds.size() + relationIds.size();
+    if (count == 0) {
+        util::Logger::log(util::LogEvent::INFO,"No elements to delete or insert...");
+        return;
     }
+
+    util::Logger::log(util::LogEvent::INFO,"Deleting and inserting triples...");
+    _stats->startTimeDeletingTriples();
+
+    osm2rdf::util::ProgressBar progress(count,_config->showProgress &&
+                                        !_config->showDetailedStatistics);
+    size_t counter = 0;
+    progress.update(counter);
+
+    deleteAndInsertInBatches(
+        nodeIds,
+        [this](const std::set<id_t> &batch) { return getDeleteOperationsForNodes(batch); },
+        triples.nodes, progress, counter);
+
+    deleteAndInsertInBatches(
+        wayIds,
+        [this, &waysToDelete](const std::set<id_t> &batch) {
+            auto operations = getDeleteOperationsForWays(getIntersection(batch, waysToDelete));
+            std::ranges::move(getDeleteOperationsForWaysGeometry(
+                                  getIntersection(batch, _waysToUpdateGeometry)),
+                              std::back_inserter(operations));
+            return operations;
+        },
+        triples.ways, progress, counter);
+
+    deleteAndInsertInBatches(
+        relationIds,
+        [this, &relationsToDelete](const std::set<id_t> &batch) {
+            auto operations = getDeleteOperationsForRelations(
+                getIntersection(batch, relationsToDelete));
+            std::ranges::move(getDeleteOperationsForRelationsGeometry(
+                                  getIntersection(batch, _relationsToUpdateGeometry)),
+                              std::back_inserter(operations));
+            return operations;
+        },
+        triples.relations, progress, counter);
+
+    progress.done();
+    _stats->endTimeDeletingTriples();
 }
 
 // _________________________________________________________________________________________________
-std::vector<olu::triple_t> olu::osm::OsmChangeHandler::filterRelevantTriples() const {
+void olu::osm::OsmChangeHandler::deleteAndInsertInBatches(
+    const std::set<id_t> &ids,
+    const std::function<std::vector<std::string>(const std::set<id_t> &)> &getDeleteOperations,
+    const std::map<id_t, std::vector<std::string>> &triples,
+    osm2rdf::util::ProgressBar &progress, size_t &counter) {
+    deleteInBatches(
+        ids,
+        [this, &getDeleteOperations, &triples](const std::set<id_t> &batch, const size_t worker) {
+            auto operations = getDeleteOperations(batch);
+
+            // The triples of the batch are limited like the batches of
+            // `filterAndInsertRelevantTriples()`. The first part is inserted in the same update
+            // as the delete operations, the remaining parts are inserted in their own updates.
+            std::vector<std::string> tripleBatch;
+            size_t batchBytes = 0;
+            bool deleted = false;
+            const auto sendBatch = [this, &operations, &tripleBatch, &batchBytes, &deleted,
+                                    worker] {
+                {
+                    std::lock_guard lock(_updateMutex);
+                    _stats->countInsertBatch(tripleBatch.size(), batchBytes);
+                }
+
+                if (deleted) {
+                    runUpdateQuery(sparql::UpdateOperation::INSERT,
+                                   _queryWriter.writeInsertQuery(tripleBatch),
+                                   cnst::DEFAULT_PREFIXES, worker);
+                } else {
+                    operations.push_back(_queryWriter.writeInsertDataQuery(tripleBatch));
+                    runUpdateQuery(sparql::UpdateOperation::DELETE_AND_INSERT,
+                                   sparql::QueryWriter::writeUpdateSequence(operations),
+                                   cnst::DEFAULT_PREFIXES, worker);
+                    deleted = true;
+                }
+
+                tripleBatch.clear();
+                batchBytes = 0;
+            };
+
+            for (const auto &id: batch) {
+                const auto objectTriples = triples.find(id);
+                if (objectTriples == triples.end()) {
+                    continue;
+                }
+
+                for (const auto &triple: objectTriples->second) {
+                    // Each triple is followed by " . " in the body
+                    const size_t tripleBytes = triple.size() + 3;
+                    if (!tripleBatch.empty() &&
+                        batchBytes + tripleBytes > _config->insertBatchBytes) {
+                        sendBatch();
+                    }
+
+                    batchBytes += tripleBytes;
+                    tripleBatch.push_back(triple);
+                    if (tripleBatch.size() >= _config->batchSize) {
+                        sendBatch();
+                    }
+                }
+            }
+
+            if (!tripleBatch.empty()) {
+                sendBatch();
+            }
+
+            // The objects of the batch are only deleted
+            if (!deleted && !operations.empty()) {
+                runUpdateQuery(sparql::UpdateOperation::DELETE,
+                               sparql::QueryWriter::writeUpdateSequence(operations),
+                               cnst::DEFAULT_PREFIXES, worker);
+            }
+        },
+        progress, counter);
+}
+
+// _________________________________________________________________________________________________
+void olu::osm::OsmChangeHandler::filterRelevantTriples(
+        const std::function<void(triple_t)> &emit,
+        const std::function<void(size_t)> &countBytes) const {
     // Get the ids of all nodes, ways and relations for which the triples should be inserted
     // into the database
     std::set<id_t> nodesToInsert;
@@ -763,8 +1396,6 @@ std::vector<olu::triple_t> olu::osm::OsmChangeHandler::filterRelevantTriples() c
         relationsToInsert.insert(relId);
     }
 
-    // Triples that should be inserted into the database
-    std::vector<triple_t> relevantTriples;
     // current link object, for example, member nodes or geometries (can also be blank nodes)
     std::string currentLink;
 
@@ -773,6 +1404,8 @@ std::vector<olu::triple_t> olu::osm::OsmChangeHandler::filterRelevantTriples() c
     std::ifstream osm2rdfOutput;
     osm2rdfOutput.open(cnst::getPathToOsm2rdfOutputFile(_config->tmpDir));
     while (std::getline(osm2rdfOutput, line)) {
+        countBytes(line.size() + 1);
+
         // Filer out prefixes at the start of the document
         if (line.starts_with("@")) { continue; }
         _stats->countTriple();
@@ -782,43 +1415,41 @@ std::vector<olu::triple_t> olu::osm::OsmChangeHandler::filterRelevantTriples() c
 
         // Check if there is currently a link set
         if (!currentLink.empty() && currentLink == subject) {
-            relevantTriples.emplace_back(subject, predicate, util::XmlHelper::xmlDecode(object));
+            emit({subject, predicate, util::XmlHelper::xmlDecode(object)});
             continue;
         }
 
         // Check all triples that are in the "osmnode" namespace.
         if (util::TtlHelper::isInNamespaceForOsmObject(subject, OsmObjectType::NODE)) {
-            filterNodeTriple(triple, nodesToInsert, relevantTriples, currentLink);
+            filterNodeTriple(triple, nodesToInsert, emit, currentLink);
             continue;
         }
 
         // Check all triples that are in the "osmway" namespace.
         if (util::TtlHelper::isInNamespaceForOsmObject(subject, OsmObjectType::WAY)) {
-            filterWayTriple(triple, waysToInsert, relevantTriples, currentLink);
+            filterWayTriple(triple, waysToInsert, emit, currentLink);
             continue;
         }
 
         // Check all triples that are in the "osmrel" namespace.
         if (util::TtlHelper::isInNamespaceForOsmObject(subject, OsmObjectType::RELATION)) {
-            filterRelationTriple(triple, relationsToInsert, relevantTriples, currentLink);
+            filterRelationTriple(triple, relationsToInsert, emit, currentLink);
         }
     }
 
     osm2rdfOutput.close();
-    _stats->setNumberOfTriplesToInsert(relevantTriples.size());
-    return relevantTriples;
 }
 
 // _________________________________________________________________________________________________
 void olu::osm::OsmChangeHandler::filterNodeTriple(const triple_t &nodeTriple,
                                                   const std::set<id_t> &nodesToInsert,
-                                                  std::vector<triple_t> &relevantTriples,
+                                                  const std::function<void(triple_t)> &emit,
                                                   std::string &currentLink) {
     const auto& [subject, predicate, object] = nodeTriple;
     const auto nodeId =util::TtlHelper::parseId(subject);
 
     if (nodesToInsert.contains(nodeId)) {
-        relevantTriples.emplace_back(subject, predicate, util::XmlHelper::xmlDecode(object));
+        emit({subject, predicate, util::XmlHelper::xmlDecode(object)});
 
         if (util::TtlHelper::hasRelevantObject(predicate, OsmObjectType::NODE)) {
             currentLink = object;
@@ -829,13 +1460,13 @@ void olu::osm::OsmChangeHandler::filterNodeTriple(const triple_t &nodeTriple,
 // _________________________________________________________________________________________________
 void olu::osm::OsmChangeHandler::filterWayTriple(const triple_t &wayTriple,
                                                  const std::set<id_t> &waysToInsert,
-                                                 std::vector<triple_t> &relevantTriples,
+                                                 const std::function<void(triple_t)> &emit,
                                                  std::string &currentLink) const {
     const auto& [subject, predicate, object] = wayTriple;
     const auto wayId = util::TtlHelper::parseId(subject);
 
     if (waysToInsert.contains(wayId)) {
-        relevantTriples.emplace_back(subject, predicate, util::XmlHelper::xmlDecode(object));
+        emit({subject, predicate, util::XmlHelper::xmlDecode(object)});
 
         // Check if the object links to a relevant triple for the geometry of the
         // relation
@@ -850,7 +1481,7 @@ void olu::osm::OsmChangeHandler::filterWayTriple(const triple_t &wayTriple,
     // _waysToUpdateGeometry set.
     if (_waysToUpdateGeometry.contains(wayId)) {
         if (util::TtlHelper::isGeometryPredicate(predicate, OsmObjectType::WAY)) {
-            relevantTriples.emplace_back(subject, predicate, util::XmlHelper::xmlDecode(object));
+            emit({subject, predicate, util::XmlHelper::xmlDecode(object)});
         }
 
         // Check if the object links to a relevant triple for the geometry of the
@@ -864,13 +1495,13 @@ void olu::osm::OsmChangeHandler::filterWayTriple(const triple_t &wayTriple,
 // _________________________________________________________________________________________________
 void olu::osm::OsmChangeHandler::filterRelationTriple(const triple_t &relationTriple,
                                                  const std::set<id_t> &relationsToInsert,
-                                                 std::vector<triple_t> &relevantTriples,
+                                                 const std::function<void(triple_t)> &emit,
                                                  std::string &currentLink) const {
     const auto& [subject, predicate, object] = relationTriple;
     const auto relId = util::TtlHelper::parseId(subject);
 
     if (relationsToInsert.contains(relId)) {
-        relevantTriples.emplace_back(subject, predicate, util::XmlHelper::xmlDecode(object));
+        emit({subject, predicate, util::XmlHelper::xmlDecode(object)});
 
         // (For example, "osmrel:member" links to the object which describes
         // the member)
@@ -883,7 +1514,7 @@ void olu::osm::OsmChangeHandler::filterRelationTriple(const triple_t &relationTr
     // in the _relationsToUpdateGeometry set.
     if (_relationsToUpdateGeometry.contains(relId)) {
         if (util::TtlHelper::isGeometryPredicate(predicate, OsmObjectType::RELATION)) {
-            relevantTriples.emplace_back(subject, predicate, util::XmlHelper::xmlDecode(object));
+            emit({subject, predicate, util::XmlHelper::xmlDecode(object)});
         }
 
         // Check if the object links to a relevant triple for the geometry of the
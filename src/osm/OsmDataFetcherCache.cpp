@@ -0,0 +1,157 @@
+// Copyright 2025, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "osm/OsmDataFetcherCache.h"
+
+#include <fstream>
+
+// _________________________________________________________________________________________________
+template <typename T>
+std::vector<T>
+olu::osm::OsmDataFetcherCache::fetchCached(const OsmObjectType &type, const std::set<id_t> &ids,
+                                           Cache<T> &cache,
+                                           const std::function<std::vector<T>(
+                                               const std::set<id_t> &)> &fetch) {
+    std::vector<T> objects;
+    objects.reserve(ids.size());
+    std::set<id_t> idsToFetch;
+    {
+        std::lock_guard lock(_mutex);
+        for (const auto &id: ids) {
+            if (const auto it = cache.objects.find(id); it != cache.objects.end()) {
+                objects.push_back(it->second);
+            } else if (!cache.missingIds.contains(id)) {
+                idsToFetch.insert(idsToFetch.end(), id);
+            }
+        }
+        _stats->countFetcherCacheLookups(type, ids.size() - idsToFetch.size(),
+                                         idsToFetch.size());
+    }
+
+    if (idsToFetch.empty()) {
+        return objects;
+    }
+
+    auto fetchedObjects = fetch(idsToFetch);
+
+    std::lock_guard lock(_mutex);
+    for (auto &object: fetchedObjects) {
+        idsToFetch.erase(object.getId());
+        cache.objects.emplace(object.getId(), object);
+        objects.push_back(std::move(object));
+    }
+    cache.missingIds.insert(idsToFetch.begin(), idsToFetch.end());
+
+    return objects;
+}
+
+// _________________________________________________________________________________________________
+std::vector<olu::osm::Node>
+olu::osm::OsmDataFetcherCache::fetchNodes(const std::set<id_t> &nodeIds) {
+    return fetchCached<Node>(OsmObjectType::NODE, nodeIds, _nodes,
+                             [this](const std::set<id_t> &ids) {
+                                 return withFetcher([&ids](OsmDataFetcher &fetcher) {
+                                     return fetcher.fetchNodes(ids);
+                                 });
+                             });
+}
+
+// _________________________________________________________________________________________________
+void olu::osm::OsmDataFetcherCache::fetchAndWriteNodesToFile(const std::string &filePath,
+                                                             const std::set<id_t> &nodeIds) {
+    std::ofstream outputFile(filePath, std::ios::app);
+    for (const auto &node: fetchNodes(nodeIds)) {
+        outputFile << node.getXml() << std::endl;
+    }
+}
+
+// _________________________________________________________________________________________________
+std::vector<olu::osm::Way>
+olu::osm::OsmDataFetcherCache::fetchWays(const std::set<id_t> &wayIds) {
+    return fetchCached<Way>(OsmObjectType::WAY, wayIds, _ways,
+                            [this](const std::set<id_t> &ids) {
+                                return withFetcher([&ids](OsmDataFetcher &fetcher) {
+                                    return fetcher.fetchWays(ids);
+                                });
+                            });
+}
+
+// _________________________________________________________________________________________________
+std::vector<olu::osm::Relation>
+olu::osm::OsmDataFetcherCache::fetchRelations(const std::set<id_t> &relationIds) {
+    return fetchCached<Relation>(OsmObjectType::RELATION, relationIds, _relations,
+                                 [this](const std::set<id_t> &ids) {
+                                     return withFetcher([&ids](OsmDataFetcher &fetcher) {
+                                         return fetcher.fetchRelations(ids);
+                                     });
+                                 });
+}
+
+// _________________________________________________________________________________________________
+size_t olu::osm::OsmDataFetcherCache::fetchAndWriteRelationsToFile(
+    const std::string &filePath, const std::set<id_t> &relationIds) {
+    const auto relations = fetchRelations(relationIds);
+
+    std::ofstream outputFile(filePath, std::ios::app);
+    for (const auto &relation: relations) {
+        outputFile << relation.getXml() << std::endl;
+    }
+
+    return relations.size();
+}
+
+// _________________________________________________________________________________________________
+size_t olu::osm::OsmDataFetcherCache::fetchAndWriteWaysToFile(const std::string &filePath,
+                                                              const std::set<id_t> &wayIds) {
+    const auto ways = fetchWays(wayIds);
+
+    std::ofstream outputFile(filePath, std::ios::app);
+    for (const auto &way: ways) {
+        outputFile << way.getXml() << std::endl;
+    }
+
+    return ways.size();
+}
+
+// _________________________________________________________________________________________________
+olu::member_ids_t olu::osm::OsmDataFetcherCache::fetchWaysMembers(const std::set<id_t> &wayIds) {
+    member_ids_t nodeIds;
+    for (const auto &way: fetchWays(wayIds)) {
+        nodeIds.insert(nodeIds.end(), way.getMembers().begin(), way.getMembers().end());
+    }
+
+    return nodeIds;
+}
+
+// _________________________________________________________________________________________________
+std::pair<std::vector<olu::id_t>, std::vector<olu::id_t>>
+olu::osm::OsmDataFetcherCache::fetchRelationMembers(const std::set<id_t> &relIds) {
+    std::vector<id_t> nodeIds;
+    std::vector<id_t> wayIds;
+    for (const auto &relation: fetchRelations(relIds)) {
+        for (const auto &member: relation.getMembers()) {
+            if (member.type == OsmObjectType::NODE) {
+                nodeIds.emplace_back(member.id);
+            } else if (member.type == OsmObjectType::WAY) {
+                wayIds.emplace_back(member.id);
+            }
+        }
+    }
+
+    return {nodeIds, wayIds};
+}
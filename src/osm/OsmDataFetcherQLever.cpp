@@ -32,6 +32,8 @@
 #include "osm/OsmObjectHelper.h"
 #include "osm/RelationMember.h"
 #include "sparql/QueryWriter.h"
+#include "util/JsonArrayStream.h"
+#include "util/TsvStream.h"
 #include "util/Types.h"
 #include "util/XmlHelper.h"
 
@@ -40,42 +42,99 @@ namespace cnst = olu::config::constants;
 // _________________________________________________________________________________________________
 void olu::osm::OsmDataFetcherQLever::runQuery(const std::string &query,
                                               const std::vector<std::string> &prefixes,
-                                              std::function<void(simdjson::ondemand::value)>
-                                              resultFunc) {
+                                              const std::function<void(const result_row_t &)>
+                                              &resultFunc) {
     _stats->countQuery();
 
     _sparqlWrapper.setQuery(query);
     _sparqlWrapper.setPrefixes(prefixes);
 
-    auto response = _sparqlWrapper.runQuery();
-    auto paddedResponse = simdjson::padded_string(response);
-    for (auto doc = _parser.iterate(paddedResponse);
-         auto field: doc.get_object()) {
-        if (field.error()) {
-            std::cerr << field.error() << std::endl;
+    // Write SPARQL response to a file, if configured by the user
+    std::ofstream outputFile;
+    if (!_config.sparqlResponseFile.empty()) {
+        outputFile.open(_config.sparqlResponseFile, std::ios::app);
+        if (!outputFile) {
+            std::cerr << "Error opening file for SPARQL response output." << std::endl;
+            throw OsmDataFetcherException("Cannot open file for SPARQL response output.");
+        }
+    }
+
+    if (_config.useTsvResults) {
+        runTsvQuery(outputFile, resultFunc);
+    } else {
+        runJsonQuery(outputFile, resultFunc);
+    }
+    _stats->countQueryCompression(_sparqlWrapper.getLastQueryCompression());
+
+    if (outputFile.is_open()) {
+        outputFile << std::endl;
+        outputFile.close();
+    }
+}
+
+// _________________________________________________________________________________________________
+void olu::osm::OsmDataFetcherQLever::runTsvQuery(std::ofstream &outputFile,
+                                                 const std::function<void(const result_row_t &)>
+                                                 &resultFunc) {
+    // The values in the rows are already in the same RDF syntax as in the QLever JSON format, so
+    // the rows can be passed to the result function without parsing them.
+    util::TsvStream results(resultFunc);
+    _sparqlWrapper.runQuery([&results, &outputFile](const std::string_view chunk) {
+        if (outputFile.is_open()) {
+            outputFile.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+        }
+        results.feed(chunk);
+    });
+    results.finish();
+}
+
+// _________________________________________________________________________________________________
+void olu::osm::OsmDataFetcherQLever::runJsonQuery(std::ofstream &outputFile,
+                                                  const std::function<void(const result_row_t &)>
+                                                  &resultFunc) {
+    // Each row of the result is parsed as soon as it was received, while the rest of the
+    // response is still being downloaded. The rows are parsed from the buffer of the stream,
+    // which is padded for simdjson.
+    util::JsonArrayStream results(cnst::KEY_QLEVER_RESULTS,
+                                  [this, &resultFunc](const std::string &row) {
+        auto doc = _parser.iterate(simdjson::padded_string_view(row.data(), row.size(),
+                                                                row.capacity()));
+        auto values = doc.get_array();
+        if (values.error()) {
+            std::cerr << values.error() << std::endl;
             throw OsmDataFetcherException("Error while parsing QLever response.");
         }
 
-        const std::string_view key = field.escaped_key();
-        if (key == cnst::KEY_QLEVER_RESULTS) {
-            for (auto result: field.value()) {
-                resultFunc(result.value());
-            }
+        _row.clear();
+        for (auto value: values) {
+            _row.emplace_back(getString(value.value()));
         }
-        if (key == cnst::KEY_QLEVER_TIME) {
-            _stats->logQleverQueryInfo(field.value().get_object());
+        resultFunc(_row);
+    }, simdjson::SIMDJSON_PADDING);
+
+    _sparqlWrapper.runQuery([&results, &outputFile](const std::string_view chunk) {
+        if (outputFile.is_open()) {
+            outputFile.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
         }
+        results.feed(chunk);
+    });
+
+    if (!results.isArrayComplete()) {
+        throw OsmDataFetcherException("QLever response does not contain a complete result.");
     }
 
-    // Write SPARQL response to a file, if configured by the user
-    if (!_config.sparqlResponseFile.empty()) {
-        std::ofstream outputFile(_config.sparqlResponseFile, std::ios::app);
-        if (!outputFile) {
-            std::cerr << "Error opening file for SPARQL response output." << std::endl;
-            throw OsmDataFetcherException("Cannot open file for SPARQL response output.");
+    // The rest of the response only contains the metadata of the query
+    const simdjson::padded_string metadata(results.getRest());
+    for (auto doc = _parser.iterate(metadata);
+         auto field: doc.get_object()) {
+        if (field.error()) {
+            std::cerr << field.error() << std::endl;
+            throw OsmDataFetcherException("Error while parsing QLever response.");
+        }
+
+        if (const std::string_view key = field.escaped_key(); key == cnst::KEY_QLEVER_TIME) {
+            _stats->logQleverQueryInfo(field.value().get_object());
         }
-        outputFile << response << std::endl;
-        outputFile.close();
     }
 }
 
@@ -84,11 +143,11 @@ std::string olu::osm::OsmDataFetcherQLever::fetchLatestTimestamp() {
     std::string timestamp;
     runQuery(_queryWriter.writeQueryForLatestTimestamp(),
              cnst::PREFIXES_FOR_LATEST_TIMESTAMP,
-             [&timestamp](simdjson::ondemand::value results) {
-                 for (auto value: results) {
+             [&timestamp](const result_row_t &row) {
+                 for (const auto value: row) {
                      // QLever will return the timestamp in rdf syntax, e.g.:
                      // "\"2025-05-24T19:15:22\"^^<http://www.w3.org/2001/XMLSchema#dateTime>"
-                     auto response = getValue<std::string>(value.value());
+                     const std::string response(value);
                      const std::regex expr("\\\"([^\\\"]+)\\\"");
                      if (std::smatch match; regex_search(response, match, expr)) {
                          timestamp = match[1];
@@ -114,11 +173,9 @@ olu::osm::OsmDataFetcherQLever::fetchNodes(const std::set<id_t> &nodeIds) {
     nodes.reserve(nodeIds.size());
 
     runQuery(_queryWriter.writeQueryForNodeLocations(nodeIds), cnst::PREFIXES_FOR_NODE_LOCATION,
-             [&nodes](simdjson::ondemand::value results) {
-                 auto it = results.begin();
-                 const auto nodeUri = getValue<std::string_view>((*it).value());
-                 ++it;
-                 const auto nodeLocationAsWkt = getValue<std::string_view>((*it).value());
+             [&nodes](const result_row_t &row) {
+                 const auto nodeUri = getValue(row, 0);
+                 const auto nodeLocationAsWkt = getValue(row, 1);
                  nodes.emplace_back(OsmObjectHelper::parseIdFromUri(nodeUri),
                                     wktPoint_t(nodeLocationAsWkt));
              });
@@ -140,13 +197,11 @@ void olu::osm::OsmDataFetcherQLever::fetchAndWriteNodesToFile(const std::string
 
     size_t returnedNodeCount = 0;
     runQuery(_queryWriter.writeQueryForNodeLocations(nodeIds), cnst::PREFIXES_FOR_NODE_LOCATION,
-             [&returnedNodeCount, &outputFile](simdjson::ondemand::value results) {
+             [&returnedNodeCount, &outputFile](const result_row_t &row) {
                  returnedNodeCount++;
 
-                 auto it = results.begin();
-                 const auto nodeUri = getValue<std::string_view>((*it).value());
-                 ++it;
-                 const auto nodeLocationAsWkt = getValue<std::string_view>((*it).value());
+                 const auto nodeUri = getValue(row, 0);
+                 const auto nodeLocationAsWkt = getValue(row, 1);
 
                  const auto nodeId = OsmObjectHelper::parseIdFromUri(nodeUri);
                  const auto nodeLocation = OsmObjectHelper::parseLonLatFromWktPoint(
@@ -167,98 +222,100 @@ void olu::osm::OsmDataFetcherQLever::fetchAndWriteNodesToFile(const std::string
 }
 
 // _________________________________________________________________________________________________
-size_t
-olu::osm::OsmDataFetcherQLever::fetchAndWriteRelationsToFile(const std::string &filePath,
-                                                             const std::set<id_t> &relationIds) {
-    std::ofstream outputFile;
-    outputFile.open (filePath, std::ios::app);
+std::vector<olu::osm::Relation>
+olu::osm::OsmDataFetcherQLever::fetchRelations(const std::set<id_t> &relationIds) {
+    std::vector<Relation> relations;
+    relations.reserve(relationIds.size());
 
-    size_t returnedRelationsCount = 0;
     runQuery(_queryWriter.writeQueryForRelations(relationIds), cnst::PREFIXES_FOR_RELATION_MEMBERS,
-             [&outputFile, &returnedRelationsCount, this](simdjson::ondemand::value results) {
-                 returnedRelationsCount++;
+             [&relations](const result_row_t &row) {
+                 const auto relationUri = getValue(row, 0);
 
-                 auto it = results.begin();
-                 const auto relationUri = getValue<std::string_view>((*it).value());
-
-                 ++it;
-                 std::string_view relationType;
-                 if (auto value = *it; !value.is_null()) {
-                     relationType = getValue<std::string_view>(value.value());
+                 // The relation type is unbound for relations without a type
+                 auto relationType = getValue(row, 1);
+                 if (!relationType.empty()) {
                      // Remove the surrounding quotes from the relation type
                      relationType = relationType.substr(1, relationType.size() - 2);
                  }
 
-                 ++it;
-                 auto memberUriList = getValue<std::string_view>((*it).value());
+                 auto memberUriList = getValue(row, 2);
                  memberUriList = memberUriList.substr(1, memberUriList.size() - 2);
 
-                 ++it;
-                 auto memberRolesList = getValue<std::string_view>((*it).value());
+                 auto memberRolesList = getValue(row, 3);
                  memberRolesList = memberRolesList.substr(1, memberRolesList.size() - 2);
 
-                 ++it;
-                 auto memberPosList = getValue<std::string_view>((*it).value());
+                 auto memberPosList = getValue(row, 4);
                  memberPosList = memberPosList.substr(1, memberPosList.size() - 2);
 
-                 const auto relationId = OsmObjectHelper::parseIdFromUri(relationUri);
-                 const auto members = OsmObjectHelper::parseRelationMemberList(
-                         memberUriList, memberRolesList, memberPosList);
-
-                 // Write relation to file
-                 const auto relationXml = util::XmlHelper::getRelationDummy(
-                     relationId, relationType, members);
-                 outputFile.write(relationXml.data(), relationXml.size());
-                 outputFile << std::endl;
+                 relations.emplace_back(OsmObjectHelper::parseIdFromUri(relationUri),
+                                        std::string(relationType),
+                                        OsmObjectHelper::parseRelationMemberList(
+                                            memberUriList, memberRolesList, memberPosList));
              });
 
-    outputFile.close();
-    return returnedRelationsCount;
+    return relations;
 }
 
 // _________________________________________________________________________________________________
-size_t olu::osm::OsmDataFetcherQLever::fetchAndWriteWaysToFile(const std::string &filePath,
-                                                               const std::set<id_t> &wayIds) {
+size_t
+olu::osm::OsmDataFetcherQLever::fetchAndWriteRelationsToFile(const std::string &filePath,
+                                                             const std::set<id_t> &relationIds) {
+    const auto relations = fetchRelations(relationIds);
+
     std::ofstream outputFile;
     outputFile.open (filePath, std::ios::app);
+    for (const auto &relation: relations) {
+        outputFile << relation.getXml() << std::endl;
+    }
 
-    size_t returnedWayCount = 0;
-    runQuery(_queryWriter.writeQueryForWaysMembers(wayIds), cnst::PREFIXES_FOR_WAY_MEMBERS,
-             [&outputFile, &returnedWayCount, this](simdjson::ondemand::value results) {
-                 returnedWayCount++;
+    outputFile.close();
+    return relations.size();
+}
 
-                 auto it = results.begin();
-                 const auto wayUri = getValue<std::string_view>((*it).value());
+// _________________________________________________________________________________________________
+std::vector<olu::osm::Way>
+olu::osm::OsmDataFetcherQLever::fetchWays(const std::set<id_t> &wayIds) {
+    std::vector<Way> ways;
+    ways.reserve(wayIds.size());
 
-                 ++it;
-                 auto hasTag = false;
-                 if (auto value = *it; !value.is_null()) {
-                     const auto wayFacts = getValue<std::string_view>(value.value());
-                     hasTag = !wayFacts.starts_with("0");
-                 }
+    runQuery(_queryWriter.writeQueryForWaysMembers(wayIds), cnst::PREFIXES_FOR_WAY_MEMBERS,
+             [&ways](const result_row_t &row) {
+                 const auto wayUri = getValue(row, 0);
 
-                 ++it;
-                 auto memberUriList = getValue<std::string_view>((*it).value());
+                 // The facts are unbound for ways without tags
+                 const auto wayFacts = getValue(row, 1);
+                 const auto hasTag = !wayFacts.empty() && !wayFacts.starts_with("0");
+
+                 auto memberUriList = getValue(row, 2);
                  // Remove the surrounding brackets from the member URI list
                  memberUriList = memberUriList.substr(1, memberUriList.size() - 2);
 
-                 ++it;
-                 auto memberPosList = getValue<std::string_view>((*it).value());
+                 auto memberPosList = getValue(row, 3);
                  // Remove the surrounding brackets from the member pos list
                  memberPosList = memberPosList.substr(1, memberPosList.size() - 2);
 
-                 // Extract way infos from response
-                 const auto wayId = OsmObjectHelper::parseIdFromUri(wayUri);
-                 auto members = OsmObjectHelper::parseWayMemberList(memberUriList, memberPosList);
-
-                 // Write way to file
-                 const auto wayXml = util::XmlHelper::getWayDummy(wayId, members, hasTag);
-                 outputFile.write(wayXml.data(), wayXml.size());
-                 outputFile << std::endl;
+                 ways.emplace_back(OsmObjectHelper::parseIdFromUri(wayUri),
+                                   OsmObjectHelper::parseWayMemberList(memberUriList,
+                                                                       memberPosList),
+                                   hasTag);
              });
 
+    return ways;
+}
+
+// _________________________________________________________________________________________________
+size_t olu::osm::OsmDataFetcherQLever::fetchAndWriteWaysToFile(const std::string &filePath,
+                                                               const std::set<id_t> &wayIds) {
+    const auto ways = fetchWays(wayIds);
+
+    std::ofstream outputFile;
+    outputFile.open (filePath, std::ios::app);
+    for (const auto &way: ways) {
+        outputFile << way.getXml() << std::endl;
+    }
+
     outputFile.close();
-    return returnedWayCount;
+    return ways.size();
 }
 
 // _________________________________________________________________________________________________
@@ -266,9 +323,8 @@ std::vector<olu::id_t> olu::osm::OsmDataFetcherQLever::fetchWaysMembers(
     const std::set<id_t> &wayIds) {
     std::vector<id_t> nodeIds;
     runQuery(_queryWriter.writeQueryForReferencedNodes(wayIds), cnst::PREFIXES_FOR_WAY_MEMBERS,
-             [&nodeIds](simdjson::ondemand::value results) {
-                 for (auto result: results) {
-                     auto nodeUri = getValue<std::string_view>(result.value());
+             [&nodeIds](const result_row_t &row) {
+                 for (const auto nodeUri: row) {
                      nodeIds.emplace_back(OsmObjectHelper::parseIdFromUri(nodeUri));
                  }
              });
@@ -283,9 +339,8 @@ olu::osm::OsmDataFetcherQLever::fetchRelationMembers(const std::set<id_t> &relId
     std::vector<id_t> wayIds;
     runQuery(_queryWriter.writeQueryForRelationMemberIds(relIds),
              cnst::PREFIXES_FOR_RELATION_MEMBERS,
-             [&nodeIds, &wayIds](simdjson::ondemand::value results) {
-                 for (auto result: results) {
-                     auto memberUri = getValue<std::string_view>(result.value());
+             [&nodeIds, &wayIds](const result_row_t &row) {
+                 for (const auto memberUri: row) {
                      id_t memberId = OsmObjectHelper::parseIdFromUri(memberUri);
 
                      // Skip the first char in member URI, because it is a special character ('<')
@@ -308,9 +363,8 @@ olu::osm::OsmDataFetcherQLever::fetchWaysReferencingNodes(const std::set<id_t> &
 
     runQuery(_queryWriter.writeQueryForWaysReferencingNodes(nodeIds),
              cnst::PREFIXES_FOR_WAYS_REFERENCING_NODE,
-             [&memberSubjects, this](simdjson::ondemand::value results) {
-                 for (auto result: results) {
-                     auto memberUri = getValue<std::string_view>(result.value());
+             [&memberSubjects](const result_row_t &row) {
+                 for (const auto memberUri: row) {
                      memberSubjects.emplace_back(OsmObjectHelper::parseIdFromUri(memberUri));
                  }
              });
@@ -324,9 +378,8 @@ olu::osm::OsmDataFetcherQLever::fetchRelationsReferencingNodes(const std::set<id
     std::vector<id_t> relationIds;
     runQuery(_queryWriter.writeQueryForRelationsReferencingNodes(nodeIds),
              cnst::PREFIXES_FOR_RELATIONS_REFERENCING_NODE,
-             [&relationIds, this](simdjson::ondemand::value results) {
-                 for (auto result: results) {
-                     auto memberUri = getValue<std::string_view>(result.value());
+             [&relationIds](const result_row_t &row) {
+                 for (const auto memberUri: row) {
                      relationIds.emplace_back(OsmObjectHelper::parseIdFromUri(memberUri));
                  }
              });
@@ -340,9 +393,8 @@ olu::osm::OsmDataFetcherQLever::fetchRelationsReferencingWays(const std::set<id_
     std::vector<id_t> relationIds;
     runQuery(_queryWriter.writeQueryForRelationsReferencingWays(wayIds),
              cnst::PREFIXES_FOR_RELATIONS_REFERENCING_WAY,
-             [&relationIds, this](simdjson::ondemand::value results) {
-                 for (auto result: results) {
-                     auto memberUri = getValue<std::string_view>(result.value());
+             [&relationIds](const result_row_t &row) {
+                 for (const auto memberUri: row) {
                      relationIds.emplace_back(OsmObjectHelper::parseIdFromUri(memberUri));
                  }
              });
@@ -357,9 +409,8 @@ olu::osm::OsmDataFetcherQLever::fetchRelationsReferencingRelations(
     std::vector<id_t> refRelIds;
     runQuery(_queryWriter.writeQueryForRelationsReferencingRelations(relationIds),
              cnst::PREFIXES_FOR_RELATIONS_REFERENCING_RELATIONS,
-             [&refRelIds, this](simdjson::ondemand::value results) {
-                 for (auto result: results) {
-                     auto memberUri = getValue<std::string_view>(result.value());
+             [&refRelIds](const result_row_t &row) {
+                 for (const auto memberUri: row) {
                      refRelIds.emplace_back(OsmObjectHelper::parseIdFromUri(memberUri));
                  }
              });
@@ -372,9 +423,9 @@ std::string olu::osm::OsmDataFetcherQLever::fetchOsm2RdfVersion() {
     std::set<std::string> versions;
 
     runQuery(_queryWriter.writeQueryForOsm2RdfVersion(), cnst::PREFIXES_FOR_OSM2RDF_VERSION,
-             [&versions](simdjson::ondemand::value results) {
-                 for (auto result: results) {
-                     auto version = getValue<std::string>(result.value());
+             [&versions](const result_row_t &row) {
+                 for (const auto value: row) {
+                     const std::string version(value);
                      versions.insert(util::XmlHelper::parseRdfString<std::string>(version));
                  }
              });
@@ -396,12 +447,9 @@ std::map<std::string, std::string> olu::osm::OsmDataFetcherQLever::fetchOsm2RdfO
     std::map<std::string, std::string> options;
 
     runQuery(_queryWriter.writeQueryForOsm2RdfOptions(), cnst::PREFIXES_FOR_OSM2RDF_OPTIONS,
-             [&options](simdjson::ondemand::value results) {
-                 auto it = results.begin();
-                 const auto optionIRI = getValue<std::string>((*it).value());
-
-                 ++it;
-                 const auto optionValue = getValue<std::string>((*it).value());
+             [&options](const result_row_t &row) {
+                 const std::string optionIRI(getValue(row, 0));
+                 const std::string optionValue(getValue(row, 1));
 
                  options.insert_or_assign(OsmObjectHelper::parseOsm2rdfOptionName(optionIRI),
                                           util::XmlHelper::parseRdfString<std::string>(optionValue));
@@ -416,10 +464,10 @@ olu::osm::OsmDatabaseState olu::osm::OsmDataFetcherQLever::fetchUpdatesCompleteU
 
     runQuery(_queryWriter.writeQueryForUpdatesCompleteUntil(),
              cnst::PREFIXES_FOR_METADATA_TRIPLES,
-             [&updatesCompleteUntilResponses](simdjson::ondemand::value results) {
-                 for (auto result: results) {
+             [&updatesCompleteUntilResponses](const result_row_t &row) {
+                 for (const auto value: row) {
                      try {
-                         auto seqNumResponse = getValue<std::string>(result.value());
+                         const std::string seqNumResponse(value);
                          auto databaseState = util::XmlHelper::parseRdfString<std::string>(seqNumResponse);
                          updatesCompleteUntilResponses.insert(from_string(databaseState));
                      } catch (std::exception &e) {
@@ -447,10 +495,10 @@ std::string olu::osm::OsmDataFetcherQLever::fetchReplicationServer() {
 
     runQuery(_queryWriter.writeQueryForReplicationServer(),
              cnst::PREFIXES_FOR_METADATA_TRIPLES,
-             [&replicationServers](simdjson::ondemand::value results) {
-                 for (auto result: results) {
+             [&replicationServers](const result_row_t &row) {
+                 for (const auto value: row) {
                      try {
-                         auto replicationServer = getValue<std::string>(result.value());
+                         std::string replicationServer(value);
                          replicationServer = util::XmlHelper::parseRdfString<std::string>(replicationServer);
                          replicationServers.insert(replicationServer);
                      } catch (std::exception &e) {
@@ -486,57 +534,30 @@ olu::osm::OsmDataFetcherQLever::parseValueList(const std::string_view &list,
 }
 
 // _________________________________________________________________________________________________
-void
-olu::osm::OsmDataFetcherQLever::forResults(const simdjson::padded_string &response,
-                                           const std::function<void(simdjson::ondemand::value)>
-                                           func) {
-    auto doc = _parser.iterate(response);
-    if (doc.error()) {
-        std::cerr << doc.error() << std::endl;
-        throw OsmDataFetcherException("Error while parsing response document.");
-    }
-
-    for (auto result: getResults(doc.value())) {
-        if (result.error()) {
-            std::cerr << result.error() << std::endl;
-            throw OsmDataFetcherException("Error while parsing results.");
-        }
-
-        func(result.value());
+std::string_view olu::osm::OsmDataFetcherQLever::getString(simdjson::ondemand::value value) {
+    if (value.is_null()) {
+        return {};
     }
-}
 
-// _________________________________________________________________________________________________
-simdjson::ondemand::value
-olu::osm::OsmDataFetcherQLever::getResults(simdjson::ondemand::document &doc) {
-    auto results = doc[cnst::KEY_QLEVER_RESULTS];
-    if (results.error()) {
-        std::cerr << results.error() << std::endl;
-        throw OsmDataFetcherException("Error while getting results from document.");
+    std::string_view string;
+    if (const auto error = value.get_string().get(string); error) {
+        std::cerr << error << std::endl;
+        const std::string msg = "Cannot get value for results: "
+                                + std::string(value.raw_json().value());
+        throw OsmDataFetcherException(msg.c_str());
     }
 
-    return results.value();
+    return string;
 }
 
 // _________________________________________________________________________________________________
-template<typename T>
-T
-olu::osm::OsmDataFetcherQLever::getValue(simdjson::ondemand::value value) {
-    try {
-        if constexpr (std::is_same_v<T, std::string_view>) {
-            return value.get_string();
-        } else if constexpr (std::is_same_v<T, std::string>) {
-            return std::string(value.get_string().value());
-        } else if constexpr (std::is_same_v<T, int>) {
-            const auto intString = std::string(value.get_string().value());
-            return std::stoi(intString);
-        }
-    } catch (std::exception &e) {
-        std::cerr << e.what() << std::endl;
-        const std::string msg = "Cannot get value for results: "
-                                + std::string(value.raw_json().value());
+std::string_view olu::osm::OsmDataFetcherQLever::getValue(const result_row_t &row,
+                                                          const size_t index) {
+    if (index >= row.size()) {
+        const std::string msg = "QLever response contains a row with " + std::to_string(row.size())
+                                + " values, expected at least " + std::to_string(index + 1) + ".";
         throw OsmDataFetcherException(msg.c_str());
     }
 
-    throw OsmDataFetcherException("The type of the value is not supported atm.");
+    return row[index];
 }
@@ -45,6 +45,7 @@ olu::osm::OsmDataFetcherSparql::runQuery(const std::string &query,
     _sparqlWrapper.setQuery(query);
     _sparqlWrapper.setPrefixes(prefixes);
     auto response = _sparqlWrapper.runQuery();
+    _stats->countQueryCompression(_sparqlWrapper.getLastQueryCompression());
 
     // Write SPARQL response to a file, if configured by the user
     if (!_config.sparqlResponseFile.empty()) {
@@ -136,17 +137,14 @@ std::string olu::osm::OsmDataFetcherSparql::fetchLatestTimestamp() {
 }
 
 // _________________________________________________________________________________________________
-size_t
-olu::osm::OsmDataFetcherSparql::fetchAndWriteRelationsToFile(const std::string &filePath,
-                                                             const std::set<id_t> &relationIds) {
+std::vector<olu::osm::Relation>
+olu::osm::OsmDataFetcherSparql::fetchRelations(const std::set<id_t> &relationIds) {
     const auto response = runQuery(
         _queryWriter.writeQueryForRelations(relationIds),
         cnst::PREFIXES_FOR_RELATION_MEMBERS);
 
-    std::ofstream outputFile;
-    outputFile.open (filePath, std::ios::app);
-
-    size_t returnedRelationsCount = 0;
+    std::vector<Relation> relations;
+    relations.reserve(relationIds.size());
     for (auto doc = _parser.iterate(response); auto binding : getBindings(doc)) {
 
         // Set id and type of the relation
@@ -165,31 +163,39 @@ olu::osm::OsmDataFetcherSparql::fetchAndWriteRelationsToFile(const std::string &
         auto memberUriList = getValue<std::string_view>(binding[cnst::NAME_MEMBER_IDS]);
         auto memberRolesList = getValue<std::string_view>(binding[cnst::NAME_MEMBER_ROLES]);
         auto memberPosList = getValue<std::string_view>(binding[cnst::NAME_MEMBER_POSS]);
-        const auto members = OsmObjectHelper::parseRelationMemberList(
-                memberUriList, memberRolesList, memberPosList);
+        relations.emplace_back(relationId, relationType,
+                               OsmObjectHelper::parseRelationMemberList(
+                                   memberUriList, memberRolesList, memberPosList));
+    }
+
+    return relations;
+}
+
+// _________________________________________________________________________________________________
+size_t
+olu::osm::OsmDataFetcherSparql::fetchAndWriteRelationsToFile(const std::string &filePath,
+                                                             const std::set<id_t> &relationIds) {
+    const auto relations = fetchRelations(relationIds);
 
-        // Write relation to file
-        outputFile << util::XmlHelper::getRelationDummy(relationId, relationType, members)
-                   << std::endl;
+    std::ofstream outputFile;
+    outputFile.open (filePath, std::ios::app);
+    for (const auto &relation: relations) {
+        outputFile << relation.getXml() << std::endl;
     }
 
-    return returnedRelationsCount;
+    return relations.size();
 }
 
 // _________________________________________________________________________________________________
-size_t olu::osm::OsmDataFetcherSparql::fetchAndWriteWaysToFile(const std::string &filePath,
-                                                               const std::set<id_t> &wayIds) {
+std::vector<olu::osm::Way>
+olu::osm::OsmDataFetcherSparql::fetchWays(const std::set<id_t> &wayIds) {
     auto response = runQuery(
             _queryWriter.writeQueryForWaysMembers(wayIds),
             cnst::PREFIXES_FOR_WAY_MEMBERS);
 
-    std::ofstream outputFile;
-    outputFile.open (filePath, std::ios::app);
-
-    size_t returnedWayCount = 0;
+    std::vector<Way> ways;
+    ways.reserve(wayIds.size());
     for (auto doc = _parser.iterate(response); auto binding : getBindings(doc)) {
-        returnedWayCount++;
-
         auto wayUri = getValue<std::string_view>(binding[cnst::NAME_VALUE]);
         auto memberUriList = getValue<std::string_view>(binding[cnst::NAME_MEMBER_IDS]);
         auto memberPosList = getValue<std::string_view>(binding[cnst::NAME_MEMBER_POSS]);
@@ -207,11 +213,24 @@ size_t olu::osm::OsmDataFetcherSparql::fetchAndWriteWaysToFile(const std::string
             // the exception and continue
         }
 
-        // Write way to file
-        outputFile << util::XmlHelper::getWayDummy(wayId, members, hasTag) << std::endl;
+        ways.emplace_back(wayId, std::move(members), hasTag);
+    }
+
+    return ways;
+}
+
+// _________________________________________________________________________________________________
+size_t olu::osm::OsmDataFetcherSparql::fetchAndWriteWaysToFile(const std::string &filePath,
+                                                               const std::set<id_t> &wayIds) {
+    const auto ways = fetchWays(wayIds);
+
+    std::ofstream outputFile;
+    outputFile.open (filePath, std::ios::app);
+    for (const auto &way: ways) {
+        outputFile << way.getXml() << std::endl;
     }
 
-    return returnedWayCount;
+    return ways.size();
 }
 
 // _________________________________________________________________________________________________
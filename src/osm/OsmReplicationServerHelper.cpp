@@ -18,24 +18,23 @@
 
 #include "osm/OsmReplicationServerHelper.h"
 
+#include <algorithm>
 #include <vector>
 #include <iostream>
 #include <fstream>
 #include <regex>
-
-#include "omp.h"
+#include <optional>
 
 #include "config/Constants.h"
 #include "util/Exceptions.h"
 #include "util/URLHelper.h"
+#include "util/HttpDownloader.h"
 #include "util/HttpRequest.h"
 #include "util/Logger.h"
 #include "util/Time.h"
 
 namespace cnst = olu::config::constants;
 
-inline constexpr int BATCH_SIZE = 10;
-
 // _________________________________________________________________________________________________
 olu::osm::OsmDatabaseState
 olu::osm::OsmReplicationServerHelper::fetchDatabaseStateFromUrl(
@@ -64,10 +63,21 @@ olu::osm::OsmReplicationServerHelper::fetchDatabaseStateFromUrl(
 // _________________________________________________________________________________________________
 olu::osm::OsmDatabaseState
 olu::osm::OsmReplicationServerHelper::fetchDatabaseStateForSeqNumber(const int sequenceNumber) const {
+    {
+        std::lock_guard lock(_stateCacheMutex);
+        if (const auto it = _stateCache.find(sequenceNumber); it != _stateCache.end()) {
+            return it->second;
+        }
+    }
+
     const auto stateFileName =
             util::URLHelper::formatSequenceNumberForUrl(sequenceNumber) + "." +
             cnst::PATH_TO_STATE_FILE;
-    return fetchDatabaseStateFromUrl(stateFileName);
+    const auto state = fetchDatabaseStateFromUrl(stateFileName);
+
+    std::lock_guard lock(_stateCacheMutex);
+    _stateCache.emplace(sequenceNumber, state);
+    return state;
 }
 
 // _________________________________________________________________________________________________
@@ -76,34 +86,51 @@ olu::osm::OsmDatabaseState olu::osm::OsmReplicationServerHelper::fetchLatestData
 }
 
 // _________________________________________________________________________________________________
-void olu::osm::OsmReplicationServerHelper::fetchChangeFile(int &sequenceNumber) const {
-    std::string diffFilename = util::URLHelper::formatSequenceNumberForUrl(sequenceNumber)
-                               + cnst::OSM_CHANGE_FILE_EXTENSION
-                               + cnst::GZIP_EXTENSION;
-    std::string url = util::URLHelper::buildUrl({
-        _config->replicationServerUri,
-        diffFilename});
+void olu::osm::OsmReplicationServerHelper::fetchChangeFiles(
+    const int fromSeqNum, const int toSeqNum, const std::function<void(int)> &onFetched) const {
+    downloadChangeFiles(fromSeqNum, toSeqNum, false,
+                        [&onFetched](const int sequenceNumber, std::string &) {
+                            onFetched(sequenceNumber);
+                        });
+}
 
-    // Get change file from server and write to a cache file.
-    std::string response;
+// _________________________________________________________________________________________________
+void olu::osm::OsmReplicationServerHelper::streamChangeFiles(
+    const int fromSeqNum, const int toSeqNum,
+    const std::function<void(int, std::string &)> &onFetched) const {
+    downloadChangeFiles(fromSeqNum, toSeqNum, true, onFetched);
+}
+
+// _________________________________________________________________________________________________
+void olu::osm::OsmReplicationServerHelper::downloadChangeFiles(
+    const int fromSeqNum, const int toSeqNum, const bool keepInMemory,
+    const std::function<void(int, std::string &)> &onFetched) const {
+    std::vector<util::HttpDownloader::Download> downloads;
+    for (int sequenceNumber = fromSeqNum; sequenceNumber <= toSeqNum; ++sequenceNumber) {
+        const std::string diffFilename = util::URLHelper::formatSequenceNumberForUrl(sequenceNumber)
+                                         + cnst::OSM_CHANGE_FILE_EXTENSION
+                                         + cnst::GZIP_EXTENSION;
+        downloads.push_back({
+            util::URLHelper::buildUrl({_config->replicationServerUri, diffFilename}),
+            keepInMemory ? "" : cnst::getPathForChangeFile(_config->tmpDir, sequenceNumber)});
+    }
+
+    // Get change files from server and write them to cache files or pass them on directly.
     try {
-        response = util::HttpRequest(util::GET, url).perform();
-    } catch (const std::exception& e) {
+        util::HttpDownloader(_config->maxConcurrentDownloads).run(
+            downloads, [&fromSeqNum, &onFetched](const size_t index, std::string &body) {
+                onFetched(fromSeqNum + static_cast<int>(index), body);
+            });
+    } catch (const util::HttpDownloaderException& e) {
         if (std::string(e.what()).find("404") != std::string::npos) {
             std::cerr << "The change file is not found on the replication server" << std::endl;
         }
 
-        const std::string msg = "Exception while trying to fetch change file for sequence "
-                                "number " + sequenceNumber;
+        const std::string msg = "Exception while trying to fetch change files for sequence "
+                                "numbers " + std::to_string(fromSeqNum) + " to "
+                                + std::to_string(toSeqNum);
         throw OsmReplicationServerHelperException(msg.c_str());
     }
-
-    std::string fileName = cnst::getPathForChangeFile(_config->tmpDir, sequenceNumber);
-
-    std::ofstream outputFile;
-    outputFile.open(fileName);
-    outputFile << response;
-    outputFile.close();
 }
 
 // _________________________________________________________________________________________________
@@ -122,88 +149,105 @@ void olu::osm::OsmReplicationServerHelper::fetchDatabaseStateForTimestamp(
 
     util::Logger::log(util::LogEvent::INFO,
                       "Find matching database state on replication server...");
-    // Fetch database states in batches of BATCH_SIZE until we find a state file that has a matching
-    // timestamp.
-    auto toSeqNum = _stats->getLatestDatabaseState().sequenceNumber;
 
     // If the osm planet replication server is used, we can make an educated guess for the sequence
     // number based on the timestamp, since the sequences are generated with a granularity of
-    // minutes, hours or days.
-    if (const auto guessedSeqNum = makeEducatedGuessForSequenceNumber(timeStamp, toSeqNum);
-        guessedSeqNum > 0) {
-        // Fetch the database states for the guessed sequence number and the one before and after
-        // it
-        for (const auto databaseStates = fetchDatabaseStatesForSequenceNumbers(
-                 std::max(guessedSeqNum - 1, 0), std::min(guessedSeqNum + 1, toSeqNum));
-             const auto &fetchedState: databaseStates) {
-            if (fetchedState <= OsmDatabaseState(timeStamp)) {
-                _stats->setStartDatabaseState(fetchedState);
-                util::Logger::log(util::LogEvent::INFO,
-                                  "Matching database state on replication server is: "
-                                  + olu::osm::to_string(fetchedState));
-                return;
-            }
-        }
-    }
-
-    // If another replication server is used or the educated guess fails, we have to find a matching
-    // database state by brute-force iteration through the sequence numbers.
-    while (toSeqNum > 0) {
-        const auto fromSeqNum = std::max(toSeqNum - BATCH_SIZE, 0);
-
-        for (auto databaseStates = fetchDatabaseStatesForSequenceNumbers(fromSeqNum, toSeqNum);
-             const auto& fetchedState : databaseStates) {
-            if (fetchedState.timeStamp <= timeStamp) {
-                _stats->setStartDatabaseState(fetchedState);
-                util::Logger::log(util::LogEvent::INFO,
-                                  "Matching database state on replication server is: "
-                                  + olu::osm::to_string(fetchedState));
-                return;
-            }
-        }
+    // minutes, hours or days. The guess is used as the first probe of the search.
+    const auto guessedSeqNum = makeEducatedGuessForSequenceNumber(
+        timeStamp, _stats->getLatestDatabaseState().sequenceNumber);
 
-        toSeqNum = std::max(fromSeqNum, 0);
-    }
+    const auto state = searchDatabaseStateForTimestamp(
+        timeStamp, _stats->getLatestDatabaseState(), guessedSeqNum,
+        [this](const int sequenceNumber) {
+            return fetchDatabaseStateForSeqNumber(sequenceNumber);
+        });
 
-    const std::string msg = "Could not find matching database state for timestamp: " + timeStamp;
-    throw OsmReplicationServerHelperException(msg.c_str());
+    _stats->setStartDatabaseState(state);
+    util::Logger::log(util::LogEvent::INFO,
+                      "Matching database state on replication server is: "
+                      + olu::osm::to_string(state));
 }
 
 // _________________________________________________________________________________________________
-std::vector<olu::osm::OsmDatabaseState>
-olu::osm::OsmReplicationServerHelper::fetchDatabaseStatesForSequenceNumbers(const int fromSeqNum,
-    const int toSeqNum) const {
-    std::vector<OsmDatabaseState> states;
-#pragma omp parallel for
-    for (int seqNum = fromSeqNum; seqNum <= toSeqNum; seqNum++) {
-        OsmDatabaseState state;
-        try {
-            state = fetchDatabaseStateForSeqNumber(seqNum);
-        } catch (std::exception &e) {
-            std::cerr << e.what() << std::endl;
-            const std::string msg = "Exception while trying to fetch state file for sequence "
-                                    "number: " + std::to_string(seqNum);
-            throw OsmReplicationServerHelperException(msg.c_str());
+olu::osm::OsmDatabaseState olu::osm::OsmReplicationServerHelper::searchDatabaseStateForTimestamp(
+    const std::string &timeStamp, const OsmDatabaseState &latestState, const int guessedSeqNum,
+    const std::function<OsmDatabaseState(int)> &fetchState) {
+    const auto secondsOf = [](const OsmDatabaseState &state) {
+        return util::secondsSinceEpoch(formatTimestamp(state.timeStamp));
+    };
+    const auto target = util::secondsSinceEpoch(formatTimestamp(timeStamp));
+    const auto notFound = [&timeStamp] {
+        const std::string msg = "Could not find matching database state for timestamp: "
+                                + timeStamp;
+        return OsmReplicationServerHelperException(msg.c_str());
+    };
+
+    // Invariant: `upper` is after the timestamp, `lower` is before or equal to it.
+    OsmDatabaseState upper = latestState;
+    std::optional<OsmDatabaseState> lower;
+
+    int probe = guessedSeqNum;
+    if (probe < 0 || probe >= upper.sequenceNumber) {
+        // Estimate the sequence number from the interval between the two latest states
+        if (upper.sequenceNumber <= 0) {
+            throw notFound();
+        }
+
+        const auto previous = fetchState(upper.sequenceNumber - 1);
+        if (secondsOf(previous) <= target) {
+            return previous;
         }
 
-#pragma omp critical
-        {
-            states.push_back(state);
+        const auto interval = std::max<int64_t>(secondsOf(upper) - secondsOf(previous), 1);
+        upper = previous;
+        probe = upper.sequenceNumber
+                - static_cast<int>((secondsOf(upper) - target + interval - 1) / interval);
+    }
+
+    // Go back in exponentially growing steps from the first probe until a state is found that is
+    // before the timestamp.
+    int step = std::max(upper.sequenceNumber - probe, 1);
+    while (!lower) {
+        probe = std::clamp(probe, 0, upper.sequenceNumber - 1);
+        if (const auto state = fetchState(probe); secondsOf(state) <= target) {
+            lower = state;
+        } else if (probe == 0) {
+            throw notFound();
+        } else {
+            upper = state;
+            step = std::min(step * 2, upper.sequenceNumber);
+            probe = upper.sequenceNumber - step;
         }
     }
 
-    // Since we fetched the states in parallel, we have to sort them by sequence number to make sure
-    // they are in the correct order.
-    std::ranges::sort(states, [](const OsmDatabaseState& a, const OsmDatabaseState& b) {
-        return a.sequenceNumber > b.sequenceNumber;
-    });
+    // Interpolation search between the two states. Replication intervals are mostly regular, so
+    // the interpolated sequence number is usually close to the searched one. If an interpolation
+    // step did not at least halve the range, the next step bisects it, so the number of fetched
+    // state files stays logarithmic.
+    bool bisect = false;
+    while (upper.sequenceNumber - lower->sequenceNumber > 1) {
+        const int from = lower->sequenceNumber;
+        const int to = upper.sequenceNumber;
+        if (bisect) {
+            probe = from + (to - from) / 2;
+        } else {
+            const auto fromSeconds = secondsOf(*lower);
+            const auto toSeconds = secondsOf(upper);
+            probe = from + static_cast<int>((target - fromSeconds) * (to - from)
+                                            / std::max<int64_t>(toSeconds - fromSeconds, 1));
+        }
+        probe = std::clamp(probe, from + 1, to - 1);
+
+        if (const auto state = fetchState(probe); secondsOf(state) <= target) {
+            lower = state;
+        } else {
+            upper = state;
+        }
 
-    if (static_cast<int>(states.size()) != (toSeqNum - fromSeqNum + 1)) {
-        std::cout << "Missing state between: " << fromSeqNum << " and " << toSeqNum << std::endl;
-        throw OsmReplicationServerHelperException("One or more state files could not be fetched for the given sequence number range.");
+        bisect = !bisect && (upper.sequenceNumber - lower->sequenceNumber) * 2 > to - from;
     }
 
-    return states;
+    return *lower;
 }
 
 // _________________________________________________________________________________________________
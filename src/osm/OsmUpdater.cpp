@@ -24,8 +24,12 @@
 #include <util/Time.h>
 
 #include "omp.h"
+#include "osmium/io/pbf_input.hpp"
+#include "osmium/io/reader.hpp"
 
+#include "osm/Extract.h"
 #include "osm/OsmChangeHandler.h"
+#include "osm/OsmDataFetcherCache.h"
 #include "osm/OsmDataFetcherQLever.h"
 #include "osm/OsmDataFetcherSparql.h"
 #include "osm/Osm2ttl.h"
@@ -33,17 +37,26 @@
 #include "config/Constants.h"
 #include "ttl/Triple.h"
 #include "util/Exceptions.h"
+#include "util/HttpClient.h"
 #include "util/Logger.h"
 
 namespace cnst = olu::config::constants;
 
 std::unique_ptr<olu::osm::OsmDataFetcher>
 createOsmDataFetcher(const olu::config::Config& config, olu::osm::StatisticsHandler &stats) {
-    if (config.isQLever) {
-        return std::make_unique<olu::osm::OsmDataFetcherQLever>(config, stats);
+    // One fetcher per concurrent query, because a fetcher can only handle one query at a time
+    std::vector<std::unique_ptr<olu::osm::OsmDataFetcher>> fetchers;
+    for (size_t i = 0; i < config.maxConcurrentRequests; ++i) {
+        if (config.isQLever) {
+            fetchers.push_back(std::make_unique<olu::osm::OsmDataFetcherQLever>(config, stats));
+        } else {
+            fetchers.push_back(std::make_unique<olu::osm::OsmDataFetcherSparql>(config, stats));
+        }
     }
 
-    return std::make_unique<olu::osm::OsmDataFetcherSparql>(config, stats);
+    // The fetched objects are only remembered for one run, because the data on the endpoint
+    // changes with each update
+    return std::make_unique<olu::osm::OsmDataFetcherCache>(std::move(fetchers), stats);
 }
 
 // _________________________________________________________________________________________________
@@ -59,6 +72,8 @@ olu::osm::OsmUpdater::OsmUpdater(config::Config &config) : _config(&config),
     omp_set_num_threads(config.numThreads);
 #endif
 
+    util::HttpClient::setUseHttp2(_config->useHttp2);
+
     // Delete all files and folders in the temporary directory to ensure a clean start.
     // This is needed to potentially avoid conflicts with files from a previous failed update.
     deleteTmpDir();
@@ -73,6 +88,18 @@ olu::osm::OsmUpdater::OsmUpdater(config::Config &config) : _config(&config),
         throw OsmUpdaterException("Failed to create temporary directories");
     }
 
+    if (!_config->indexDir.empty()) {
+        try {
+            _nodeLocationIndex = std::make_unique<NodeLocationIndex>(
+                cnst::getPathToNodeLocationIndex(_config->indexDir));
+            _wayNodeIndex = std::make_unique<WayNodeIndex>(_config->indexDir);
+            _relationMemberIndex = std::make_unique<RelationMemberIndex>(_config->indexDir);
+        } catch (const std::exception &e) {
+            util::Logger::log(util::LogEvent::ERROR, e.what());
+            throw OsmUpdaterException("Failed to open local indexes");
+        }
+    }
+
     if (_config->sparqlOutput != config::ENDPOINT) {
         try {
             std::ofstream outputFile;
@@ -92,6 +119,12 @@ void olu::osm::OsmUpdater::run() {
     // same that is used in this program.
     checkOsm2RdfVersions();
 
+    if (!_config->indexBootstrapFile.empty()) {
+        _stats.startTimeBuildingIndexes();
+        buildIndexes();
+        _stats.endTimeBuildingIndexes();
+    }
+
     // Handle either local directory with change files or external one depending on the user
     // input
     if (!_config->changeFileDir.empty()) {
@@ -125,25 +158,30 @@ void olu::osm::OsmUpdater::run() {
             _stats.setLatestDatabaseState({"", _config->maxSequenceNumber});
         }
 
-        _stats.startTimeFetchingChangeFiles();
-        fetchChangeFiles();
-        _stats.endTimeFetchingChangeFiles();
-
-        _stats.startTimeMergingChangeFiles();
-        mergeChangeFiles(cnst::getPathToChangeFileDir(_config->tmpDir));
-        clearChangesDir();
-        _stats.endTimeMergingChangeFiles();
-    }
-
-    if (!_config->bbox.empty() || !_config->pathToPolygonFile.empty()) {
-        _stats.startTimeApplyingBoundaries();
-        applyBoundaries();
-        _stats.endTimeApplyingBoundaries();
+        if (_config->streamChangeFiles) {
+            fetchAndMergeChangeFiles();
+        } else {
+            _stats.startTimeFetchingChangeFiles();
+            fetchChangeFiles();
+            _stats.endTimeFetchingChangeFiles();
+
+            _stats.startTimeMergingChangeFiles();
+            mergeChangeFiles(cnst::getPathToChangeFileDir(_config->tmpDir));
+            clearChangesDir();
+            _stats.endTimeMergingChangeFiles();
+        }
     }
 
-    auto och{OsmChangeHandler(*_config, *_odf, _stats)};
+    auto och{OsmChangeHandler(*_config, *_odf, _stats, _nodeLocationIndex.get(),
+                              _wayNodeIndex.get(), _relationMemberIndex.get())};
     och.run();
 
+    if (_nodeLocationIndex != nullptr) {
+        _stats.startTimeUpdatingIndexes();
+        updateIndexes();
+        _stats.endTimeUpdatingIndexes();
+    }
+
     _stats.startTimeInsertingMetadataTriples();
     insertMetadataTriples(och);
     _stats.endTimeInsertingMetadataTriples();
@@ -236,7 +274,7 @@ void olu::osm::OsmUpdater::decideStartSequenceNumber() {
 }
 
 // _________________________________________________________________________________________________
-void olu::osm::OsmUpdater::mergeChangeFiles(const std::string &pathToChangeFileDir) const {
+void olu::osm::OsmUpdater::mergeChangeFiles(const std::string &pathToChangeFileDir) {
     // Get names for each change file and order them after their id
     std::vector<osmium::io::File> inputs;
     for (const auto& file : std::filesystem::directory_iterator(
@@ -251,9 +289,12 @@ void olu::osm::OsmUpdater::mergeChangeFiles(const std::string &pathToChangeFileD
     }
 
     util::Logger::log(util::LogEvent::INFO, "Merging and sorting change files...");
-    OsmFileHelper::mergeAndSortFiles(inputs, cnst::getPathToChangeFile(_config->tmpDir),
-                                     object_order_type_id_reverse_version_delete(),
-                                     inputs.size() > 1);
+    OsmObjectCollection objects(object_order_type_id_reverse_version_delete(),
+                                _config->mergeMemoryLimit,
+                                cnst::getPathToMergeRunDir(_config->tmpDir));
+    OsmFileHelper::addFiles(objects, inputs, inputs.size() > 1, _config->mergeMemoryLimit,
+                            cnst::getPathToMergeRunDir(_config->tmpDir));
+    writeChangeFile(objects);
 }
 
 // _________________________________________________________________________________________________
@@ -265,41 +306,116 @@ void olu::osm::OsmUpdater::fetchChangeFiles() {
                                                 _stats.getNumOfChangeFiles() > 1);
     size_t counter = 0;
     downloadProgress.update(counter);
-#pragma omp parallel for
-    for (int currentSeqNum = _stats.getStartDatabaseState().sequenceNumber;
-         currentSeqNum <= _stats.getLatestDatabaseState().sequenceNumber; currentSeqNum++) {
-        _repServer.fetchChangeFile(currentSeqNum);
-#pragma omp critical
-        {
-            downloadProgress.update(counter++);
-        }
-    }
+    _repServer.fetchChangeFiles(_stats.getStartDatabaseState().sequenceNumber,
+                                _stats.getLatestDatabaseState().sequenceNumber,
+                                [&downloadProgress, &counter](int) {
+                                    downloadProgress.update(++counter);
+                                });
     downloadProgress.done();
 }
 
-// _________________________________________________________________________________________________`
-void olu::osm::OsmUpdater::applyBoundaries() const {
+// _________________________________________________________________________________________________
+void olu::osm::OsmUpdater::fetchAndMergeChangeFiles() {
+    util::Logger::log(util::LogEvent::INFO, "Fetching and merging " +
+        std::to_string(_stats.getNumOfChangeFiles()) + " change files from replication server...");
+
+    _stats.startTimeFetchingChangeFiles();
+    osm2rdf::util::ProgressBar downloadProgress(_stats.getNumOfChangeFiles(),
+                                                _stats.getNumOfChangeFiles() > 1);
+    size_t counter = 0;
+    downloadProgress.update(counter);
+
+    // The gzip compressed change files are decompressed by osmium while they are parsed from
+    // the downloaded buffers, so they are never written to disk.
+    OsmObjectCollection objects(object_order_type_id_reverse_version_delete(),
+                                _config->mergeMemoryLimit,
+                                cnst::getPathToMergeRunDir(_config->tmpDir));
+    _repServer.streamChangeFiles(_stats.getStartDatabaseState().sequenceNumber,
+                                 _stats.getLatestDatabaseState().sequenceNumber,
+                                 [&](int, const std::string &changeFile) {
+                                     objects.add(osmium::io::File(changeFile.data(),
+                                                                  changeFile.size(), "osc.gz"));
+                                     downloadProgress.update(++counter);
+                                 });
+    downloadProgress.done();
+    _stats.endTimeFetchingChangeFiles();
+
+    // The change files are parsed while they are fetched, so only the sorting and writing of the
+    // merged objects is counted as merging
+    util::Logger::log(util::LogEvent::INFO, "Sorting change files...");
+    _stats.startTimeMergingChangeFiles();
+    writeChangeFile(objects);
+    _stats.endTimeMergingChangeFiles();
+}
+
+// _________________________________________________________________________________________________
+void olu::osm::OsmUpdater::writeChangeFile(
+    OsmObjectCollection<object_order_type_id_reverse_version_delete> &objects) {
+    if (_config->bbox.empty() && _config->pathToPolygonFile.empty()) {
+        objects.write(cnst::getPathToChangeFile(_config->tmpDir));
+        return;
+    }
+
     util::Logger::log(util::LogEvent::INFO, "Applying boundaries to change files...");
 
-    // See the osmium-tool manual for details about the extract command:
-    // https://osmcode.org/osmium-tool/manual.html#creating-geographic-extracts
-    std::string cmd = "osmium extract " + cnst::getPathToChangeFile(_config->tmpDir);
-    if (!_config->bbox.empty()) {
-        cmd += " --bbox " + _config->bbox;
-    } else if (!_config->pathToPolygonFile.empty()) {
-        cmd += " --polygon " + _config->pathToPolygonFile;
-    } else {
-        throw OsmUpdaterException("No bounding box or polygon file specified.");
+    // The complete_ways and smart strategies need to know all objects before it can be decided
+    // which nodes belong to the extract, so the merged objects are passed to the extract once
+    // before they are written. The simple strategy decides while the objects are written.
+    // Because the objects are filtered while they are written, the filtered write is counted as
+    // applying the boundaries. This time is part of the time for merging the change files.
+    _stats.startTimeApplyingBoundaries();
+    Extract extract(*_config);
+    if (extract.needsPreparation()) {
+        objects.forEach([&extract](const osmium::OSMObject &object) {
+            extract.prepare(object);
+        });
+        extract.finish();
     }
 
-    cmd += " -o " + cnst::getPathToChangeFileExtract(_config->tmpDir) + " --overwrite -s "
-        + _config->extractStrategy + "  --no-progress";
+    objects.write(cnst::getPathToChangeFile(_config->tmpDir),
+                  [&extract](const osmium::OSMObject &object) {
+                      return extract.includes(object);
+                  });
+    _stats.endTimeApplyingBoundaries();
+}
 
-    // Overwrite the original change file with the extracted one
-    cmd += " && mv " + cnst::getPathToChangeFileExtract(_config->tmpDir) + " " + cnst::getPathToChangeFile(_config->tmpDir);
+// _________________________________________________________________________________________________
+void olu::osm::OsmUpdater::buildIndexes() const {
+    util::Logger::log(util::LogEvent::INFO, "Building local indexes from: "
+                                            + _config->indexBootstrapFile.string());
+    try {
+        _nodeLocationIndex->clear();
+        _wayNodeIndex->beginBuild();
+        _relationMemberIndex->beginBuild();
+        osmium::io::Reader reader{ _config->indexBootstrapFile.string(),
+            osmium::osm_entity_bits::nwr,
+            osmium::io::read_meta::no};
+        osmium::apply(reader, *_nodeLocationIndex, *_wayNodeIndex, *_relationMemberIndex);
+        reader.close();
+        _nodeLocationIndex->sync();
+        _wayNodeIndex->endBuild();
+        _relationMemberIndex->endBuild();
+    } catch (const std::exception &e) {
+        util::Logger::log(util::LogEvent::ERROR, e.what());
+        throw OsmUpdaterException("Failed to build local indexes.");
+    }
+}
 
-    if (std::system(cmd.c_str()) != 0) {
-        throw OsmUpdaterException("Failed to apply boundaries using osmium extract command.");
+// _________________________________________________________________________________________________
+void olu::osm::OsmUpdater::updateIndexes() const {
+    util::Logger::log(util::LogEvent::INFO, "Updating local indexes...");
+    try {
+        osmium::io::Reader reader{ cnst::getPathToChangeFile(_config->tmpDir),
+            osmium::osm_entity_bits::nwr,
+            osmium::io::read_meta::no};
+        osmium::apply(reader, *_nodeLocationIndex, *_wayNodeIndex, *_relationMemberIndex);
+        reader.close();
+        _nodeLocationIndex->sync();
+        _wayNodeIndex->commit();
+        _relationMemberIndex->commit();
+    } catch (const std::exception &e) {
+        util::Logger::log(util::LogEvent::ERROR, e.what());
+        throw OsmUpdaterException("Failed to update local indexes.");
     }
 }
 
@@ -18,6 +18,9 @@
 
 #include "osm/ReferencesHandler.h"
 
+#include <algorithm>
+#include <functional>
+
 #include "osm2rdf/osm/Relation.h"
 #include "osmium/osm/way.hpp"
 
@@ -26,9 +29,7 @@
 // _________________________________________________________________________________________________
 void olu::osm::ReferencesHandler::way(const osmium::Way &way) {
     for (const auto& node : way.nodes()) {
-        if (!_nodeHandler.nodeInChangeFile(node.ref())) {
-            _referencedNodes.insert(node.ref());
-        }
+        _nodeMembers.push_back(node.ref());
     }
 }
 
@@ -37,19 +38,13 @@ void olu::osm::ReferencesHandler::relation(const osmium::Relation& relation) {
     for (const auto& member : relation.members()) {
         switch (member.type()) {
             case osmium::item_type::node:
-                if (!_nodeHandler.nodeInChangeFile(member.ref())) {
-                    _referencedNodes.insert(member.ref());
-                }
+                _nodeMembers.push_back(member.ref());
                 break;
             case osmium::item_type::way:
-                if (!_wayHandler.wayInChangeFile(member.ref())) {
-                    _referencedWays.insert(member.ref());
-                }
+                _wayMembers.push_back(member.ref());
                 break;
             case osmium::item_type::relation:
-                if (!_relationHandler.relationInChangeFile(member.ref())) {
-                    _referencedRelations.insert(member.ref());
-                }
+                _relationMembers.push_back(member.ref());
                 break;
             default:
                 const std::string msg = "Cannot handle type for member with id " +
@@ -60,14 +55,64 @@ void olu::osm::ReferencesHandler::relation(const osmium::Relation& relation) {
     }
 }
 
+// _________________________________________________________________________________________________
+void olu::osm::ReferencesHandler::resolveReferences() {
+    const auto resolve = [](member_ids_t &members, std::set<id_t> &referenced,
+                            const std::function<bool(id_t)> &inChangeFile) {
+        std::ranges::sort(members);
+        const auto [first, last] = std::ranges::unique(members);
+        members.erase(first, last);
+        for (const auto &id: members) {
+            if (!inChangeFile(id)) {
+                referenced.insert(referenced.end(), id);
+            }
+        }
+
+        members.clear();
+        members.shrink_to_fit();
+    };
+
+    resolve(_nodeMembers, _referencedNodes, [this](const id_t id) {
+        return _nodeHandler.nodeInChangeFile(id);
+    });
+    resolve(_wayMembers, _referencedWays, [this](const id_t id) {
+        return _wayHandler.wayInChangeFile(id);
+    });
+    resolve(_relationMembers, _referencedRelations, [this](const id_t id) {
+        return _relationHandler.relationInChangeFile(id);
+    });
+}
+
 // _________________________________________________________________________________________________
 void olu::osm::ReferencesHandler::getReferencesForRelations(const std::set<id_t> &relationIds) {
-    if (!relationIds.empty()) {
-        util::BatchHelper::doInBatches(
-                relationIds,
-                _config.batchSize,
-                [this](const std::set<id_t>& batch) {
-                auto [nodeIds, wayIds] = _odf->fetchRelationMembers(batch);
+    std::set<id_t> relationsToFetch = relationIds;
+    if (_relationMemberIndex != nullptr && _relationMemberIndex->isBuilt()) {
+        std::vector<Relation> indexedRelations;
+        relationsToFetch = _relationMemberIndex->lookup(relationIds, indexedRelations);
+        std::lock_guard lock(_mutex);
+        for (const auto &relation: indexedRelations) {
+            for (const auto &member: relation.getMembers()) {
+                if (member.type == OsmObjectType::WAY && !_wayHandler.wayInChangeFile(member.id)) {
+                    _referencedWays.insert(member.id);
+                } else if (member.type == OsmObjectType::NODE &&
+                           !_nodeHandler.nodeInChangeFile(member.id)) {
+                    _referencedNodes.insert(member.id);
+                }
+            }
+        }
+    }
+
+    if (!relationsToFetch.empty()) {
+        util::BatchHelper::doInBatchesConcurrently(
+            relationsToFetch,
+            _batchSizes->relationMembers,
+            _config.maxConcurrentRequests,
+            [this](const std::set<id_t>& batch, size_t) {
+                return _odf->fetchRelationMembers(batch);
+            },
+            [this](const std::pair<std::vector<id_t>, std::vector<id_t>> &members, size_t) {
+                const auto &[nodeIds, wayIds] = members;
+                std::lock_guard lock(_mutex);
                 for (const auto &wayId: wayIds) {
                     if (!_wayHandler.wayInChangeFile(wayId)) {
                         _referencedWays.insert(wayId);
@@ -85,15 +130,20 @@ void olu::osm::ReferencesHandler::getReferencesForRelations(const std::set<id_t>
 // _________________________________________________________________________________________________
 void olu::osm::ReferencesHandler::getReferencesForWays(const std::set<id_t> &wayIds) {
     if (!wayIds.empty()) {
-        util::BatchHelper::doInBatches(
-        wayIds,
-        _config.batchSize,
-        [this](const std::set<id_t>& batch) {
-            for (const auto &nodeId: _odf->fetchWaysMembers(batch)) {
-                if (!_nodeHandler.nodeInChangeFile(nodeId)) {
-                    _referencedNodes.insert(nodeId);
+        util::BatchHelper::doInBatchesConcurrently(
+            wayIds,
+            _batchSizes->wayMembers,
+            _config.maxConcurrentRequests,
+            [this](const std::set<id_t>& batch, size_t) {
+                return _odf->fetchWaysMembers(batch);
+            },
+            [this](const member_ids_t &nodeIds, size_t) {
+                std::lock_guard lock(_mutex);
+                for (const auto &nodeId: nodeIds) {
+                    if (!_nodeHandler.nodeInChangeFile(nodeId)) {
+                        _referencedNodes.insert(nodeId);
+                    }
                 }
-            }
-        });
+            });
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,30 @@
+// Copyright 2025, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "osm/Relation.h"
+
+#include "util/XmlHelper.h"
+
+// _________________________________________________________________________________________________
+olu::osm::Relation::Relation(const id_t id, std::string type, relation_members_t members) :
+    id(id), type(std::move(type)), members(std::move(members)) { }
+
+// _________________________________________________________________________________________________
+std::string olu::osm::Relation::getXml() const {
+    return util::XmlHelper::getRelationDummy(id, type, members);
+}
@@ -0,0 +1,203 @@
+// Copyright 2025, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "osm/RelationMemberIndex.h"
+
+#include <algorithm>
+#include <fstream>
+
+#include "config/Constants.h"
+#include "osm/OsmObjectHelper.h"
+
+namespace cnst = olu::config::constants;
+
+// _________________________________________________________________________________________________
+olu::osm::RelationMemberIndex::RelationMemberIndex(const std::filesystem::path &indexDir) :
+    _membersOfRelations(cnst::getPathToRelationMembersIndex(indexDir)),
+    _relationTypes(cnst::getPathToRelationTypesIndex(indexDir)),
+    _relationsOfMembers(cnst::getPathToMemberRelationsIndex(indexDir)),
+    _stringsPath(cnst::getPathToRelationStringsIndex(indexDir)) {
+    readStrings();
+}
+
+// _________________________________________________________________________________________________
+void olu::osm::RelationMemberIndex::relation(const osmium::Relation &relation) {
+    const bool building = _relationTypesBuilder != nullptr;
+    if (!building && !isBuilt()) {
+        return;
+    }
+
+    if (!building) {
+        // Remove the members and the type of the relation before the change
+        for (const auto &member: _membersOfRelations.get(relation.id())) {
+            _membersOfRelations.erase(relation.id(), member);
+            _relationsOfMembers.erase(getMemberKey(member.type, member.ref), relation.id());
+        }
+        for (const auto &typeId: _relationTypes.get(relation.id())) {
+            _relationTypes.erase(relation.id(), typeId);
+        }
+
+        if (OsmObjectHelper::getChangeAction(relation) == ChangeAction::DELETE) {
+            return;
+        }
+    }
+
+    const char* type = relation.tags()["type"];
+    const auto typeId = getStringId(type != nullptr ? type : "");
+
+    uint32_t position = 0;
+    for (const auto &osmiumMember: relation.members()) {
+        const RelationMember member(osmiumMember.ref(), osmiumMember.type(),
+                                    osmiumMember.role());
+        const StoredMember storedMember{position++, getStringId(member.role), member.id,
+                                        member.type};
+        const auto memberKey = getMemberKey(member.type, member.id);
+        if (building) {
+            _membersOfRelationsBuilder->add(relation.id(), storedMember);
+            _relationsOfMembersBuilder->add(memberKey, relation.id());
+        } else {
+            _membersOfRelations.insert(relation.id(), storedMember);
+            _relationsOfMembers.insert(memberKey, relation.id());
+        }
+    }
+
+    if (building) {
+        _relationTypesBuilder->add(relation.id(), typeId);
+    } else {
+        _relationTypes.insert(relation.id(), typeId);
+    }
+}
+
+// _________________________________________________________________________________________________
+void olu::osm::RelationMemberIndex::beginBuild() {
+    _membersOfRelationsBuilder =
+        std::make_unique<util::PersistentMultiMap<StoredMember>::Builder>(_membersOfRelations);
+    _relationTypesBuilder =
+        std::make_unique<util::PersistentMultiMap<uint32_t>::Builder>(_relationTypes);
+    _relationsOfMembersBuilder =
+        std::make_unique<util::PersistentMultiMap<id_t>::Builder>(_relationsOfMembers);
+}
+
+// _________________________________________________________________________________________________
+void olu::osm::RelationMemberIndex::endBuild() {
+    writeStrings();
+    _membersOfRelationsBuilder->finish();
+    _relationsOfMembersBuilder->finish();
+    // The relation types are finished last, because their presence marks the index as built
+    _relationTypesBuilder->finish();
+    _membersOfRelationsBuilder.reset();
+    _relationTypesBuilder.reset();
+    _relationsOfMembersBuilder.reset();
+}
+
+// _________________________________________________________________________________________________
+std::set<olu::id_t>
+olu::osm::RelationMemberIndex::lookup(const std::set<id_t> &relationIds,
+                                      std::vector<Relation> &relations) const {
+    std::set<id_t> missingRelationIds;
+    for (const auto &relationId: relationIds) {
+        const auto typeIds = _relationTypes.get(relationId);
+        if (typeIds.empty()) {
+            missingRelationIds.insert(missingRelationIds.end(), relationId);
+            continue;
+        }
+
+        // The stored members are ordered by their position
+        auto storedMembers = _membersOfRelations.get(relationId);
+        std::ranges::sort(storedMembers);
+
+        relation_members_t members;
+        members.reserve(storedMembers.size());
+        for (const auto &storedMember: storedMembers) {
+            members.emplace_back(storedMember.ref, storedMember.type,
+                                 _strings[storedMember.roleId]);
+        }
+
+        relations.emplace_back(relationId, _strings[typeIds.front()], std::move(members));
+    }
+
+    return missingRelationIds;
+}
+
+// _________________________________________________________________________________________________
+std::set<olu::id_t>
+olu::osm::RelationMemberIndex::getRelationsReferencing(const OsmObjectType &memberType,
+                                                       const std::set<id_t> &memberIds) const {
+    std::set<id_t> relationIds;
+    for (const auto &memberId: memberIds) {
+        for (const auto &relationId: _relationsOfMembers.get(getMemberKey(memberType, memberId))) {
+            relationIds.insert(relationId);
+        }
+    }
+
+    return relationIds;
+}
+
+// _________________________________________________________________________________________________
+void olu::osm::RelationMemberIndex::commit() {
+    writeStrings();
+    _membersOfRelations.commit();
+    _relationsOfMembers.commit();
+    _relationTypes.commit();
+}
+
+// _________________________________________________________________________________________________
+uint32_t olu::osm::RelationMemberIndex::getStringId(const std::string &string) {
+    if (const auto it = _stringIds.find(string); it != _stringIds.end()) {
+        return it->second;
+    }
+
+    const auto stringId = static_cast<uint32_t>(_strings.size());
+    _strings.push_back(string);
+    _stringIds.emplace(string, stringId);
+    return stringId;
+}
+
+// _________________________________________________________________________________________________
+void olu::osm::RelationMemberIndex::readStrings() {
+    std::ifstream input(_stringsPath, std::ios::binary);
+    if (!input) {
+        return;
+    }
+
+    // The strings are separated by null characters, which cannot appear in OSM roles and tags
+    std::string string;
+    while (std::getline(input, string, '\0')) {
+        getStringId(string);
+    }
+    _numOfStoredStrings = _strings.size();
+}
+
+// _________________________________________________________________________________________________
+void olu::osm::RelationMemberIndex::writeStrings() {
+    if (_numOfStoredStrings == _strings.size()) {
+        return;
+    }
+
+    std::ofstream output(_stringsPath, std::ios::binary | std::ios::app);
+    for (size_t i = _numOfStoredStrings; i < _strings.size(); ++i) {
+        output.write(_strings[i].data(), static_cast<std::streamsize>(_strings[i].size()));
+        output.put('\0');
+    }
+
+    if (!output) {
+        const std::string msg = "Cannot write relation strings to file: " + _stringsPath.string();
+        throw RelationMemberIndexException(msg.c_str());
+    }
+    _numOfStoredStrings = _strings.size();
+}
@@ -18,10 +18,12 @@
 
 #include "osm/StatisticsHandler.h"
 
+#include <algorithm>
 #include <iostream>
 
 #include "config/Constants.h"
 #include "sparql/SparqlWrapper.h"
+#include "util/HttpClient.h"
 #include "util/Logger.h"
 #include "util/Time.h"
 
@@ -101,6 +103,47 @@ void olu::osm::StatisticsHandler::printUpdateStatistics() const {
                       << getNumOfDummyRelations() << " relations"
                       << std::endl;
         }
+
+        if (const auto requests = util::HttpClient::getNumOfRequests(); requests > 0) {
+            util::Logger::stream() << util::Logger::PREFIX_SPACER << "HTTP connections: "
+                      << requests << " requests, "
+                      << util::HttpClient::getNumOfConnections() << " connections opened ("
+                      << util::HttpClient::getNumOfRequestsWithoutNewConnection()
+                      << " requests without a new connection)" << std::endl;
+        }
+
+        constexpr std::array<std::string_view, 3> objectTypes{"nodes", "ways", "relations"};
+        for (size_t type = 0; type < objectTypes.size(); ++type) {
+            const auto lookups = _fetcherCacheHits[type] + _fetcherCacheMisses[type];
+            if (lookups == 0) {
+                continue;
+            }
+
+            util::Logger::stream() << util::Logger::PREFIX_SPACER << "Fetcher cache for "
+                      << objectTypes[type] << ": " << _fetcherCacheHits[type] << " hits, "
+                      << _fetcherCacheMisses[type] << " misses ("
+                      << calculatePercentage(lookups, _fetcherCacheHits[type]) << "% hit rate)"
+                      << std::endl;
+        }
+
+        if (!_config.indexDir.empty()) {
+            const auto lookups = _numOfNodeLocationIndexHits + _numOfNodeLocationIndexMisses;
+            util::Logger::stream() << util::Logger::PREFIX_SPACER << "Node location index: "
+                      << _numOfNodeLocationIndexHits << " hits, "
+                      << _numOfNodeLocationIndexMisses << " misses ("
+                      << calculatePercentage(lookups, _numOfNodeLocationIndexHits) << "% hit rate)"
+                      << std::endl;
+            util::Logger::stream() << util::Logger::PREFIX_SPACER << "Way node index: "
+                      << "looked up the ways of " << _numOfWayNodeIndexLookups << " moved nodes"
+                      << std::endl;
+            const auto relationLookups = _numOfRelationMemberIndexHits
+                                         + _numOfRelationMemberIndexMisses;
+            util::Logger::stream() << util::Logger::PREFIX_SPACER << "Relation member index: "
+                      << _numOfRelationMemberIndexHits << " hits, "
+                      << _numOfRelationMemberIndexMisses << " misses ("
+                      << calculatePercentage(relationLookups, _numOfRelationMemberIndexHits)
+                      << "% hit rate)" << std::endl;
+        }
     }
 }
 
@@ -123,14 +166,36 @@ void olu::osm::StatisticsHandler::printSparqlStatistics() const {
 
     util::Logger::stream() << util::Logger::PREFIX_SPACER
           << _queriesCount << " queries, "
-          << _deleteOpCount << " delete and "
-          << _insertOpCount << " insert operations were ";
+          << _deleteOpCount << " delete, "
+          << _insertOpCount << " insert and "
+          << _deleteAndInsertOpCount << " combined delete and insert operations were ";
     if ( _config.sparqlOutputFile.empty()) {
         util::Logger::stream() << "send to the endpoint." << std::endl;
     } else {
         util::Logger::stream() << "written to the output file at path " << _config.sparqlOutputFile << std::endl;
     }
 
+    if (!_config.requestCompression.empty()) {
+        printCompressionStatistics("queries", _queryCompression);
+        printCompressionStatistics("insert operations", _insertCompression);
+        printCompressionStatistics("delete operations", _deleteCompression);
+        printCompressionStatistics("combined delete and insert operations",
+                                   _deleteAndInsertCompression);
+    }
+
+    if (_config.showDetailedStatistics && _insertBatchTriples.count() > 0) {
+        printHistogram("Triples per insert operation", "triples", _insertBatchTriples);
+        printHistogram("Bytes per insert operation", "bytes", _insertBatchBytes);
+    }
+
+    if (_config.adaptiveBatchSize) {
+        for (const auto &[requestKind, batchSize, numOfSplits]: _batchSizes) {
+            util::Logger::stream() << util::Logger::PREFIX_SPACER
+                << "Batch size for " << requestKind << ": " << batchSize << " ("
+                << numOfSplits << " batches were split)" << std::endl;
+        }
+    }
+
     if (_config.isQLever) {
         util::Logger::stream() << util::Logger::PREFIX_SPACER
             << "QLever response time: " << _qleverResponseTimeMs << " ms" << std::endl;
@@ -156,6 +221,39 @@ void olu::osm::StatisticsHandler::printSparqlStatistics() const {
     }
 }
 
+// _________________________________________________________________________________________________
+void olu::osm::StatisticsHandler::printCompressionStatistics(
+    const std::string_view requestType, const util::CompressionInfo &compression) {
+    if (compression.inputSize == 0) {
+        return;
+    }
+
+    util::Logger::stream() << util::Logger::PREFIX_SPACER
+              << "Compressed bodies of " << requestType << " from "
+              << compression.inputSize << " to " << compression.outputSize << " bytes (ratio "
+              << static_cast<double>(compression.inputSize)
+                 / static_cast<double>(std::max<size_t>(compression.outputSize, 1))
+              << ") in "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(compression.duration).count()
+              << " ms" << std::endl;
+}
+
+// _________________________________________________________________________________________________
+void olu::osm::StatisticsHandler::printHistogram(const std::string_view description,
+                                                 const std::string_view unit,
+                                                 const util::Histogram &histogram) {
+    util::Logger::stream() << util::Logger::PREFIX_SPACER
+              << description << ": " << histogram.min() << " to " << histogram.max()
+              << " " << unit << ", " << static_cast<size_t>(histogram.mean())
+              << " on average" << std::endl;
+
+    for (const auto &[lowerBound, upperBound, count]: histogram.getBuckets()) {
+        util::Logger::stream() << util::Logger::PREFIX_SPACER
+                  << "  [" << lowerBound << ", " << upperBound << "] " << unit << ": "
+                  << count << std::endl;
+    }
+}
+
 // _________________________________________________________________________________________________
 void olu::osm::StatisticsHandler::printTimingStatistics() const {
     util::Logger::log(util::LogEvent::INFO, "Timing Statistics:");
@@ -170,6 +268,15 @@ void olu::osm::StatisticsHandler::printTimingStatistics() const {
     }
 
     long partTime;
+    if (!_config.indexBootstrapFile.empty()) {
+        partTime = getTimeInMSBuildingIndexes();
+        util::Logger::stream() << util::Logger::PREFIX_SPACER << "Building local indexes took "
+                << partTime
+                << " ms. ("
+                << calculatePercentageOfTotalTime(partTime) << "% of total time)"
+                << std::endl;
+    }
+
     if (_config.changeFileDir.empty()) {
         partTime = getTimeInMSDeterminingSequenceNumber();
         util::Logger::stream() << util::Logger::PREFIX_SPACER << "Determining sequence number took "
@@ -178,8 +285,11 @@ void olu::osm::StatisticsHandler::printTimingStatistics() const {
                 << calculatePercentageOfTotalTime(partTime) << "% of total time)"
                 << std::endl;
 
+        // When the change files are streamed, they are parsed while they are fetched
         partTime = getTimeInMSFetchingChangeFiles();
-        util::Logger::stream() << util::Logger::PREFIX_SPACER << "Fetching change files took "
+        util::Logger::stream() << util::Logger::PREFIX_SPACER
+                << (_config.streamChangeFiles ? "Fetching and parsing change files took "
+                                              : "Fetching change files took ")
                 << partTime
                 << " ms. ("
                 << calculatePercentageOfTotalTime(partTime) << "% of total time)"
@@ -193,9 +303,11 @@ void olu::osm::StatisticsHandler::printTimingStatistics() const {
             << calculatePercentageOfTotalTime(partTime) << "% of total time)"
             << std::endl;
 
+    // The boundaries are applied while the merged change file is written
     if (!_config.bbox.empty() || !_config.pathToPolygonFile.empty()) {
         partTime = getTimeInMSApplyingBoundaries();
-        util::Logger::stream() << util::Logger::PREFIX_SPACER << "Applying boundaries took "
+        util::Logger::stream() << util::Logger::PREFIX_SPACER
+                << "Applying boundaries (part of merging) took "
                 << partTime
                 << " ms. ("
                 << calculatePercentageOfTotalTime(partTime) << "% of total time)"
@@ -265,26 +377,76 @@ void olu::osm::StatisticsHandler::printTimingStatistics() const {
             << calculatePercentageOfTotalTime(partTime) << "% of total time)"
             << std::endl;
 
-    partTime = getTimeInMSDeletingTriples();
-    util::Logger::stream() << util::Logger::PREFIX_SPACER << "Deleting triples took "
-            << partTime
-            << " ms. ("
-            << calculatePercentageOfTotalTime(partTime) << "% of total time)"
-            << std::endl;
+    if (_config.interleaveUpdates) {
+        // The triples are filtered before they are deleted and inserted in combined updates
+        partTime = getTimeInMSFilteringTriples();
+        util::Logger::stream() << util::Logger::PREFIX_SPACER << "Filtering the triples took "
+                << partTime
+                << " ms. ("
+                << calculatePercentageOfTotalTime(partTime) << "% of total time)"
+                << std::endl;
 
-    partTime = getTimeInMSFilteringTriples();
-    util::Logger::stream() << util::Logger::PREFIX_SPACER << "Filtering the triples took "
-            << partTime
-            << " ms. ("
-            << calculatePercentageOfTotalTime(partTime) << "% of total time)"
-            << std::endl;
+        partTime = getTimeInMSDeletingTriples();
+        util::Logger::stream() << util::Logger::PREFIX_SPACER
+                << "Deleting and inserting triples in combined updates took "
+                << partTime
+                << " ms. ("
+                << calculatePercentageOfTotalTime(partTime) << "% of total time)"
+                << std::endl;
+    } else {
+        partTime = getTimeInMSDeletingTriples();
+        util::Logger::stream() << util::Logger::PREFIX_SPACER << "Deleting triples took "
+                << partTime
+                << " ms. ("
+                << calculatePercentageOfTotalTime(partTime) << "% of total time)"
+                << std::endl;
 
-    partTime = getTimeInMSInsertingTriples();
-    util::Logger::stream() << util::Logger::PREFIX_SPACER << "Inserting triples took "
-            << partTime
-            << " ms. ("
-            << calculatePercentageOfTotalTime(partTime) << "% of total time)"
-            << std::endl;
+        partTime = getTimeInMSDeletingDuringConversion();
+        util::Logger::stream() << util::Logger::PREFIX_SPACER << "Deleting triples and the osm2rdf "
+                   "conversion ran at the same time for "
+                << partTime
+                << " ms. ("
+                << calculatePercentageOfTotalTime(partTime) << "% of total time)"
+                << std::endl;
+
+        partTime = getTimeInMSFilteringTriples();
+        util::Logger::stream() << util::Logger::PREFIX_SPACER
+                << "Filtering the triples (while inserting) took "
+                << partTime
+                << " ms. ("
+                << calculatePercentageOfTotalTime(partTime) << "% of total time)"
+                << std::endl;
+
+        partTime = getTimeInMSInsertingTriples();
+        util::Logger::stream() << util::Logger::PREFIX_SPACER
+                << "Filtering and inserting triples took "
+                << partTime
+                << " ms. ("
+                << calculatePercentageOfTotalTime(partTime) << "% of total time)"
+                << std::endl;
+    }
+
+    if (!_criticalPath.empty()) {
+        util::Logger::stream() << util::Logger::PREFIX_SPACER
+                << "Critical path of the processing of the change files:" << std::endl;
+        for (const auto &stage: _criticalPath) {
+            partTime = stage.getTimeInMS();
+            util::Logger::stream() << util::Logger::PREFIX_SPACER << "  " << stage.name
+                    << " took " << partTime
+                    << " ms. ("
+                    << calculatePercentageOfTotalTime(partTime) << "% of total time)"
+                    << std::endl;
+        }
+    }
+
+    if (!_config.indexDir.empty()) {
+        partTime = getTimeInMSUpdatingIndexes();
+        util::Logger::stream() << util::Logger::PREFIX_SPACER << "Updating local indexes took "
+                << partTime
+                << " ms. ("
+                << calculatePercentageOfTotalTime(partTime) << "% of total time)"
+                << std::endl;
+    }
 
     partTime = getTimeInMSInsertingMetadataTriples();
     util::Logger::stream() << util::Logger::PREFIX_SPACER << "Inserting metadata triples took "
@@ -304,6 +466,7 @@ void olu::osm::StatisticsHandler::printTimingStatistics() const {
 // _________________________________________________________________________________________________
 void olu::osm::StatisticsHandler::countQleverResponseTime(const std::string_view &timeInMs) {
     const auto timeString = timeInMs.substr(0, timeInMs.size() - 2); // Remove trailing "ms"
+    std::lock_guard lock(_queryMutex);
     _qleverResponseTimeMs += std::stoi(std::string(timeString));
 }
 
@@ -574,6 +737,35 @@ void olu::osm::StatisticsHandler::logQLeverUpdateInfo(const simdjson::padded_str
     }
 }
 
+// _________________________________________________________________________________________________
+void olu::osm::StatisticsHandler::logQLeverUpdateResponse(const std::string &qleverResponse,
+                                                          const sparql::UpdateOperation &updateOp) {
+    // QLever answers with one object per operation of the update request. A separate parser is
+    // used, because `_parser` is needed to parse the single objects.
+    simdjson::ondemand::parser parser;
+    const simdjson::padded_string response(qleverResponse);
+    auto doc = parser.iterate(response);
+    std::vector<std::string_view> operations;
+    for (auto operation: doc.get_array()) {
+        std::string_view operationJson;
+        if (operation.raw_json().get(operationJson)) {
+            throw StatisticsHandlerException("Error while parsing qlever-update-response array.");
+        }
+        operations.push_back(operationJson);
+    }
+
+    for (size_t i = 0; i < operations.size(); ++i) {
+        // The insert operation of a combined update is the last operation
+        auto operationType = updateOp;
+        if (updateOp == sparql::UpdateOperation::DELETE_AND_INSERT) {
+            operationType = i + 1 == operations.size() ? sparql::UpdateOperation::INSERT
+                                                       : sparql::UpdateOperation::DELETE;
+        }
+
+        logQLeverUpdateInfo(simdjson::padded_string(operations[i]), operationType);
+    }
+}
+
 // _________________________________________________________________________________________________
 void olu::osm::StatisticsHandler::handleParsingObjectError(
     const simdjson::simdjson_result<simdjson::ondemand::field> &parsingResult,
@@ -0,0 +1,30 @@
+// Copyright 2025, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "osm/Way.h"
+
+#include "util/XmlHelper.h"
+
+// _________________________________________________________________________________________________
+olu::osm::Way::Way(const id_t id, member_ids_t members, const bool hasTag) :
+    id(id), members(std::move(members)), tagged(hasTag) { }
+
+// _________________________________________________________________________________________________
+std::string olu::osm::Way::getXml() const {
+    return util::XmlHelper::getWayDummy(id, members, tagged);
+}
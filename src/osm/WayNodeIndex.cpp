@@ -0,0 +1,94 @@
+// Copyright 2025, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "osm/WayNodeIndex.h"
+
+#include <algorithm>
+
+#include "config/Constants.h"
+#include "osm/OsmObjectHelper.h"
+
+namespace cnst = olu::config::constants;
+
+// _________________________________________________________________________________________________
+olu::osm::WayNodeIndex::WayNodeIndex(const std::filesystem::path &indexDir) :
+    _nodesOfWays(cnst::getPathToWayNodesIndex(indexDir)),
+    _waysOfNodes(cnst::getPathToNodeWaysIndex(indexDir)) { }
+
+// _________________________________________________________________________________________________
+void olu::osm::WayNodeIndex::way(const osmium::Way &way) {
+    if (_nodesOfWaysBuilder != nullptr) {
+        for (const auto &nodeRef: way.nodes()) {
+            _nodesOfWaysBuilder->add(way.id(), nodeRef.ref());
+            _waysOfNodesBuilder->add(nodeRef.ref(), way.id());
+        }
+        return;
+    }
+
+    if (!isBuilt()) {
+        return;
+    }
+
+    // Remove the node members of the way before the change
+    for (const auto &nodeId: _nodesOfWays.get(way.id())) {
+        _nodesOfWays.erase(way.id(), nodeId);
+        _waysOfNodes.erase(nodeId, way.id());
+    }
+
+    if (OsmObjectHelper::getChangeAction(way) == ChangeAction::DELETE) {
+        return;
+    }
+
+    for (const auto &nodeRef: way.nodes()) {
+        _nodesOfWays.insert(way.id(), nodeRef.ref());
+        _waysOfNodes.insert(nodeRef.ref(), way.id());
+    }
+}
+
+// _________________________________________________________________________________________________
+void olu::osm::WayNodeIndex::beginBuild() {
+    _nodesOfWaysBuilder = std::make_unique<util::PersistentMultiMap<id_t>::Builder>(_nodesOfWays);
+    _waysOfNodesBuilder = std::make_unique<util::PersistentMultiMap<id_t>::Builder>(_waysOfNodes);
+}
+
+// _________________________________________________________________________________________________
+void olu::osm::WayNodeIndex::endBuild() {
+    _nodesOfWaysBuilder->finish();
+    _waysOfNodesBuilder->finish();
+    _nodesOfWaysBuilder.reset();
+    _waysOfNodesBuilder.reset();
+}
+
+// _________________________________________________________________________________________________
+std::set<olu::id_t>
+olu::osm::WayNodeIndex::getWaysReferencingNodes(const std::set<id_t> &nodeIds) const {
+    std::set<id_t> wayIds;
+    for (const auto &nodeId: nodeIds) {
+        for (const auto &wayId: _waysOfNodes.get(nodeId)) {
+            wayIds.insert(wayId);
+        }
+    }
+
+    return wayIds;
+}
+
+// _________________________________________________________________________________________________
+void olu::osm::WayNodeIndex::commit() {
+    _nodesOfWays.commit();
+    _waysOfNodes.commit();
+}
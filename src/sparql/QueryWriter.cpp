@@ -47,6 +47,12 @@ olu::sparql::QueryWriter::writeInsertQuery(const std::vector<std::string>& tripl
     return tripleClause;
 }
 
+// _________________________________________________________________________________________________
+std::string
+olu::sparql::QueryWriter::writeInsertDataQuery(const std::vector<std::string>& triples) const {
+    return "INSERT DATA { " + wrapWithGraphOptional(writeInsertQuery(triples)) + "}";
+}
+
 // _________________________________________________________________________________________________
 std::string olu::sparql::QueryWriter::writeDeleteOsmObjectQuery(const osm::OsmObjectType &type,
                                                                 const std::set<id_t> &ids) const {
@@ -252,6 +258,20 @@ std::string olu::sparql::QueryWriter::writeDeleteTripleQuery(const std::vector<t
     return oss.str();
 }
 
+// _________________________________________________________________________________________________
+std::string
+olu::sparql::QueryWriter::writeUpdateSequence(const std::vector<std::string>& updates) {
+    std::string sequence;
+    for (const auto& update : updates) {
+        if (!sequence.empty()) {
+            sequence += " ; ";
+        }
+        sequence += update;
+    }
+
+    return sequence;
+}
+
 // _________________________________________________________________________________________________
 std::string
 olu::sparql::QueryWriter::writeQueryForNodeLocations(const std::set<id_t> &nodeIds) const {
@@ -24,15 +24,36 @@
 
 #include "simdjson/padded_string.h"
 
+#include "util/Exceptions.h"
 #include "util/URLHelper.h"
 #include "util/HttpRequest.h"
 #include "config/Constants.h"
 
 namespace cnst = olu::config::constants;
 
+namespace {
+    /**
+     * Clears the query and the prefixes when it goes out of scope, so that they do not leak into
+     * the next request, no matter how the current one ends.
+     */
+    class ClearQueryOnExit {
+    public:
+        ClearQueryOnExit(std::string &query, std::string &prefixes)
+            : _query(query), _prefixes(prefixes) {}
+        ~ClearQueryOnExit() { _query.clear(); _prefixes.clear(); }
+
+        ClearQueryOnExit(const ClearQueryOnExit &) = delete;
+        ClearQueryOnExit &operator=(const ClearQueryOnExit &) = delete;
+
+    private:
+        std::string &_query;
+        std::string &_prefixes;
+    };
+}
+
 // _________________________________________________________________________________________________
-void olu::sparql::SparqlWrapper::setQuery(const std::string &query) {
-    _query = query;
+void olu::sparql::SparqlWrapper::setQuery(std::string query) {
+    _query = std::move(query);
 }
 
 // _________________________________________________________________________________________________
@@ -43,56 +64,105 @@ void olu::sparql::SparqlWrapper::setPrefixes(const std::vector<std::string> &pre
 }
 
 // _________________________________________________________________________________________________
-std::string olu::sparql::SparqlWrapper::sendQuery() {
+void olu::sparql::SparqlWrapper::sendQuery(const std::function<void(std::string_view)> &onData) {
+    // Clear query and prefixes for the next request, also if the request or the processing of
+    // the response fails
+    const ClearQueryOnExit clearQuery(_query, _prefixes);
+
     if (_config.sparqlOutput == config::SparqlOutput::DEBUG_FILE) {
         writeQueryToFileOutput(false);
     }
 
     // Set the accept-value depending on whether we are using QLever or not.
     // QLever endpoints will return metadata with the results, while SPARQL results will only
-    // include the actual data.
-    const auto acceptValue = _config.isQLever
-                                 ? cnst::HTML_VALUE_ACCEPT_QLEVER_RESULT_JSON
-                                 : cnst::HTML_VALUE_ACCEPT_SPARQL_RESULT_JSON;
-
-    // Format and encode query
-    const std::string query = _prefixes + _query;
-    const std::string encodedQuery = util::URLHelper::encodeForUrlQuery(query);
+    // include the actual data. Tab-separated values only contain the data, but are smaller and
+    // faster to parse.
+    const auto acceptValue = _config.useTsvResults
+                                 ? cnst::HTML_VALUE_ACCEPT_TSV
+                                 : _config.isQLever
+                                       ? cnst::HTML_VALUE_ACCEPT_QLEVER_RESULT_JSON
+                                       : cnst::HTML_VALUE_ACCEPT_SPARQL_RESULT_JSON;
 
     auto request = util::HttpRequest(util::POST, _config.sparqlEndpointUri);
-    request.addHeader(cnst::HTML_KEY_CONTENT_TYPE, cnst::HTML_VALUE_CONTENT_TYPE);
     request.addHeader(cnst::HTML_KEY_ACCEPT, acceptValue);
     // We need to set this otherwise libcurl will wait 1 sec before sending the request
     request.addHeader("Expect", "");
 
-    std::string body = "query=" + encodedQuery;
-    body += _config.accessToken.empty() ? "" : "&access-token=" + _config.accessToken;
-    request.addBody(body);
+    if (_config.useFormEncoding) {
+        request.addHeader(cnst::HTML_KEY_CONTENT_TYPE, cnst::HTML_VALUE_CONTENT_TYPE);
+        buildFormBody(_body, "query");
+        if (!_config.accessToken.empty()) {
+            _body += "&access-token=" + _config.accessToken;
+        }
+    } else {
+        request.addHeader(cnst::HTML_KEY_CONTENT_TYPE, cnst::HTML_VALUE_CONTENT_TYPE_SPARQL_QUERY);
+        if (!_config.accessToken.empty()) {
+            request.addHeader(cnst::HTML_KEY_AUTHORIZATION, "Bearer " + _config.accessToken);
+        }
+        buildBody(_body);
+    }
 
-    std::string response;
+    if (const auto encoding = compressBody(_body, _compressedBody, _lastQueryCompression);
+        encoding != util::CompressionType::NONE) {
+        request.addHeader(cnst::HTML_KEY_CONTENT_ENCODING,
+                          std::string(util::Compressor::getContentEncoding(encoding)));
+        request.acceptCompressedResponses();
+        request.addBodyReference(_compressedBody);
+    } else {
+        request.addBodyReference(_body);
+    }
+
+    // Exceptions thrown while the response is processed are passed on unchanged
     try {
-        response = request.perform();
-    } catch(std::exception &e) {
+        request.perform(onData);
+    } catch(util::HttpRequestException &e) {
         std::cerr << e.what() << std::endl;
         const std::string msg = "Exception while sending `POST` request to the sparql endpoint with"
-                                " body: " + query.substr(0, 100);
-        throw SparqlWrapperException(msg.c_str());
+                                " body: " + (_prefixes + _query).substr(0, 100);
+        throwRequestException(e, msg);
     }
-
-    // Clear query and prefixes for the next request
-    _query = ""; _prefixes = "";
-    return response;
 }
 
 // _________________________________________________________________________________________________
-std::string olu::sparql::SparqlWrapper::sendUpdate(const UpdateOperation &updateOp) {
+void olu::sparql::SparqlWrapper::prepareUpdate(const UpdateOperation &updateOp,
+                                               PreparedUpdate &update) {
+    // Clear query and prefixes for the next request
+    const ClearQueryOnExit clearQuery(_query, _prefixes);
+
     if (_config.sparqlOutput == config::SparqlOutput::DEBUG_FILE ||
         _config.sparqlOutput == config::SparqlOutput::FILE) {
         writeQueryToFileOutput(updateOp == UpdateOperation::INSERT);
     }
 
+    update.updateOp = updateOp;
+    switch (updateOp) {
+        case UpdateOperation::INSERT:
+            // We use Graph store HTTP protocol for INSERT operations (POST with data)
+            update.contentType = cnst::HTML_VALUE_CONTENT_TYPE_TURTLE;
+            buildBody(update.body);
+            break;
+        case UpdateOperation::DELETE:
+        case UpdateOperation::DELETE_AND_INSERT:
+            if (_config.useFormEncoding) {
+                update.contentType = cnst::HTML_VALUE_CONTENT_TYPE;
+                buildFormBody(update.body, "update");
+            } else {
+                update.contentType = cnst::HTML_VALUE_CONTENT_TYPE_SPARQL_UPDATE;
+                buildBody(update.body);
+            }
+            break;
+    }
+    update.encoding = compressBody(update.body, update.compressedBody, update.compression);
+}
+
+// _________________________________________________________________________________________________
+std::string olu::sparql::SparqlWrapper::runUpdate(const PreparedUpdate &update) const {
+    if (_config.sparqlOutput != config::SparqlOutput::ENDPOINT) {
+        return "";
+    }
+
     std::string url = _config.sparqlEndpointUriForUpdates;
-    if (updateOp == UpdateOperation::INSERT) {
+    if (update.updateOp == UpdateOperation::INSERT) {
         // For INSERT operations, we use the Graph store HTTP protocol, where the graph URI is
         // specified as a parameter in the body.
         url += _config.graphUri.empty() ? "?default" : "?graph=" + util::URLHelper::encodeForUrlQuery(_config.graphUri);
@@ -115,50 +185,99 @@ std::string olu::sparql::SparqlWrapper::sendUpdate(const UpdateOperation &update
         request.addHeader(cnst::HTML_KEY_AUTHORIZATION, "Bearer " + _config.accessToken);
     }
 
-    std::string body = _prefixes + _query;
-    switch (updateOp) {
-        case UpdateOperation::INSERT:
-            // We use Graph store HTTP protocol for INSERT operations (POST with data)
-            request.addHeader(cnst::HTML_KEY_CONTENT_TYPE, cnst::HTML_VALUE_CONTENT_TYPE_TURTLE);
-            request.addBody(body);
-            break;
-        case UpdateOperation::DELETE:
-            request.addHeader(cnst::HTML_KEY_CONTENT_TYPE, cnst::HTML_VALUE_CONTENT_TYPE);
-            body = "update=" + util::URLHelper::encodeForUrlQuery(body);
-            request.addBody(body);
-            break;
+    request.addHeader(cnst::HTML_KEY_CONTENT_TYPE, std::string(update.contentType));
+    if (update.encoding != util::CompressionType::NONE) {
+        request.addHeader(cnst::HTML_KEY_CONTENT_ENCODING,
+                          std::string(util::Compressor::getContentEncoding(update.encoding)));
+        request.acceptCompressedResponses();
+        request.addBodyReference(update.compressedBody);
+    } else {
+        request.addBodyReference(update.body);
     }
 
     std::string response;
     try {
-        if (_config.sparqlOutput == config::SparqlOutput::ENDPOINT) {
-            response = request.perform();
-        }
+        response = request.perform();
+    } catch(util::HttpRequestException &e) {
+        std::cerr << e.what() << std::endl;
+        throwRequestException(e, "Exception while sending `POST` request to the sparql endpoint");
     } catch(std::exception &e) {
         std::cerr << e.what() << std::endl;
         const std::string msg = "Exception while sending `POST` request to the sparql endpoint";
         throw SparqlWrapperException(msg.c_str());
     }
 
-    // Clear query and prefixes for the next request
-    _query = ""; _prefixes = "";
     return response;
 }
 
+// _________________________________________________________________________________________________
+void olu::sparql::SparqlWrapper::throwRequestException(const util::HttpRequestException &e,
+                                                       const std::string &msg) {
+    // The request might succeed for a smaller batch if it timed out, if its body was too large
+    // or if the endpoint failed while processing it
+    if (const auto httpCode = e.getHttpCode();
+        e.isTimeout() || httpCode == 408 || httpCode == 413 || httpCode >= 500) {
+        throw util::BatchTooLargeException(msg.c_str());
+    }
+    throw SparqlWrapperException(msg.c_str());
+}
+
+// _________________________________________________________________________________________________
+void olu::sparql::SparqlWrapper::buildBody(std::string &body) const {
+    body.clear();
+    body.reserve(_prefixes.size() + _query.size());
+    body.append(_prefixes).append(_query);
+}
+
+// _________________________________________________________________________________________________
+void olu::sparql::SparqlWrapper::buildFormBody(std::string &body,
+                                               const std::string_view key) const {
+    body.clear();
+    body.append(key).append("=");
+    util::URLHelper::appendEncodedForUrlQuery(body, _prefixes);
+    util::URLHelper::appendEncodedForUrlQuery(body, _query);
+}
+
+// _________________________________________________________________________________________________
+olu::util::CompressionType
+olu::sparql::SparqlWrapper::compressBody(const std::string &body, std::string &compressedBody,
+                                         util::CompressionInfo &info) {
+    if (_compressor.getType() == util::CompressionType::NONE ||
+        _config.sparqlOutput != config::SparqlOutput::ENDPOINT) {
+        info = {};
+        return util::CompressionType::NONE;
+    }
+
+    info = _compressor.compress(body, compressedBody);
+    return _compressor.getType();
+}
+
 // _________________________________________________________________________________________________
 std::string olu::sparql::SparqlWrapper::runUpdate(const UpdateOperation &updateOp) {
-    return sendUpdate(updateOp);
+    prepareUpdate(updateOp, _update);
+    return runUpdate(_update);
 }
 
 // _________________________________________________________________________________________________
 std::string olu::sparql::SparqlWrapper::runQuery() {
-    const auto response = sendQuery();
+    std::string response;
+    runQuery([&response](const std::string_view chunk) {
+        response.append(chunk);
+    });
+    return response;
+}
 
-    if (response.empty()) {
+// _________________________________________________________________________________________________
+void olu::sparql::SparqlWrapper::runQuery(const std::function<void(std::string_view)> &onData) {
+    size_t responseSize = 0;
+    sendQuery([&onData, &responseSize](const std::string_view chunk) {
+        responseSize += chunk.size();
+        onData(chunk);
+    });
+
+    if (responseSize == 0) {
         throw SparqlWrapperException("Empty response from SPARQL endpoint");
     }
-
-    return response;
 }
 
 // _________________________________________________________________________________________________
@@ -0,0 +1,72 @@
+// Copyright 2025, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "util/AdaptiveBatchSize.h"
+
+#include <algorithm>
+
+// _________________________________________________________________________________________________
+olu::util::AdaptiveBatchSize::AdaptiveBatchSize(const size_t batchSize, const bool adaptive):
+    _adaptive(adaptive),
+    _maxSize(std::max<size_t>(batchSize, 1) * (adaptive ? MAX_SIZE_FACTOR : 1)),
+    _size(std::max<size_t>(batchSize, 1)),
+    _step(std::max<size_t>(_size / STEP_DIVISOR, 1)) { }
+
+// _________________________________________________________________________________________________
+size_t olu::util::AdaptiveBatchSize::get() const {
+    std::lock_guard lock(_mutex);
+    return _size;
+}
+
+// _________________________________________________________________________________________________
+void olu::util::AdaptiveBatchSize::onSuccess(const size_t numOfElements,
+                                             const std::chrono::nanoseconds duration) {
+    std::lock_guard lock(_mutex);
+    if (!_adaptive || numOfElements == 0 || numOfElements < _size) {
+        return;
+    }
+
+    const double nsPerElement = static_cast<double>(duration.count())
+                                / static_cast<double>(numOfElements);
+    if (_nsPerElement == 0 || nsPerElement <= _nsPerElement * (1 + LATENCY_TOLERANCE)) {
+        _size = std::min(_size + _step, _maxSize);
+    } else {
+        _size = _size > _step ? _size - _step : 1;
+    }
+    _nsPerElement = nsPerElement;
+}
+
+// _________________________________________________________________________________________________
+void olu::util::AdaptiveBatchSize::onFailure(const size_t numOfElements) {
+    std::lock_guard lock(_mutex);
+    _numOfFailures++;
+    if (!_adaptive) {
+        return;
+    }
+
+    _size = std::max<size_t>(std::min(_size, numOfElements) / 2, 1);
+    _step = std::max<size_t>(_size / STEP_DIVISOR, 1);
+    // The time per element is measured again for the smaller size
+    _nsPerElement = 0;
+}
+
+// _________________________________________________________________________________________________
+size_t olu::util::AdaptiveBatchSize::getNumOfFailures() const {
+    std::lock_guard lock(_mutex);
+    return _numOfFailures;
+}
@@ -0,0 +1,166 @@
+// Copyright 2025, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "util/Compressor.h"
+
+#include <zlib.h>
+
+#ifdef OLU_WITH_ZSTD
+#include <zstd.h>
+#endif
+
+// _________________________________________________________________________________________________
+olu::util::Compressor::Compressor(const CompressionType type) : _type(type) {
+    switch (_type) {
+        case CompressionType::NONE:
+            break;
+        case CompressionType::GZIP:
+            _gzipStream = std::make_unique<z_stream>();
+            // 15 window bits plus 16 writes a gzip header and trailer instead of a zlib wrapper
+            if (deflateInit2(_gzipStream.get(), GZIP_LEVEL, Z_DEFLATED, 15 + 16, 8,
+                             Z_DEFAULT_STRATEGY) != Z_OK) {
+                _gzipStream.reset();
+                throw CompressorException("Failed to initialize the gzip compression.");
+            }
+            break;
+        case CompressionType::ZSTD:
+#ifdef OLU_WITH_ZSTD
+            _zstdContext = ZSTD_createCCtx();
+            if (_zstdContext == nullptr) {
+                throw CompressorException("Failed to initialize the zstd compression.");
+            }
+            ZSTD_CCtx_setParameter(_zstdContext, ZSTD_c_compressionLevel, ZSTD_LEVEL);
+            break;
+#else
+            throw CompressorException("zstd compression is not supported by this build.");
+#endif
+    }
+}
+
+// _________________________________________________________________________________________________
+olu::util::Compressor::~Compressor() {
+    if (_gzipStream) {
+        deflateEnd(_gzipStream.get());
+    }
+
+#ifdef OLU_WITH_ZSTD
+    ZSTD_freeCCtx(_zstdContext);
+#endif
+}
+
+// _________________________________________________________________________________________________
+olu::util::CompressionType olu::util::Compressor::typeFromString(const std::string_view name) {
+    if (name.empty()) {
+        return CompressionType::NONE;
+    }
+
+    if (name == "gzip") {
+        return CompressionType::GZIP;
+    }
+
+    if (name == "zstd") {
+        return CompressionType::ZSTD;
+    }
+
+    const std::string msg = "Unknown compression: " + std::string(name);
+    throw CompressorException(msg.c_str());
+}
+
+// _________________________________________________________________________________________________
+bool olu::util::Compressor::isSupported(const CompressionType type) {
+    if (type == CompressionType::ZSTD) {
+#ifdef OLU_WITH_ZSTD
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    return true;
+}
+
+// _________________________________________________________________________________________________
+std::string_view olu::util::Compressor::getContentEncoding(const CompressionType type) {
+    switch (type) {
+        case CompressionType::GZIP:
+            return "gzip";
+        case CompressionType::ZSTD:
+            return "zstd";
+        default:
+            return "";
+    }
+}
+
+// _________________________________________________________________________________________________
+olu::util::CompressionInfo olu::util::Compressor::compress(const std::string_view input,
+                                                           std::string &output) {
+    const auto start = std::chrono::steady_clock::now();
+    switch (_type) {
+        case CompressionType::NONE:
+            output.assign(input);
+            break;
+        case CompressionType::GZIP:
+            compressGzip(input, output);
+            break;
+        case CompressionType::ZSTD:
+            compressZstd(input, output);
+            break;
+    }
+
+    return {input.size(), output.size(), std::chrono::steady_clock::now() - start};
+}
+
+// _________________________________________________________________________________________________
+void olu::util::Compressor::compressGzip(const std::string_view input, std::string &output) {
+    if (deflateReset(_gzipStream.get()) != Z_OK) {
+        throw CompressorException("Failed to reset the gzip compression.");
+    }
+
+    // The bound is large enough to compress the input with a single call of deflate
+    output.resize(deflateBound(_gzipStream.get(), input.size()));
+    _gzipStream->next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+    _gzipStream->avail_in = static_cast<uInt>(input.size());
+    _gzipStream->next_out = reinterpret_cast<Bytef*>(output.data());
+    _gzipStream->avail_out = static_cast<uInt>(output.size());
+
+    if (deflate(_gzipStream.get(), Z_FINISH) != Z_STREAM_END) {
+        throw CompressorException("Failed to compress the body with gzip.");
+    }
+
+    output.resize(_gzipStream->total_out);
+}
+
+// _________________________________________________________________________________________________
+void olu::util::Compressor::compressZstd(const std::string_view input, std::string &output) {
+#ifdef OLU_WITH_ZSTD
+    output.resize(ZSTD_compressBound(input.size()));
+    const size_t size = ZSTD_compress2(_zstdContext, output.data(), output.size(),
+                                       input.data(), input.size());
+    if (ZSTD_isError(size)) {
+        const std::string msg = "Failed to compress the body with zstd: "
+                                + std::string(ZSTD_getErrorName(size));
+        throw CompressorException(msg.c_str());
+    }
+
+    output.resize(size);
+#else
+    (void) input;
+    (void) output;
+    throw CompressorException("zstd compression is not supported by this build.");
+#endif
+}
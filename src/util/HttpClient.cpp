@@ -0,0 +1,145 @@
+// Copyright 2025, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "util/HttpClient.h"
+
+// _________________________________________________________________________________________________
+olu::util::HttpClient::HttpClient() {
+    if (curl_global_init(CURL_GLOBAL_DEFAULT) != CURLE_OK) {
+        throw HttpClientException("Failed to initialize libcurl");
+    }
+
+    _share = curl_share_init();
+    if (_share == nullptr) {
+        throw HttpClientException("Failed to initialize the curl share");
+    }
+
+    curl_share_setopt(_share, CURLSHOPT_LOCKFUNC, lockShare);
+    curl_share_setopt(_share, CURLSHOPT_UNLOCKFUNC, unlockShare);
+    curl_share_setopt(_share, CURLSHOPT_USERDATA, this);
+    // libcurl does not support sharing the connection cache between threads, so each easy
+    // handle keeps its own connections
+    curl_share_setopt(_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+    curl_share_setopt(_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+}
+
+// _________________________________________________________________________________________________
+olu::util::HttpClient::~HttpClient() {
+    // The handles have to be cleaned up before the share they are using
+    for (CURL* handle: _freeHandles) {
+        curl_easy_cleanup(handle);
+    }
+    curl_share_cleanup(_share);
+    curl_global_cleanup();
+}
+
+// _________________________________________________________________________________________________
+olu::util::HttpClient &olu::util::HttpClient::instance() {
+    static HttpClient client;
+    return client;
+}
+
+// _________________________________________________________________________________________________
+void olu::util::HttpClient::setUseHttp2(const bool useHttp2) {
+    instance()._useHttp2 = useHttp2;
+}
+
+// _________________________________________________________________________________________________
+CURL* olu::util::HttpClient::acquireHandle() {
+    HttpClient &client = instance();
+    {
+        std::lock_guard lock(client._poolMutex);
+        if (!client._freeHandles.empty()) {
+            CURL* handle = client._freeHandles.back();
+            client._freeHandles.pop_back();
+            client.configureHandle(handle);
+            return handle;
+        }
+    }
+
+    CURL* handle = curl_easy_init();
+    if (handle == nullptr) {
+        throw HttpClientException("Failed to initialize CURL");
+    }
+    client.configureHandle(handle);
+    return handle;
+}
+
+// _________________________________________________________________________________________________
+void olu::util::HttpClient::releaseHandle(CURL* handle) {
+    if (handle == nullptr) {
+        return;
+    }
+
+    // Resetting the handle removes all options, but keeps its open connections
+    curl_easy_reset(handle);
+
+    HttpClient &client = instance();
+    std::lock_guard lock(client._poolMutex);
+    client._freeHandles.push_back(handle);
+}
+
+// _________________________________________________________________________________________________
+void olu::util::HttpClient::countRequest(CURL* handle) {
+    long numOfConnections = 0;
+    curl_easy_getinfo(handle, CURLINFO_NUM_CONNECTS, &numOfConnections);
+
+    HttpClient &client = instance();
+    ++client._numOfRequests;
+    client._numOfConnections += static_cast<size_t>(numOfConnections);
+}
+
+// _________________________________________________________________________________________________
+size_t olu::util::HttpClient::getNumOfRequests() {
+    return instance()._numOfRequests;
+}
+
+// _________________________________________________________________________________________________
+size_t olu::util::HttpClient::getNumOfConnections() {
+    return instance()._numOfConnections;
+}
+
+// _________________________________________________________________________________________________
+size_t olu::util::HttpClient::getNumOfRequestsWithoutNewConnection() {
+    const size_t requests = getNumOfRequests();
+    const size_t connections = getNumOfConnections();
+    return requests > connections ? requests - connections : 0;
+}
+
+// _________________________________________________________________________________________________
+void olu::util::HttpClient::configureHandle(CURL* handle) const {
+    curl_easy_setopt(handle, CURLOPT_SHARE, _share);
+    curl_easy_setopt(handle, CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt(handle, CURLOPT_NOSIGNAL, 1L);
+
+    if (_useHttp2) {
+        curl_easy_setopt(handle, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+    }
+}
+
+// _________________________________________________________________________________________________
+void olu::util::HttpClient::lockShare(CURL* /*handle*/, const curl_lock_data data,
+                                      curl_lock_access /*access*/, void* userptr) {
+    static_cast<HttpClient*>(userptr)->_shareLocks[data].lock();
+}
+
+// _________________________________________________________________________________________________
+void olu::util::HttpClient::unlockShare(CURL* /*handle*/, const curl_lock_data data,
+                                        void* userptr) {
+    static_cast<HttpClient*>(userptr)->_shareLocks[data].unlock();
+}
@@ -0,0 +1,173 @@
+// Copyright 2025, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "util/HttpDownloader.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+
+#include <curl/curl.h>
+
+#include "util/HttpClient.h"
+#include "util/Logger.h"
+
+namespace {
+    // Transfer that is currently in flight
+    struct Transfer {
+        size_t index;
+        CURL* handle;
+        // Null if the body is kept in memory
+        FILE* file;
+    };
+
+    // _____________________________________________________________________________________________
+    size_t WriteFileCallback(void* contents, const size_t size, const size_t nmemb, void* userp) {
+        return std::fwrite(contents, size, nmemb, static_cast<FILE*>(userp)) * size;
+    }
+
+    // _____________________________________________________________________________________________
+    size_t WriteMemoryCallback(void* contents, const size_t size, const size_t nmemb,
+                               void* userp) {
+        static_cast<std::string*>(userp)->append(static_cast<char*>(contents), size * nmemb);
+        return size * nmemb;
+    }
+}
+
+// _________________________________________________________________________________________________
+olu::util::HttpDownloader::HttpDownloader(const size_t maxConcurrentDownloads):
+    _maxConcurrentDownloads(std::max<size_t>(maxConcurrentDownloads, 1)) { }
+
+// _________________________________________________________________________________________________
+void olu::util::HttpDownloader::run(const std::vector<Download> &downloads,
+                                    const completion_callback_t &onComplete) const {
+    const std::unique_ptr<CURLM, decltype(&curl_multi_cleanup)> multi(curl_multi_init(),
+                                                                       curl_multi_cleanup);
+    if (multi == nullptr) {
+        throw HttpDownloaderException("Failed to initialize CURL multi handle");
+    }
+
+    std::vector<Transfer> transfers;
+    const auto finishTransfer = [&multi, &transfers](const CURL* handle) {
+        const auto it = std::ranges::find(transfers, handle, &Transfer::handle);
+        curl_multi_remove_handle(multi.get(), it->handle);
+        HttpClient::countRequest(it->handle);
+        HttpClient::releaseHandle(it->handle);
+        if (it->file != nullptr) {
+            std::fclose(it->file);
+        }
+        const size_t index = it->index;
+        transfers.erase(it);
+        return index;
+    };
+    const auto abortTransfers = [&finishTransfer, &transfers] {
+        while (!transfers.empty()) {
+            finishTransfer(transfers.back().handle);
+        }
+    };
+
+    // Bodies that are kept in memory, until they are passed to `onComplete`
+    std::vector<std::string> bodies(downloads.size());
+
+    size_t nextToStart = 0;
+    const auto startTransfer = [&] {
+        const auto &[url, path] = downloads[nextToStart];
+        FILE* file = nullptr;
+        if (!path.empty()) {
+            file = std::fopen(path.c_str(), "wb");
+            if (file == nullptr) {
+                const std::string msg = "Failed to open file for download: " + path.string();
+                throw HttpDownloaderException(msg.c_str());
+            }
+        }
+
+        CURL* handle = HttpClient::acquireHandle();
+        curl_easy_setopt(handle, CURLOPT_URL, url.c_str());
+        if (file != nullptr) {
+            curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, WriteFileCallback);
+            curl_easy_setopt(handle, CURLOPT_WRITEDATA, file);
+        } else {
+            curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, WriteMemoryCallback);
+            curl_easy_setopt(handle, CURLOPT_WRITEDATA, &bodies[nextToStart]);
+        }
+        curl_easy_setopt(handle, CURLOPT_FOLLOWLOCATION, 1L);
+        curl_easy_setopt(handle, CURLOPT_FAILONERROR, true);
+        // Wait for a connection that can be multiplexed instead of opening a new one
+        curl_easy_setopt(handle, CURLOPT_PIPEWAIT, 1L);
+
+        transfers.push_back({nextToStart++, handle, file});
+        curl_multi_add_handle(multi.get(), handle);
+    };
+
+    // A download is only reported once all downloads with a smaller index are reported
+    std::vector<bool> isDone(downloads.size(), false);
+    size_t nextToReport = 0;
+
+    try {
+        while (nextToReport < downloads.size()) {
+            // Finished downloads that wait for an earlier one count against the limit as well,
+            // so at most `_maxConcurrentDownloads` bodies are kept in memory
+            while (nextToStart - nextToReport < _maxConcurrentDownloads &&
+                   nextToStart < downloads.size()) {
+                startTransfer();
+            }
+
+            int running = 0;
+            if (const CURLMcode code = curl_multi_perform(multi.get(), &running);
+                code != CURLM_OK) {
+                throw HttpDownloaderException(curl_multi_strerror(code));
+            }
+
+            int messagesLeft = 0;
+            while (const CURLMsg* message = curl_multi_info_read(multi.get(), &messagesLeft)) {
+                if (message->msg != CURLMSG_DONE) {
+                    continue;
+                }
+
+                CURL* handle = message->easy_handle;
+                if (const CURLcode result = message->data.result; result != CURLE_OK) {
+                    long httpCode = 0;
+                    curl_easy_getinfo(handle, CURLINFO_RESPONSE_CODE, &httpCode);
+                    const size_t index = finishTransfer(handle);
+
+                    Logger::log(LogEvent::ERROR, "GET failed with reason: "
+                                                 + std::string(curl_easy_strerror(result)));
+                    Logger::stream() << Logger::PREFIX_SPACER << "HTTP Code: " << httpCode
+                                     << std::endl;
+                    Logger::stream() << Logger::PREFIX_SPACER << "URL: " << downloads[index].url
+                                     << std::endl;
+                    throw HttpDownloaderException(std::to_string(httpCode).c_str());
+                }
+
+                isDone[finishTransfer(handle)] = true;
+            }
+
+            for (; nextToReport < downloads.size() && isDone[nextToReport]; ++nextToReport) {
+                onComplete(nextToReport, bodies[nextToReport]);
+                std::string().swap(bodies[nextToReport]);
+            }
+
+            if (running > 0) {
+                curl_multi_poll(multi.get(), nullptr, 0, 1000, nullptr);
+            }
+        }
+    } catch (...) {
+        abortTransfers();
+        throw;
+    }
+}
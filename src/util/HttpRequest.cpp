@@ -20,9 +20,9 @@
 
 #include <iostream>
 #include <fstream>
-#include <cstring>
 
 #include "curl/curl.h"
+#include "util/HttpClient.h"
 #include "util/Logger.h"
 
 static inline constexpr std::string_view PREFIX_SPACER = "                          ";
@@ -34,7 +34,6 @@ static size_t WriteMemoryCallback(void* contents, const size_t size, const size_
     const size_t realSize = size * nmemb;
     auto& mem = *static_cast<std::string*>(userp);
     mem.append(static_cast<char*>(contents), realSize);
-    memset(contents, 0, realSize);
     return realSize;
 }
 
@@ -52,7 +51,7 @@ void setup_curl(CURL* curl_handle, std::string& data, const std::string& url)
 
 // _________________________________________________________________________________________________
 olu::util::HttpRequest::HttpRequest(const HttpMethod& method, const std::string& url) {
-    _curl = curl_easy_init();
+    _curl = HttpClient::acquireHandle();
     _method = method;
     _res = CURLE_FAILED_INIT;
     _url = url;
@@ -61,7 +60,7 @@ olu::util::HttpRequest::HttpRequest(const HttpMethod& method, const std::string&
 
 // _________________________________________________________________________________________________
 olu::util::HttpRequest::~HttpRequest() {
-    curl_easy_cleanup(_curl);
+    HttpClient::releaseHandle(_curl);
     curl_slist_free_all(_chunk);
 }
 
@@ -74,26 +73,74 @@ void olu::util::HttpRequest::addHeader(const std::string& key, const std::string
 // _________________________________________________________________________________________________
 void olu::util::HttpRequest::addBody(std::string body) {
     _body = std::move(body);
+    _bodyReference = _body;
+}
+
+// _________________________________________________________________________________________________
+void olu::util::HttpRequest::addBodyReference(const std::string_view body) {
+    _bodyReference = body;
+}
+
+// _________________________________________________________________________________________________
+void olu::util::HttpRequest::acceptCompressedResponses() {
+    // An empty string lets curl send all encodings it was built with in the "Accept-Encoding"
+    // header
+    curl_easy_setopt(_curl, CURLOPT_ACCEPT_ENCODING, "");
+}
+
+// _________________________________________________________________________________________________
+size_t olu::util::HttpRequest::streamCallback(void* contents, const size_t size, const size_t nmemb,
+                                              void* userp) {
+    const size_t realSize = size * nmemb;
+    auto& request = *static_cast<HttpRequest*>(userp);
+    try {
+        (*request._onData)(std::string_view(static_cast<char*>(contents), realSize));
+    } catch (...) {
+        // Exceptions must not pass through curl, returning less than the received size aborts
+        // the transfer
+        request._onDataError = std::current_exception();
+        return 0;
+    }
+    return realSize;
 }
 
 // _________________________________________________________________________________________________
 std::string olu::util::HttpRequest::perform() {
-    std::string response;
+    performRequest();
+    return std::move(_data);
+}
+
+// _________________________________________________________________________________________________
+void olu::util::HttpRequest::perform(const std::function<void(std::string_view)> &onData) {
+    _onData = &onData;
+    curl_easy_setopt(_curl, CURLOPT_WRITEFUNCTION, streamCallback);
+    curl_easy_setopt(_curl, CURLOPT_WRITEDATA, this);
+    performRequest();
+}
+
+// _________________________________________________________________________________________________
+void olu::util::HttpRequest::performRequest() {
     curl_easy_setopt(_curl, CURLOPT_HTTPHEADER, _chunk);
 
     if (_method == POST) {
         curl_easy_setopt(_curl,CURLOPT_POST,1L);
-        curl_easy_setopt(_curl, CURLOPT_POSTFIELDS, _body.c_str());
-        curl_easy_setopt(_curl, CURLOPT_POSTFIELDSIZE, _body.length());
+        // curl does not copy the body, it is sent directly from our buffer
+        curl_easy_setopt(_curl, CURLOPT_POSTFIELDS, _bodyReference.data());
+        curl_easy_setopt(_curl, CURLOPT_POSTFIELDSIZE_LARGE,
+                         static_cast<curl_off_t>(_bodyReference.size()));
     }
 
     if(_curl != nullptr) {
         _res = curl_easy_perform(_curl);
-        response = _data;
+        HttpClient::countRequest(_curl);
     } else {
         throw HttpRequestException("Failed to initialize CURL");
     }
 
+    if (_onDataError) {
+        std::rethrow_exception(_onDataError);
+    }
+
     if (_res != CURLE_OK) {
         const std::string reason = curl_easy_strerror(_res);
         long http_code = 0;
@@ -109,8 +156,7 @@ std::string olu::util::HttpRequest::perform() {
             Logger::stream() << PREFIX_SPACER << "URL: " << _url << std::endl;
         }
 
-        throw HttpRequestException(std::to_string(http_code).c_str());
+        throw HttpRequestException(std::to_string(http_code).c_str(), http_code,
+                                   _res == CURLE_OPERATION_TIMEDOUT);
     }
-
-    return response;
-}
\ No newline at end of file
+}
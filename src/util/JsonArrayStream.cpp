@@ -0,0 +1,186 @@
+// Copyright 2025, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "util/JsonArrayStream.h"
+
+// _________________________________________________________________________________________________
+static bool isWhitespace(const char c) {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+// _________________________________________________________________________________________________
+olu::util::JsonArrayStream::JsonArrayStream(std::string key, element_callback_t onElement,
+                                            const size_t padding):
+    _key(std::move(key)), _onElement(std::move(onElement)), _padding(padding) { }
+
+// _________________________________________________________________________________________________
+void olu::util::JsonArrayStream::feed(const std::string_view chunk) {
+    for (const char c: chunk) {
+        switch (_mode) {
+            case Mode::BEFORE_ARRAY:
+                scanBeforeArray(c);
+                break;
+            case Mode::IN_ARRAY:
+                scanInArray(c);
+                break;
+            case Mode::IN_ELEMENT:
+                scanInElement(c);
+                break;
+            case Mode::AFTER_ARRAY:
+                _rest += c;
+                break;
+        }
+    }
+}
+
+// _________________________________________________________________________________________________
+void olu::util::JsonArrayStream::scanString(const char c, std::string &output) {
+    output += c;
+    if (_isEscaped) {
+        _isEscaped = false;
+    } else if (c == '\\') {
+        _isEscaped = true;
+    } else if (c == '"') {
+        _isInString = false;
+    }
+}
+
+// _________________________________________________________________________________________________
+void olu::util::JsonArrayStream::scanBeforeArray(const char c) {
+    if (_isInString) {
+        scanString(c, _rest);
+        if (!_isInString) {
+            _keyState = _currentString == _key ? KeyState::KEY : KeyState::NONE;
+        } else if (_currentString.size() <= _key.size()) {
+            _currentString += c;
+        }
+        return;
+    }
+
+    _rest += c;
+    if (isWhitespace(c)) {
+        return;
+    }
+
+    switch (c) {
+        case '"':
+            _isInString = true;
+            _currentString.clear();
+            _keyState = KeyState::NONE;
+            break;
+        case ':':
+            _keyState = _keyState == KeyState::KEY ? KeyState::COLON : KeyState::NONE;
+            break;
+        case '[':
+            ++_depth;
+            if (_keyState == KeyState::COLON) {
+                _mode = Mode::IN_ARRAY;
+                _arrayDepth = _depth;
+            }
+            _keyState = KeyState::NONE;
+            break;
+        case '{':
+            ++_depth;
+            _keyState = KeyState::NONE;
+            break;
+        case '}':
+        case ']':
+            --_depth;
+            _keyState = KeyState::NONE;
+            break;
+        default:
+            _keyState = KeyState::NONE;
+            break;
+    }
+}
+
+// _________________________________________________________________________________________________
+void olu::util::JsonArrayStream::scanInArray(const char c) {
+    if (isWhitespace(c) || c == ',') {
+        return;
+    }
+
+    if (c == ']') {
+        --_depth;
+        _rest += c;
+        _mode = Mode::AFTER_ARRAY;
+        return;
+    }
+
+    _mode = Mode::IN_ELEMENT;
+    _element.clear();
+    scanInElement(c);
+}
+
+// _________________________________________________________________________________________________
+void olu::util::JsonArrayStream::scanInElement(const char c) {
+    if (_isInString) {
+        scanString(c, _element);
+        return;
+    }
+
+    switch (c) {
+        case '"':
+            _isInString = true;
+            _element += c;
+            break;
+        case '[':
+        case '{':
+            ++_depth;
+            _element += c;
+            break;
+        case ']':
+        case '}':
+            if (_depth == _arrayDepth) {
+                // End of the array after a scalar element
+                emitElement();
+                scanInArray(c);
+                return;
+            }
+
+            --_depth;
+            _element += c;
+            if (_depth == _arrayDepth) {
+                emitElement();
+            }
+            break;
+        case ',':
+            if (_depth == _arrayDepth) {
+                // End of a scalar element
+                emitElement();
+            } else {
+                _element += c;
+            }
+            break;
+        default:
+            if (_depth > _arrayDepth || !isWhitespace(c)) {
+                _element += c;
+            }
+            break;
+    }
+}
+
+// _________________________________________________________________________________________________
+void olu::util::JsonArrayStream::emitElement() {
+    _mode = Mode::IN_ARRAY;
+    ++_numOfElements;
+    if (_element.capacity() < _element.size() + _padding) {
+        _element.reserve(_element.size() + _padding);
+    }
+    _onElement(_element);
+}
@@ -0,0 +1,209 @@
+// Copyright 2025, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "util/PolygonIndex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+// Upper bound for the number of grid cells per axis if it is chosen automatically
+static inline constexpr size_t MAX_CELLS_PER_AXIS = 1024;
+
+// _________________________________________________________________________________________________
+olu::util::PolygonIndex::PolygonIndex(const std::vector<ring_t> &rings, size_t cellsPerAxis) {
+    std::vector<std::pair<point_t, point_t>> edges;
+    _minLon = _minLat = std::numeric_limits<double>::max();
+    _maxLon = _maxLat = std::numeric_limits<double>::lowest();
+    for (const auto &ring: rings) {
+        for (size_t i = 0; i < ring.size(); ++i) {
+            const auto &from = ring[i];
+            const auto &to = ring[(i + 1) % ring.size()];
+            _minLon = std::min(_minLon, from.first);
+            _minLat = std::min(_minLat, from.second);
+            _maxLon = std::max(_maxLon, from.first);
+            _maxLat = std::max(_maxLat, from.second);
+            if (from != to) {
+                edges.emplace_back(from, to);
+            }
+        }
+    }
+
+    if (edges.size() < 3) {
+        throw PolygonIndexException("A polygon needs at least three edges");
+    }
+
+    if (cellsPerAxis == 0) {
+        cellsPerAxis = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(edges.size()))));
+    }
+    _cellsPerAxis = std::clamp<size_t>(cellsPerAxis, 1, MAX_CELLS_PER_AXIS);
+    _cellWidth = std::max((_maxLon - _minLon) / static_cast<double>(_cellsPerAxis),
+                          std::numeric_limits<double>::min());
+    _cellHeight = std::max((_maxLat - _minLat) / static_cast<double>(_cellsPerAxis),
+                           std::numeric_limits<double>::min());
+
+    // Every cell that overlaps the bounding box of an edge might be crossed by it. Non-horizontal
+    // edges are added to all rows they overlap, horizontal edges never cross the test ray.
+    _cells.assign(_cellsPerAxis * _cellsPerAxis, CellState::OUTSIDE);
+    _rows.resize(_cellsPerAxis);
+    for (const auto &[from, to]: edges) {
+        const size_t fromColumn = getColumn(std::min(from.first, to.first));
+        const size_t toColumn = getColumn(std::max(from.first, to.first));
+        const size_t fromRow = getRow(std::min(from.second, to.second));
+        const size_t toRow = getRow(std::max(from.second, to.second));
+        for (size_t row = fromRow; row <= toRow; ++row) {
+            for (size_t column = fromColumn; column <= toColumn; ++column) {
+                _cells[row * _cellsPerAxis + column] = CellState::BOUNDARY;
+            }
+
+            if (from.second != to.second) {
+                _rows[row].x1.push_back(from.first);
+                _rows[row].y1.push_back(from.second);
+                _rows[row].y2.push_back(to.second);
+                _rows[row].slope.push_back((to.first - from.first) / (to.second - from.second));
+            }
+        }
+    }
+
+    // Cells without edges are either completely inside or outside, so it is enough to test their
+    // center
+    for (size_t row = 0; row < _cellsPerAxis; ++row) {
+        for (size_t column = 0; column < _cellsPerAxis; ++column) {
+            if (auto &cell = _cells[row * _cellsPerAxis + column]; cell != CellState::BOUNDARY) {
+                const double lon = _minLon + (static_cast<double>(column) + 0.5) * _cellWidth;
+                const double lat = _minLat + (static_cast<double>(row) + 0.5) * _cellHeight;
+                cell = containsInRow(row, lon, lat) ? CellState::INSIDE : CellState::OUTSIDE;
+            }
+        }
+    }
+}
+
+// _________________________________________________________________________________________________
+olu::util::PolygonIndex olu::util::PolygonIndex::fromPolyFile(const std::filesystem::path &path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        const std::string msg = "Could not open polygon file: " + path.string();
+        throw PolygonIndexException(msg.c_str());
+    }
+
+    const auto trim = [](const std::string &line) {
+        const auto first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos) {
+            return std::string();
+        }
+        return line.substr(first, line.find_last_not_of(" \t\r") - first + 1);
+    };
+
+    std::vector<ring_t> rings;
+    std::string line;
+    // The first line contains the name of the polygon
+    std::getline(file, line);
+    bool isComplete = false;
+    while (std::getline(file, line)) {
+        line = trim(line);
+        if (line.empty()) {
+            continue;
+        }
+
+        // Each section starts with its name and ends with "END", the file ends with another
+        // "END"
+        if (line == "END") {
+            isComplete = true;
+            break;
+        }
+
+        ring_t ring;
+        bool isSectionComplete = false;
+        while (std::getline(file, line)) {
+            line = trim(line);
+            if (line == "END") {
+                isSectionComplete = true;
+                break;
+            }
+            if (line.empty()) {
+                continue;
+            }
+
+            std::istringstream coordinates(line);
+            point_t point;
+            if (!(coordinates >> point.first >> point.second)) {
+                const std::string msg = "Invalid coordinates in polygon file: " + line;
+                throw PolygonIndexException(msg.c_str());
+            }
+            ring.push_back(point);
+        }
+
+        if (!isSectionComplete) {
+            break;
+        }
+        rings.push_back(std::move(ring));
+    }
+
+    if (!isComplete) {
+        const std::string msg = "Polygon file is incomplete: " + path.string();
+        throw PolygonIndexException(msg.c_str());
+    }
+
+    return PolygonIndex(rings);
+}
+
+// _________________________________________________________________________________________________
+bool olu::util::PolygonIndex::contains(const double lon, const double lat) const {
+    if (lon < _minLon || lon > _maxLon || lat < _minLat || lat > _maxLat) {
+        return false;
+    }
+
+    const size_t row = getRow(lat);
+    switch (_cells[row * _cellsPerAxis + getColumn(lon)]) {
+        case CellState::INSIDE:
+            return true;
+        case CellState::OUTSIDE:
+            return false;
+        default:
+            return containsInRow(row, lon, lat);
+    }
+}
+
+// _________________________________________________________________________________________________
+size_t olu::util::PolygonIndex::getColumn(const double lon) const {
+    const auto column = static_cast<size_t>(std::max((lon - _minLon) / _cellWidth, 0.0));
+    return std::min(column, _cellsPerAxis - 1);
+}
+
+// _________________________________________________________________________________________________
+size_t olu::util::PolygonIndex::getRow(const double lat) const {
+    const auto row = static_cast<size_t>(std::max((lat - _minLat) / _cellHeight, 0.0));
+    return std::min(row, _cellsPerAxis - 1);
+}
+
+// _________________________________________________________________________________________________
+bool olu::util::PolygonIndex::containsInRow(const size_t row, const double lon,
+                                            const double lat) const {
+    const auto &[x1, y1, y2, slope] = _rows[row];
+    // Counts the edges that cross the ray from the point in positive x direction. The loop has
+    // no branches, so it can be vectorized.
+    size_t crossings = 0;
+    for (size_t i = 0; i < x1.size(); ++i) {
+        const bool spansLat = (y1[i] > lat) != (y2[i] > lat);
+        const bool isRight = lon < x1[i] + (lat - y1[i]) * slope[i];
+        crossings += static_cast<size_t>(spansLat & isRight);
+    }
+    return crossings % 2 == 1;
+}
@@ -0,0 +1,210 @@
+// Copyright 2025, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "util/StageGraph.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <optional>
+
+// _________________________________________________________________________________________________
+void olu::util::StageGraph::addInput(const std::string &name) {
+    _inputs.insert(name);
+}
+
+// _________________________________________________________________________________________________
+void olu::util::StageGraph::addStage(std::string name, std::vector<std::string> inputs,
+                                     std::vector<std::string> outputs,
+                                     std::function<void()> run) {
+    Stage stage;
+    stage.timing.name = std::move(name);
+    stage.inputs = std::move(inputs);
+    stage.outputs = std::move(outputs);
+    stage.run = std::move(run);
+    _stages.push_back(std::move(stage));
+}
+
+// _________________________________________________________________________________________________
+void olu::util::StageGraph::resolveDependencies() {
+    std::map<std::string, size_t> producers;
+    for (size_t index = 0; index < _stages.size(); ++index) {
+        for (const auto &output: _stages[index].outputs) {
+            if (_inputs.contains(output) || !producers.emplace(output, index).second) {
+                const std::string msg = "'" + output + "' is produced more than once";
+                throw StageGraphException(msg.c_str());
+            }
+        }
+    }
+
+    for (size_t index = 0; index < _stages.size(); ++index) {
+        auto &stage = _stages[index];
+        stage.dependencies.clear();
+        for (const auto &input: stage.inputs) {
+            if (_inputs.contains(input)) {
+                continue;
+            }
+
+            const auto producer = producers.find(input);
+            if (producer == producers.end()) {
+                const std::string msg = "Stage '" + stage.timing.name + "' reads '" + input
+                                        + "', which is not produced by any stage";
+                throw StageGraphException(msg.c_str());
+            }
+
+            if (std::ranges::find(stage.dependencies, producer->second) ==
+                stage.dependencies.end()) {
+                stage.dependencies.push_back(producer->second);
+            }
+        }
+    }
+
+    for (auto &stage: _stages) {
+        stage.dependents.clear();
+    }
+    for (size_t index = 0; index < _stages.size(); ++index) {
+        for (const auto &dependency: _stages[index].dependencies) {
+            _stages[dependency].dependents.push_back(index);
+        }
+    }
+
+    // Kahn's algorithm, every stage is visited exactly once if there is no cycle
+    std::vector<size_t> missingDependencies;
+    std::vector<size_t> ready;
+    for (size_t index = 0; index < _stages.size(); ++index) {
+        missingDependencies.push_back(_stages[index].dependencies.size());
+        if (missingDependencies.back() == 0) {
+            ready.push_back(index);
+        }
+    }
+
+    size_t visited = 0;
+    while (!ready.empty()) {
+        const size_t index = ready.back();
+        ready.pop_back();
+        ++visited;
+        for (const auto &dependent: _stages[index].dependents) {
+            if (--missingDependencies[dependent] == 0) {
+                ready.push_back(dependent);
+            }
+        }
+    }
+
+    if (visited != _stages.size()) {
+        throw StageGraphException("The stages depend on each other in a cycle");
+    }
+}
+
+// _________________________________________________________________________________________________
+void olu::util::StageGraph::run(WorkStealingPool &pool) {
+    resolveDependencies();
+
+    std::mutex mutex;
+    std::condition_variable stageFinished;
+    std::vector<size_t> missingDependencies;
+    size_t numOfRunningStages = 0;
+    std::exception_ptr exception;
+
+    for (auto &stage: _stages) {
+        stage.finished = false;
+        missingDependencies.push_back(stage.dependencies.size());
+    }
+
+    // Must be called with the mutex locked
+    std::function<void(size_t)> start = [&](const size_t index) {
+        ++numOfRunningStages;
+        pool.submit([&, index] {
+            auto &stage = _stages[index];
+            std::exception_ptr stageException;
+            stage.timing.start = std::chrono::system_clock::now();
+            try {
+                stage.run();
+            } catch (...) {
+                stageException = std::current_exception();
+            }
+            stage.timing.end = std::chrono::system_clock::now();
+
+            std::lock_guard lock(mutex);
+            stage.finished = true;
+            if (stageException && !exception) {
+                exception = stageException;
+            }
+            if (!exception) {
+                for (const auto &dependent: stage.dependents) {
+                    if (--missingDependencies[dependent] == 0) {
+                        start(dependent);
+                    }
+                }
+            }
+            --numOfRunningStages;
+            stageFinished.notify_all();
+        });
+    };
+
+    std::unique_lock lock(mutex);
+    for (size_t index = 0; index < _stages.size(); ++index) {
+        if (missingDependencies[index] == 0) {
+            start(index);
+        }
+    }
+    stageFinished.wait(lock, [&numOfRunningStages] { return numOfRunningStages == 0; });
+
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
+}
+
+// _________________________________________________________________________________________________
+std::vector<olu::util::StageTiming> olu::util::StageGraph::getTimings() const {
+    std::vector<StageTiming> timings;
+    for (const auto &stage: _stages) {
+        if (stage.finished) {
+            timings.push_back(stage.timing);
+        }
+    }
+
+    return timings;
+}
+
+// _________________________________________________________________________________________________
+std::vector<olu::util::StageTiming> olu::util::StageGraph::getCriticalPath() const {
+    const auto finishedLast = [this](const std::vector<size_t> &candidates) {
+        std::optional<size_t> last;
+        for (const auto &index: candidates) {
+            if (_stages[index].finished &&
+                (!last || _stages[index].timing.end > _stages[*last].timing.end)) {
+                last = index;
+            }
+        }
+        return last;
+    };
+
+    std::vector<size_t> all(_stages.size());
+    std::iota(all.begin(), all.end(), 0);
+
+    std::vector<StageTiming> path;
+    for (auto index = finishedLast(all); index; index = finishedLast(_stages[*index].dependencies)) {
+        path.push_back(_stages[*index].timing);
+    }
+    std::ranges::reverse(path);
+
+    return path;
+}
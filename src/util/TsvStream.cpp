@@ -0,0 +1,116 @@
+// Copyright 2025, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "util/TsvStream.h"
+
+// _________________________________________________________________________________________________
+olu::util::TsvStream::TsvStream(row_callback_t onRow): _onRow(std::move(onRow)) { }
+
+// _________________________________________________________________________________________________
+void olu::util::TsvStream::feed(std::string_view chunk) {
+    while (!chunk.empty()) {
+        const auto lineEnd = chunk.find('\n');
+        if (lineEnd == std::string_view::npos) {
+            _partialLine.append(chunk);
+            return;
+        }
+
+        if (_partialLine.empty()) {
+            handleLine(chunk.substr(0, lineEnd));
+        } else {
+            _partialLine.append(chunk.substr(0, lineEnd));
+            handleLine(_partialLine);
+            _partialLine.clear();
+        }
+        chunk.remove_prefix(lineEnd + 1);
+    }
+}
+
+// _________________________________________________________________________________________________
+void olu::util::TsvStream::finish() {
+    if (!_partialLine.empty()) {
+        handleLine(_partialLine);
+        _partialLine.clear();
+    }
+}
+
+// _________________________________________________________________________________________________
+void olu::util::TsvStream::handleLine(std::string_view line) {
+    if (line.ends_with('\r')) {
+        line.remove_suffix(1);
+    }
+
+    if (!_isHeaderSkipped) {
+        _isHeaderSkipped = true;
+        return;
+    }
+
+    if (line.empty()) {
+        return;
+    }
+
+    _row.clear();
+    size_t valueStart = 0;
+    for (size_t tab = line.find('\t'); tab != std::string_view::npos;
+         tab = line.find('\t', valueStart)) {
+        _row.push_back(line.substr(valueStart, tab - valueStart));
+        valueStart = tab + 1;
+    }
+    _row.push_back(line.substr(valueStart));
+
+    // The buffers are only resized before views into them are taken
+    if (_unescapedValues.size() < _row.size()) {
+        _unescapedValues.resize(_row.size());
+    }
+    for (size_t i = 0; i < _row.size(); ++i) {
+        if (_row[i].find('\\') != std::string_view::npos) {
+            unescape(_row[i], _unescapedValues[i]);
+            _row[i] = _unescapedValues[i];
+        }
+    }
+
+    ++_numOfRows;
+    _onRow(_row);
+}
+
+// _________________________________________________________________________________________________
+void olu::util::TsvStream::unescape(const std::string_view value, std::string &output) {
+    output.clear();
+    for (size_t i = 0; i < value.size(); ++i) {
+        if (value[i] != '\\' || i + 1 == value.size()) {
+            output.push_back(value[i]);
+            continue;
+        }
+
+        switch (value[i + 1]) {
+            case 't': output.push_back('\t'); break;
+            case 'b': output.push_back('\b'); break;
+            case 'n': output.push_back('\n'); break;
+            case 'r': output.push_back('\r'); break;
+            case 'f': output.push_back('\f'); break;
+            case '"': output.push_back('"'); break;
+            case '\'': output.push_back('\''); break;
+            case '\\': output.push_back('\\'); break;
+            default:
+                output.push_back(value[i]);
+                output.push_back(value[i + 1]);
+                break;
+        }
+        ++i;
+    }
+}
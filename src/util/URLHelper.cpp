@@ -73,24 +73,29 @@ std::string olu::util::URLHelper::formatSequenceNumberForUrl(const int &sequence
 // _________________________________________________________________________________________________
 std::string olu::util::URLHelper::encodeForUrlQuery(const std::string &value) {
     std::string escaped;
+    appendEncodedForUrlQuery(escaped, value);
+    return escaped;
+}
+
+// _________________________________________________________________________________________________
+void olu::util::URLHelper::appendEncodedForUrlQuery(std::string &output,
+                                                    const std::string_view value) {
     // Reserve enough space for worst case (each char is encoded)
-    escaped.reserve(value.size() * 3);
+    output.reserve(output.size() + value.size() * 3);
 
     for (const unsigned char c : value) {
         if ((c >= 'a' && c <= 'z') ||
             (c >= 'A' && c <= 'Z') ||
             (c >= '0' && c <= '9') ||
             c == '-' || c == '_' || c == '.' || c == '~') {
-            escaped += c;
+            output += c;
             } else {
                 static constexpr char hex[] = "0123456789ABCDEF";
-                escaped += '%';
-                escaped += hex[c >> 4];
-                escaped += hex[c & 0xF];
+                output += '%';
+                output += hex[c >> 4];
+                output += hex[c & 0xF];
             }
     }
-
-    return escaped;
 }
 
 // _________________________________________________________________________________________________
@@ -0,0 +1,133 @@
+// Copyright 2025, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "util/WorkStealingPool.h"
+
+#include <algorithm>
+
+namespace {
+    // The pool and the index of the worker that runs on the current thread, used to add tasks
+    // that are submitted from a worker to its own queue.
+    thread_local const olu::util::WorkStealingPool* currentPool = nullptr;
+    thread_local size_t currentWorker = 0;
+}
+
+// _________________________________________________________________________________________________
+olu::util::WorkStealingPool::WorkStealingPool(const size_t numOfThreads) {
+    const size_t threads = std::max<size_t>(numOfThreads, 1);
+    for (size_t worker = 0; worker < threads; ++worker) {
+        _queues.push_back(std::make_unique<TaskQueue>());
+    }
+    for (size_t worker = 0; worker < threads; ++worker) {
+        _threads.emplace_back(&WorkStealingPool::work, this, worker);
+    }
+}
+
+// _________________________________________________________________________________________________
+olu::util::WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard lock(_mutex);
+        _stopped = true;
+    }
+    _taskAvailable.notify_all();
+
+    for (auto &thread: _threads) {
+        thread.join();
+    }
+}
+
+// _________________________________________________________________________________________________
+void olu::util::WorkStealingPool::submit(std::function<void()> task) {
+    const size_t queue = currentPool == this
+                             ? currentWorker
+                             : _nextQueue.fetch_add(1) % _queues.size();
+    {
+        std::lock_guard lock(_queues[queue]->mutex);
+        _queues[queue]->tasks.push_back(std::move(task));
+    }
+
+    {
+        std::lock_guard lock(_mutex);
+        ++_numOfQueuedTasks;
+        ++_numOfUnfinishedTasks;
+    }
+    _taskAvailable.notify_one();
+}
+
+// _________________________________________________________________________________________________
+void olu::util::WorkStealingPool::wait() {
+    std::unique_lock lock(_mutex);
+    _allTasksFinished.wait(lock, [this] { return _numOfUnfinishedTasks == 0; });
+}
+
+// _________________________________________________________________________________________________
+void olu::util::WorkStealingPool::work(const size_t worker) {
+    currentPool = this;
+    currentWorker = worker;
+
+    while (true) {
+        {
+            std::unique_lock lock(_mutex);
+            _taskAvailable.wait(lock, [this] { return _numOfQueuedTasks > 0 || _stopped; });
+            if (_numOfQueuedTasks == 0) {
+                return;
+            }
+            --_numOfQueuedTasks;
+        }
+
+        takeTask(worker)();
+
+        bool finished;
+        {
+            std::lock_guard lock(_mutex);
+            finished = --_numOfUnfinishedTasks == 0;
+        }
+        if (finished) {
+            _allTasksFinished.notify_all();
+        }
+    }
+}
+
+// _________________________________________________________________________________________________
+std::function<void()> olu::util::WorkStealingPool::takeTask(const size_t worker) {
+    // The worker reserved a task, so there is at least one task in the queues that no other
+    // worker will take. It may only become visible to this worker after a few rounds if other
+    // workers take tasks from the same queues at the same time.
+    while (true) {
+        {
+            auto &own = *_queues[worker];
+            std::lock_guard lock(own.mutex);
+            if (!own.tasks.empty()) {
+                auto task = std::move(own.tasks.back());
+                own.tasks.pop_back();
+                return task;
+            }
+        }
+
+        for (size_t offset = 1; offset < _queues.size(); ++offset) {
+            auto &other = *_queues[(worker + offset) % _queues.size()];
+            std::lock_guard lock(other.mutex);
+            if (!other.tasks.empty()) {
+                auto task = std::move(other.tasks.front());
+                other.tasks.pop_front();
+                ++_numOfStolenTasks;
+                return task;
+            }
+        }
+    }
+}
@@ -0,0 +1,208 @@
+// Copyright 2025, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "osm/Extract.h"
+#include "gtest/gtest.h"
+
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <osmium/builder/osm_object_builder.hpp>
+
+namespace {
+    void addNode(osmium::memory::Buffer &buffer, const olu::id_t &nodeId,
+                 const osmium::Location &location) {
+        {
+            osmium::builder::NodeBuilder builder{buffer};
+            builder.set_id(nodeId)
+                .set_visible(location.valid())
+                .set_version(1)
+                .set_deleted(!location.valid())
+                .set_location(location);
+        }
+        buffer.commit();
+    }
+
+    void addWay(osmium::memory::Buffer &buffer, const olu::id_t &wayId,
+                const std::vector<olu::id_t> &nodeIds) {
+        {
+            osmium::builder::WayBuilder builder{buffer};
+            builder.set_id(wayId)
+                .set_visible(true)
+                .set_version(1);
+
+            osmium::builder::WayNodeListBuilder wayNodes{buffer, &builder};
+            for (const auto &nodeId: nodeIds) {
+                wayNodes.add_node_ref(nodeId);
+            }
+        }
+        buffer.commit();
+    }
+
+    void addRelation(osmium::memory::Buffer &buffer, const olu::id_t &relationId,
+                     const std::string &type,
+                     const std::vector<std::tuple<osmium::item_type, olu::id_t>> &members) {
+        {
+            osmium::builder::RelationBuilder builder{buffer};
+            builder.set_id(relationId)
+                .set_visible(true)
+                .set_version(1);
+
+            {
+                osmium::builder::RelationMemberListBuilder memberList{buffer, &builder};
+                for (const auto &[memberType, memberId]: members) {
+                    memberList.add_member(memberType, memberId, "");
+                }
+            }
+
+            if (!type.empty()) {
+                osmium::builder::TagListBuilder tags{buffer, &builder};
+                tags.add_tag("type", type);
+            }
+        }
+        buffer.commit();
+    }
+
+    /**
+     * Change file with one node inside the box from (0, 0) to (10, 10) and a multipolygon that
+     * has one way that crosses the box and one way that is completely outside.
+     */
+    osmium::memory::Buffer createChangeFile() {
+        osmium::memory::Buffer buffer{1024, osmium::memory::Buffer::auto_grow::yes};
+        addNode(buffer, 1, osmium::Location(1, 1));
+        addNode(buffer, 2, osmium::Location(20, 20));
+        addNode(buffer, 3, osmium::Location(21, 21));
+        addNode(buffer, 4, osmium::Location(30, 30));
+        // Deleted node without location
+        addNode(buffer, 5, osmium::Location());
+        addWay(buffer, 10, {1, 2});
+        addWay(buffer, 11, {3, 4});
+        addRelation(buffer, 100, "multipolygon", {{osmium::item_type::way, 10},
+                                                  {osmium::item_type::way, 11}});
+        addRelation(buffer, 101, "", {{osmium::item_type::relation, 100}});
+        addRelation(buffer, 102, "", {{osmium::item_type::node, 2}});
+        return buffer;
+    }
+
+    std::vector<std::string> applyExtract(olu::osm::Extract &extract,
+                                          const osmium::memory::Buffer &buffer) {
+        if (extract.needsPreparation()) {
+            for (const auto &object: buffer.select<osmium::OSMObject>()) {
+                extract.prepare(object);
+            }
+            extract.finish();
+        }
+
+        std::vector<std::string> included;
+        for (const auto &object: buffer.select<osmium::OSMObject>()) {
+            if (extract.includes(object)) {
+                included.push_back(osmium::item_type_to_char(object.type())
+                                   + std::to_string(object.id()));
+            }
+        }
+        return included;
+    }
+
+    const osmium::Box BOX{0, 0, 10, 10};
+}
+
+// _________________________________________________________________________________________________
+TEST(Extract, simple) {
+    const auto buffer = createChangeFile();
+    olu::osm::Extract extract(BOX, olu::osm::ExtractStrategy::SIMPLE);
+    ASSERT_FALSE(extract.needsPreparation());
+    ASSERT_EQ(applyExtract(extract, buffer), (std::vector<std::string>{"n1", "w10", "r100"}));
+}
+
+// _________________________________________________________________________________________________
+TEST(Extract, completeWays) {
+    const auto buffer = createChangeFile();
+    olu::osm::Extract extract(BOX, olu::osm::ExtractStrategy::COMPLETE_WAYS);
+    ASSERT_TRUE(extract.needsPreparation());
+    ASSERT_EQ(applyExtract(extract, buffer),
+              (std::vector<std::string>{"n1", "n2", "w10", "r100", "r101"}));
+}
+
+// _________________________________________________________________________________________________
+TEST(Extract, smart) {
+    const auto buffer = createChangeFile();
+    olu::osm::Extract extract(BOX, olu::osm::ExtractStrategy::SMART);
+    ASSERT_EQ(applyExtract(extract, buffer),
+              (std::vector<std::string>{"n1", "n2", "n3", "n4", "w10", "w11", "r100", "r101"}));
+}
+
+// _________________________________________________________________________________________________
+TEST(Extract, smartParentMultipolygon) {
+    osmium::memory::Buffer buffer{1024, osmium::memory::Buffer::auto_grow::yes};
+    addNode(buffer, 1, osmium::Location(1, 1));
+    addNode(buffer, 3, osmium::Location(21, 21));
+    addNode(buffer, 4, osmium::Location(30, 30));
+    addWay(buffer, 11, {3, 4});
+    addRelation(buffer, 110, "", {{osmium::item_type::node, 1}});
+    // Only included as the parent of relation 110, so the way is not added
+    addRelation(buffer, 111, "multipolygon", {{osmium::item_type::way, 11},
+                                              {osmium::item_type::relation, 110}});
+
+    olu::osm::Extract extract(BOX, olu::osm::ExtractStrategy::SMART);
+    ASSERT_EQ(applyExtract(extract, buffer), (std::vector<std::string>{"n1", "r110", "r111"}));
+}
+
+// _________________________________________________________________________________________________
+TEST(Extract, smartMultipolygonNodeMembers) {
+    osmium::memory::Buffer buffer{1024, osmium::memory::Buffer::auto_grow::yes};
+    addNode(buffer, 1, osmium::Location(1, 1));
+    addNode(buffer, 2, osmium::Location(20, 20));
+    addNode(buffer, 6, osmium::Location(40, 40));
+    addWay(buffer, 10, {1, 2});
+    // The node member outside the box is added to complete the multipolygon
+    addRelation(buffer, 120, "multipolygon", {{osmium::item_type::way, 10},
+                                              {osmium::item_type::node, 6}});
+
+    olu::osm::Extract extract(BOX, olu::osm::ExtractStrategy::SMART);
+    ASSERT_EQ(applyExtract(extract, buffer),
+              (std::vector<std::string>{"n1", "n2", "n6", "w10", "r120"}));
+}
+
+// _________________________________________________________________________________________________
+TEST(Extract, polygon) {
+    const auto buffer = createChangeFile();
+    // Triangle that contains node 1 and node 2, but not node 3
+    olu::util::PolygonIndex polygon({{{0, 0}, {41, 0}, {0, 41}}});
+    olu::osm::Extract extract(std::move(polygon), olu::osm::ExtractStrategy::SIMPLE);
+    ASSERT_EQ(applyExtract(extract, buffer),
+              (std::vector<std::string>{"n1", "n2", "w10", "r100", "r102"}));
+}
+
+// _________________________________________________________________________________________________
+TEST(Extract, notPrepared) {
+    const auto buffer = createChangeFile();
+    olu::osm::Extract extract(BOX, olu::osm::ExtractStrategy::SMART);
+    ASSERT_THROW(std::ignore = extract.includes(*buffer.select<osmium::OSMObject>().begin()),
+                 olu::osm::ExtractException);
+}
+
+// _________________________________________________________________________________________________
+TEST(Extract, strategyFromString) {
+    ASSERT_EQ(olu::osm::Extract::strategyFromString("simple"), olu::osm::ExtractStrategy::SIMPLE);
+    ASSERT_EQ(olu::osm::Extract::strategyFromString("complete_ways"),
+              olu::osm::ExtractStrategy::COMPLETE_WAYS);
+    ASSERT_EQ(olu::osm::Extract::strategyFromString("smart"), olu::osm::ExtractStrategy::SMART);
+    ASSERT_THROW(std::ignore = olu::osm::Extract::strategyFromString("all"),
+                 olu::osm::ExtractException);
+}
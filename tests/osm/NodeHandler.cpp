@@ -0,0 +1,149 @@
+// Copyright 2025, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "osm/NodeHandler.h"
+
+#include <atomic>
+#include <stdexcept>
+
+#include <osmium/builder/osm_object_builder.hpp>
+
+#include "gtest/gtest.h"
+
+namespace {
+    /**
+     * Fetcher that knows the previous locations of the nodes 1 and 2 and counts the requests.
+     * If `fail` is set, all requests throw.
+     */
+    class LocationOsmDataFetcher final : public olu::osm::OsmDataFetcher {
+    public:
+        std::atomic<size_t> numOfRequests = 0;
+        bool fail = false;
+
+        std::vector<olu::osm::Node> fetchNodes(const std::set<olu::id_t> &nodeIds) override {
+            ++numOfRequests;
+            if (fail) {
+                throw std::runtime_error("Endpoint not available");
+            }
+
+            std::vector<olu::osm::Node> nodes;
+            if (nodeIds.contains(1)) {
+                nodes.emplace_back(1, osmium::Location(1.0, 1.0));
+            }
+            if (nodeIds.contains(2)) {
+                nodes.emplace_back(2, osmium::Location(2.0, 2.0));
+            }
+            return nodes;
+        }
+    };
+
+    void addModifiedNode(osmium::memory::Buffer &buffer, const olu::id_t id,
+                         const osmium::Location &location) {
+        {
+            osmium::builder::NodeBuilder builder{buffer};
+            builder.set_id(id)
+                .set_visible(true)
+                .set_version(2)
+                .set_location(location);
+        }
+        buffer.commit();
+    }
+
+    osmium::memory::Buffer createModifiedNodes() {
+        osmium::memory::Buffer buffer{1024 * 10};
+        addModifiedNode(buffer, 1, osmium::Location(1.0, 1.0));
+        addModifiedNode(buffer, 2, osmium::Location(3.0, 3.0));
+        addModifiedNode(buffer, 3, osmium::Location(1.0, 1.0));
+        return buffer;
+    }
+}
+
+// _________________________________________________________________________________________________
+TEST(NodeHandler, modifiedNodesOnly) {
+    olu::config::Config config;
+    olu::osm::StatisticsHandler stats(config);
+    olu::osm::RequestBatchSizes batchSizes(config);
+    LocationOsmDataFetcher odf;
+    olu::osm::NodeHandler nodeHandler(config, odf, stats, batchSizes);
+
+    const auto buffer = createModifiedNodes();
+    for (const auto &node : buffer.select<osmium::Node>()) {
+        nodeHandler.node(node);
+    }
+
+    // The locations are not checked yet, but the change file is not empty
+    ASSERT_FALSE(nodeHandler.empty());
+
+    nodeHandler.checkNodesForLocationChange();
+    ASSERT_FALSE(nodeHandler.empty());
+    ASSERT_EQ(nodeHandler.getModifiedNodes(), std::set<olu::id_t>({1}));
+    ASSERT_EQ(nodeHandler.getModifiedNodesWithChangedLocation(), std::set<olu::id_t>({2}));
+    // Node 3 is not on the endpoint, so it has to be created
+    ASSERT_EQ(nodeHandler.getCreatedNodes(), std::set<olu::id_t>({3}));
+    ASSERT_TRUE(nodeHandler.getDeletedNodes().empty());
+}
+
+// _________________________________________________________________________________________________
+TEST(NodeHandler, prefetchedLocations) {
+    olu::config::Config config;
+    // Each node is requested on its own while the change file is read, with at most one
+    // request in flight
+    config.batchSize = 1;
+    config.maxConcurrentRequests = 1;
+    olu::osm::StatisticsHandler stats(config);
+    olu::osm::RequestBatchSizes batchSizes(config);
+    LocationOsmDataFetcher odf;
+    olu::osm::NodeHandler nodeHandler(config, odf, stats, batchSizes);
+
+    const auto buffer = createModifiedNodes();
+    for (const auto &node : buffer.select<osmium::Node>()) {
+        nodeHandler.node(node);
+    }
+
+    nodeHandler.checkNodesForLocationChange();
+    ASSERT_EQ(odf.numOfRequests, 3);
+    ASSERT_EQ(nodeHandler.getModifiedNodes(), std::set<olu::id_t>({1}));
+    ASSERT_EQ(nodeHandler.getModifiedNodesWithChangedLocation(), std::set<olu::id_t>({2}));
+    ASSERT_EQ(nodeHandler.getCreatedNodes(), std::set<olu::id_t>({3}));
+}
+
+// _________________________________________________________________________________________________
+TEST(NodeHandler, failedPrefetch) {
+    olu::config::Config config;
+    config.batchSize = 1;
+    config.maxConcurrentRequests = 2;
+    olu::osm::StatisticsHandler stats(config);
+    olu::osm::RequestBatchSizes batchSizes(config);
+    LocationOsmDataFetcher odf;
+    odf.fail = true;
+
+    olu::osm::NodeHandler nodeHandler(config, odf, stats, batchSizes);
+
+    const auto buffer = createModifiedNodes();
+    for (const auto &node : buffer.select<osmium::Node>()) {
+        try {
+            nodeHandler.node(node);
+        } catch (const std::runtime_error &) {
+            // The failed request of the first node is collected while reading the third one
+        }
+    }
+
+    ASSERT_THROW(nodeHandler.checkNodesForLocationChange(), std::runtime_error);
+    // The request after the failed one is finished as well
+    ASSERT_EQ(odf.numOfRequests, 3);
+}
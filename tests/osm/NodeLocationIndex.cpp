@@ -0,0 +1,98 @@
+// Copyright 2025, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "osm/NodeLocationIndex.h"
+#include "gtest/gtest.h"
+
+#include <filesystem>
+#include <string>
+
+#include <unistd.h>
+
+namespace {
+    /**
+     * Gives each test its own index file, so that tests of concurrent runs do not share it, and
+     * removes the file afterward.
+     */
+    class NodeLocationIndexTest : public ::testing::Test {
+    protected:
+        std::filesystem::path _indexPath;
+
+        void SetUp() override {
+            const auto* testInfo = ::testing::UnitTest::GetInstance()->current_test_info();
+            _indexPath = std::filesystem::temp_directory_path() /
+                         ("olu_test_node_locations_" + std::to_string(getpid()) + "_"
+                          + testInfo->name() + ".idx");
+            std::filesystem::remove(_indexPath);
+        }
+
+        void TearDown() override {
+            std::error_code error;
+            std::filesystem::remove(_indexPath, error);
+        }
+    };
+}
+
+// _________________________________________________________________________________________________
+TEST_F(NodeLocationIndexTest, setGetAndRemove) {
+    olu::osm::NodeLocationIndex index(_indexPath);
+
+    ASSERT_FALSE(index.get(1).is_defined());
+    ASSERT_FALSE(index.get(-1).is_defined());
+
+    index.set(1, osmium::Location(13.5690032, 42.7957187));
+    index.set(100, osmium::Location(0.0, 0.0));
+    ASSERT_EQ(index.get(1), osmium::Location(13.5690032, 42.7957187));
+    ASSERT_EQ(index.get(100), osmium::Location(0.0, 0.0));
+    ASSERT_FALSE(index.get(50).is_defined());
+    ASSERT_FALSE(index.get(1000).is_defined());
+
+    index.remove(1);
+    ASSERT_FALSE(index.get(1).is_defined());
+}
+
+// _________________________________________________________________________________________________
+TEST_F(NodeLocationIndexTest, lookup) {
+    olu::osm::NodeLocationIndex index(_indexPath);
+    index.set(1, osmium::Location(1.0, 2.0));
+    index.set(3, osmium::Location(3.0, 4.0));
+
+    std::vector<olu::osm::Node> nodes;
+    const auto missing = index.lookup({1, 2, 3, 4}, nodes);
+    ASSERT_EQ(missing, std::set<olu::id_t>({2, 4}));
+    ASSERT_EQ(nodes.size(), 2);
+    ASSERT_EQ(nodes[0].getId(), 1);
+    ASSERT_EQ(nodes[0].getLocation(), osmium::Location(1.0, 2.0));
+    ASSERT_EQ(nodes[1].getId(), 3);
+    ASSERT_EQ(nodes[1].getLocation(), osmium::Location(3.0, 4.0));
+}
+
+// _________________________________________________________________________________________________
+TEST_F(NodeLocationIndexTest, persistence) {
+    {
+        olu::osm::NodeLocationIndex index(_indexPath);
+        index.set(42, osmium::Location(7.8421, 47.9990));
+        index.sync();
+    }
+    {
+        olu::osm::NodeLocationIndex index(_indexPath);
+        ASSERT_EQ(index.get(42), osmium::Location(7.8421, 47.9990));
+        index.clear();
+        ASSERT_FALSE(index.get(42).is_defined());
+    }
+}
@@ -0,0 +1,160 @@
+// Copyright 2025, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+#include "osm/OsmDataFetcherCache.h"
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace {
+    /**
+     * Fetcher that returns objects for all even ids and counts the requested ids.
+     */
+    class CountingOsmDataFetcher final : public olu::osm::OsmDataFetcher {
+    public:
+        size_t requestedNodes = 0;
+        size_t requestedWays = 0;
+        size_t requestedRelations = 0;
+
+        std::vector<olu::osm::Node> fetchNodes(const std::set<olu::id_t> &nodeIds) override {
+            requestedNodes += nodeIds.size();
+            std::vector<olu::osm::Node> nodes;
+            for (const auto &id: nodeIds) {
+                if (id % 2 == 0) {
+                    nodes.emplace_back(id, osmium::Location(1.0, 2.0));
+                }
+            }
+            return nodes;
+        }
+
+        std::vector<olu::osm::Way> fetchWays(const std::set<olu::id_t> &wayIds) override {
+            requestedWays += wayIds.size();
+            std::vector<olu::osm::Way> ways;
+            for (const auto &id: wayIds) {
+                if (id % 2 == 0) {
+                    ways.emplace_back(id, olu::member_ids_t{id * 10, id * 10 + 1}, false);
+                }
+            }
+            return ways;
+        }
+
+        std::vector<olu::osm::Relation>
+        fetchRelations(const std::set<olu::id_t> &relationIds) override {
+            requestedRelations += relationIds.size();
+            std::vector<olu::osm::Relation> relations;
+            for (const auto &id: relationIds) {
+                if (id % 2 == 0) {
+                    relations.emplace_back(id, "multipolygon", olu::osm::relation_members_t{
+                        olu::osm::RelationMember(id * 10, olu::osm::OsmObjectType::NODE,
+                                                 std::string("label")),
+                        olu::osm::RelationMember(id * 10, olu::osm::OsmObjectType::WAY,
+                                                 std::string("outer"))});
+                }
+            }
+            return relations;
+        }
+    };
+
+    /**
+     * Fetcher that records how many requests are handled by all fetchers at the same time.
+     */
+    class SlowOsmDataFetcher final : public olu::osm::OsmDataFetcher {
+    public:
+        explicit SlowOsmDataFetcher(std::atomic<int> &running, std::atomic<int> &maxRunning):
+            _running(&running), _maxRunning(&maxRunning) { }
+
+        std::vector<olu::id_t> fetchWaysReferencingNodes(const std::set<olu::id_t> &) override {
+            const int running = ++*_running;
+            int maxRunning = *_maxRunning;
+            while (running > maxRunning &&
+                   !_maxRunning->compare_exchange_weak(maxRunning, running)) { }
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            --*_running;
+            return {};
+        }
+
+    private:
+        std::atomic<int>* _running;
+        std::atomic<int>* _maxRunning;
+    };
+}
+
+// _________________________________________________________________________________________________
+TEST(OsmDataFetcherCache, nodes) {
+    olu::config::Config config;
+    olu::osm::StatisticsHandler stats(config);
+    auto fetcher = std::make_unique<CountingOsmDataFetcher>();
+    const auto* counter = fetcher.get();
+    olu::osm::OsmDataFetcherCache cache(std::move(fetcher), stats);
+
+    ASSERT_EQ(cache.fetchNodes({1, 2, 4}).size(), 2);
+    ASSERT_EQ(counter->requestedNodes, 3);
+
+    // Node 1 is known to be missing, only node 6 is requested
+    const auto nodes = cache.fetchNodes({1, 2, 6});
+    ASSERT_EQ(nodes.size(), 2);
+    ASSERT_EQ(counter->requestedNodes, 4);
+}
+
+// _________________________________________________________________________________________________
+TEST(OsmDataFetcherCache, waysAndRelations) {
+    olu::config::Config config;
+    olu::osm::StatisticsHandler stats(config);
+    auto fetcher = std::make_unique<CountingOsmDataFetcher>();
+    const auto* counter = fetcher.get();
+    olu::osm::OsmDataFetcherCache cache(std::move(fetcher), stats);
+
+    // The member ids and the complete objects are served by the same request
+    ASSERT_EQ(cache.fetchWaysMembers({2, 3}), olu::member_ids_t({20, 21}));
+    const auto ways = cache.fetchWays({2, 3});
+    ASSERT_EQ(ways.size(), 1);
+    ASSERT_EQ(ways[0].getId(), 2);
+    ASSERT_EQ(counter->requestedWays, 2);
+
+    const auto [nodeIds, wayIds] = cache.fetchRelationMembers({4});
+    ASSERT_EQ(nodeIds, std::vector<olu::id_t>({40}));
+    ASSERT_EQ(wayIds, std::vector<olu::id_t>({40}));
+    const auto relations = cache.fetchRelations({4, 5});
+    ASSERT_EQ(relations.size(), 1);
+    ASSERT_EQ(relations[0].getType(), "multipolygon");
+    ASSERT_EQ(counter->requestedRelations, 2);
+}
+
+// _________________________________________________________________________________________________
+TEST(OsmDataFetcherCache, concurrentRequests) {
+    olu::config::Config config;
+    olu::osm::StatisticsHandler stats(config);
+    std::atomic<int> running = 0;
+    std::atomic<int> maxRunning = 0;
+    std::vector<std::unique_ptr<olu::osm::OsmDataFetcher>> fetchers;
+    fetchers.push_back(std::make_unique<SlowOsmDataFetcher>(running, maxRunning));
+    fetchers.push_back(std::make_unique<SlowOsmDataFetcher>(running, maxRunning));
+    olu::osm::OsmDataFetcherCache cache(std::move(fetchers), stats);
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 6; ++i) {
+        threads.emplace_back([&cache] { cache.fetchWaysReferencingNodes({1}); });
+    }
+    for (auto &thread: threads) {
+        thread.join();
+    }
+
+    // Each fetcher handles one request at a time
+    ASSERT_EQ(maxRunning, 2);
+}
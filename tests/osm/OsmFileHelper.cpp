@@ -0,0 +1,154 @@
+// Copyright 2025, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "osm/OsmFileHelper.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include "osmium/io/gzip_compression.hpp"
+
+namespace {
+    const std::string CHANGE_FILE = "tests/data/427.osc.gz";
+
+    std::filesystem::path getTmpRunDir() {
+        return std::filesystem::temp_directory_path() / "olu_test_merge_runs";
+    }
+
+    std::filesystem::path getTmpOutputPath(const std::string &name) {
+        return std::filesystem::temp_directory_path() / ("olu_test_" + name + ".osc");
+    }
+
+    std::string readFile(const std::string &path) {
+        std::ifstream file(path, std::ios::binary);
+        std::stringstream content;
+        content << file.rdbuf();
+        return content.str();
+    }
+
+    std::vector<std::pair<osmium::item_type, osmium::object_id_type>>
+    readObjects(const std::filesystem::path &path) {
+        std::vector<std::pair<osmium::item_type, osmium::object_id_type>> objects;
+        osmium::io::Reader reader{osmium::io::File(path.string()),
+                                  osmium::osm_entity_bits::object};
+        while (const osmium::memory::Buffer buffer = reader.read()) {
+            for (const auto &object: buffer.select<osmium::OSMObject>()) {
+                objects.emplace_back(object.type(), object.id());
+            }
+        }
+        reader.close();
+        return objects;
+    }
+}
+
+// _________________________________________________________________________________________________
+TEST(OsmFileHelper, mergeFromMemoryBuffer) {
+    const auto fromDisk = getTmpOutputPath("merged_from_disk");
+    const auto fromMemory = getTmpOutputPath("merged_from_memory");
+
+    std::vector<osmium::io::File> inputs{osmium::io::File(CHANGE_FILE)};
+    olu::osm::OsmFileHelper::mergeAndSortFiles(
+        inputs, fromDisk.string(), olu::osm::object_order_type_id_reverse_version_delete(),
+        false);
+
+    const std::string compressed = readFile(CHANGE_FILE);
+    olu::osm::OsmObjectCollection objects(olu::osm::object_order_type_id_reverse_version_delete());
+    objects.add(osmium::io::File(compressed.data(), compressed.size(), "osc.gz"));
+    objects.write(fromMemory.string());
+
+    const auto expected = readObjects(fromDisk);
+    ASSERT_FALSE(expected.empty());
+    ASSERT_EQ(readObjects(fromMemory), expected);
+
+    std::filesystem::remove(fromDisk);
+    std::filesystem::remove(fromMemory);
+}
+
+// _________________________________________________________________________________________________
+TEST(OsmFileHelper, mergeKeepsOnlyFirstVersionOfObject) {
+    const auto output = getTmpOutputPath("merged_twice");
+
+    const std::string compressed = readFile(CHANGE_FILE);
+    olu::osm::OsmObjectCollection objects(olu::osm::object_order_type_id_reverse_version_delete());
+    objects.add(osmium::io::File(compressed.data(), compressed.size(), "osc.gz"));
+    objects.add(osmium::io::File(compressed.data(), compressed.size(), "osc.gz"));
+    objects.write(output.string());
+
+    auto merged = readObjects(output);
+    const auto size = merged.size();
+    const auto [first, last] = std::ranges::unique(merged);
+    merged.erase(first, last);
+    ASSERT_EQ(merged.size(), size);
+
+    std::filesystem::remove(output);
+}
+
+// _________________________________________________________________________________________________
+TEST(OsmFileHelper, mergeWithMemoryLimit) {
+    const auto unbounded = getTmpOutputPath("merged_unbounded");
+    const auto bounded = getTmpOutputPath("merged_bounded");
+
+    std::vector<osmium::io::File> inputs{osmium::io::File(CHANGE_FILE),
+                                         osmium::io::File(CHANGE_FILE)};
+    olu::osm::OsmFileHelper::mergeAndSortFiles(
+        inputs, unbounded.string(), olu::osm::object_order_type_id_reverse_version_delete(),
+        false);
+
+    // Every buffer exceeds the limit, so each one is written to its own run
+    olu::osm::OsmFileHelper::mergeAndSortFiles(
+        inputs, bounded.string(), olu::osm::object_order_type_id_reverse_version_delete(),
+        false, 1, getTmpRunDir());
+
+    const auto expected = readObjects(unbounded);
+    ASSERT_FALSE(expected.empty());
+    ASSERT_EQ(readObjects(bounded), expected);
+    ASSERT_TRUE(std::filesystem::is_empty(getTmpRunDir()));
+
+    std::filesystem::remove(unbounded);
+    std::filesystem::remove(bounded);
+    std::filesystem::remove_all(getTmpRunDir());
+}
+
+// _________________________________________________________________________________________________
+TEST(OsmFileHelper, mergeSortedFiles) {
+    const auto sorted = getTmpOutputPath("sorted");
+    const auto merged = getTmpOutputPath("merged_sorted");
+
+    std::vector<osmium::io::File> inputs{osmium::io::File(CHANGE_FILE)};
+    olu::osm::OsmFileHelper::mergeAndSortFiles(
+        inputs, sorted.string(), olu::osm::object_order_type_id_reverse_version_delete(),
+        false);
+
+    olu::osm::OsmObjectCollection objects(olu::osm::object_order_type_id_reverse_version_delete(),
+                                          1, getTmpRunDir());
+    ASSERT_TRUE(objects.isSorted(osmium::io::File(sorted.string())));
+    // More sorted files than can be merged at once
+    for (size_t i = 0; i <= decltype(objects)::MAX_MERGE_WIDTH; ++i) {
+        objects.addSorted(osmium::io::File(sorted.string()));
+    }
+    objects.write(merged.string());
+
+    ASSERT_EQ(readObjects(merged), readObjects(sorted));
+
+    std::filesystem::remove(sorted);
+    std::filesystem::remove(merged);
+    std::filesystem::remove_all(getTmpRunDir());
+}
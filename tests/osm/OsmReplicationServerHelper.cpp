@@ -0,0 +1,77 @@
+// Copyright 2025, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "osm/OsmReplicationServerHelper.h"
+#include "gtest/gtest.h"
+
+#include <ctime>
+
+using olu::osm::OsmReplicationServerHelper;
+
+namespace {
+    // Minutely replication server with a gap of a day after sequence number 5000
+    int64_t secondsOfSequenceNumber(const int sequenceNumber) {
+        return 1735689600 + sequenceNumber * 60 + (sequenceNumber > 5000 ? 24 * 60 * 60 : 0);
+    }
+
+    std::string toTimestamp(const int64_t seconds) {
+        const time_t time = seconds;
+        std::tm tm = {};
+        char timestamp[32];
+        strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H\\:%M\\:%SZ", gmtime_r(&time, &tm));
+        return timestamp;
+    }
+
+    olu::osm::OsmDatabaseState getState(const int sequenceNumber) {
+        return {toTimestamp(secondsOfSequenceNumber(sequenceNumber)), sequenceNumber};
+    }
+}
+
+// _________________________________________________________________________________________________
+TEST(OsmReplicationServerHelper, searchDatabaseStateForTimestamp) {
+    constexpr int latestSeqNum = 100000;
+    for (const int expected: {0, 1, 17, 4999, 5000, 5001, 65432, latestSeqNum - 1}) {
+        for (const int guessedSeqNum: {-1, expected, expected + 3, latestSeqNum - 2}) {
+            size_t numOfFetches = 0;
+            const auto state = OsmReplicationServerHelper::searchDatabaseStateForTimestamp(
+                formatTimestamp(toTimestamp(secondsOfSequenceNumber(expected) + 30)),
+                getState(latestSeqNum), guessedSeqNum, [&numOfFetches](const int sequenceNumber) {
+                    ++numOfFetches;
+                    return getState(sequenceNumber);
+                });
+
+            ASSERT_EQ(state.sequenceNumber, expected);
+            ASSERT_LE(numOfFetches, 40);
+        }
+    }
+}
+
+// _________________________________________________________________________________________________
+TEST(OsmReplicationServerHelper, searchDatabaseStateForExactTimestamp) {
+    const auto state = OsmReplicationServerHelper::searchDatabaseStateForTimestamp(
+        formatTimestamp(getState(1234).timeStamp), getState(2000), -1, getState);
+    ASSERT_EQ(state.sequenceNumber, 1234);
+}
+
+// _________________________________________________________________________________________________
+TEST(OsmReplicationServerHelper, searchDatabaseStateBeforeFirstState) {
+    ASSERT_THROW(OsmReplicationServerHelper::searchDatabaseStateForTimestamp(
+                     formatTimestamp(toTimestamp(secondsOfSequenceNumber(0) - 60)),
+                     getState(2000), -1, getState),
+                 olu::osm::OsmReplicationServerHelperException);
+}
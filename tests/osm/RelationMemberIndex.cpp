@@ -0,0 +1,160 @@
+// Copyright 2025, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+#include "osm/RelationMemberIndex.h"
+#include "gtest/gtest.h"
+
+#include <filesystem>
+#include <string>
+
+#include <unistd.h>
+
+#include <osmium/builder/osm_object_builder.hpp>
+
+namespace {
+    /**
+     * Gives each test its own index directory, so that tests of concurrent runs do not share it,
+     * and removes the directory afterward.
+     */
+    class RelationMemberIndexTest : public ::testing::Test {
+    protected:
+        std::filesystem::path _indexDir;
+
+        void SetUp() override {
+            const auto* testInfo = ::testing::UnitTest::GetInstance()->current_test_info();
+            _indexDir = std::filesystem::temp_directory_path() /
+                        ("olu_test_relation_member_index_" + std::to_string(getpid()) + "_"
+                         + testInfo->name());
+            std::filesystem::remove_all(_indexDir);
+            std::filesystem::create_directory(_indexDir);
+        }
+
+        void TearDown() override {
+            std::error_code error;
+            std::filesystem::remove_all(_indexDir, error);
+        }
+    };
+
+    void applyRelation(olu::osm::RelationMemberIndex &index, const olu::id_t &relationId,
+                       const olu::version_t &version, const std::string &type,
+                       const std::vector<std::tuple<osmium::item_type, olu::id_t,
+                                                    std::string>> &members,
+                       const bool deleted = false) {
+        osmium::memory::Buffer buffer{1024 * 10};
+        {
+            osmium::builder::RelationBuilder builder{buffer};
+            builder.set_id(relationId)
+                .set_visible(!deleted)
+                .set_version(version)
+                .set_deleted(deleted);
+
+            {
+                osmium::builder::RelationMemberListBuilder memberList{buffer, &builder};
+                for (const auto &[memberType, memberId, role]: members) {
+                    memberList.add_member(memberType, memberId, role.c_str());
+                }
+            }
+
+            if (!type.empty()) {
+                osmium::builder::TagListBuilder tags{buffer, &builder};
+                tags.add_tag("type", type);
+            }
+        }
+
+        index.relation(buffer.get<osmium::Relation>(buffer.commit()));
+    }
+}
+
+// _________________________________________________________________________________________________
+TEST_F(RelationMemberIndexTest, buildAndLookup) {
+    olu::osm::RelationMemberIndex index(_indexDir);
+    ASSERT_FALSE(index.isBuilt());
+
+    index.beginBuild();
+    applyRelation(index, 1, 1, "multipolygon", {
+        {osmium::item_type::way, 10, "outer"},
+        {osmium::item_type::way, 11, "inner"},
+        {osmium::item_type::node, 5, ""}});
+    applyRelation(index, 2, 1, "", {
+        {osmium::item_type::relation, 1, "subarea"},
+        {osmium::item_type::way, 10, "outer"}});
+    index.endBuild();
+    ASSERT_TRUE(index.isBuilt());
+
+    std::vector<olu::osm::Relation> relations;
+    const auto missing = index.lookup({1, 2, 3}, relations);
+    ASSERT_EQ(missing, std::set<olu::id_t>({3}));
+    ASSERT_EQ(relations.size(), 2);
+
+    ASSERT_EQ(relations[0].getId(), 1);
+    ASSERT_EQ(relations[0].getType(), "multipolygon");
+    ASSERT_TRUE(olu::osm::RelationMember::areRelMemberEqual(relations[0].getMembers(), {
+        olu::osm::RelationMember(10, olu::osm::OsmObjectType::WAY, std::string("outer")),
+        olu::osm::RelationMember(11, olu::osm::OsmObjectType::WAY, std::string("inner")),
+        olu::osm::RelationMember(5, olu::osm::OsmObjectType::NODE, std::string(""))}));
+
+    ASSERT_EQ(relations[1].getId(), 2);
+    ASSERT_EQ(relations[1].getType(), "");
+    ASSERT_EQ(relations[1].getMembers().size(), 2);
+
+    ASSERT_EQ(index.getRelationsReferencing(olu::osm::OsmObjectType::WAY, {10}),
+              std::set<olu::id_t>({1, 2}));
+    ASSERT_EQ(index.getRelationsReferencing(olu::osm::OsmObjectType::NODE, {5, 10}),
+              std::set<olu::id_t>({1}));
+    ASSERT_EQ(index.getRelationsReferencing(olu::osm::OsmObjectType::RELATION, {1}),
+              std::set<olu::id_t>({2}));
+    ASSERT_TRUE(index.getRelationsReferencing(olu::osm::OsmObjectType::NODE, {10}).empty());
+}
+
+// _________________________________________________________________________________________________
+TEST_F(RelationMemberIndexTest, applyChanges) {
+    {
+        olu::osm::RelationMemberIndex index(_indexDir);
+        index.beginBuild();
+        applyRelation(index, 1, 1, "multipolygon", {
+            {osmium::item_type::way, 10, "outer"},
+            {osmium::item_type::way, 11, "inner"}});
+        applyRelation(index, 2, 1, "route", {{osmium::item_type::way, 11, ""}});
+        index.endBuild();
+
+        // Modified relation with a new role and member order
+        applyRelation(index, 1, 2, "boundary", {
+            {osmium::item_type::way, 12, "outer"},
+            {osmium::item_type::way, 10, "outer"},
+            {osmium::item_type::node, 7, "admin_centre"}});
+        // Deleted relation
+        applyRelation(index, 2, 2, "", {}, true);
+        index.commit();
+    }
+    {
+        // The changes are persistent
+        olu::osm::RelationMemberIndex index(_indexDir);
+        std::vector<olu::osm::Relation> relations;
+        ASSERT_EQ(index.lookup({1, 2}, relations), std::set<olu::id_t>({2}));
+        ASSERT_EQ(relations.size(), 1);
+        ASSERT_EQ(relations[0].getType(), "boundary");
+        ASSERT_TRUE(olu::osm::RelationMember::areRelMemberEqual(relations[0].getMembers(), {
+            olu::osm::RelationMember(12, olu::osm::OsmObjectType::WAY, std::string("outer")),
+            olu::osm::RelationMember(10, olu::osm::OsmObjectType::WAY, std::string("outer")),
+            olu::osm::RelationMember(7, olu::osm::OsmObjectType::NODE,
+                                     std::string("admin_centre"))}));
+
+        ASSERT_TRUE(index.getRelationsReferencing(olu::osm::OsmObjectType::WAY, {11}).empty());
+        ASSERT_EQ(index.getRelationsReferencing(olu::osm::OsmObjectType::WAY, {10, 12}),
+                  std::set<olu::id_t>({1}));
+    }
+}
@@ -0,0 +1,131 @@
+// Copyright 2025, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+#include "osm/WayNodeIndex.h"
+#include "gtest/gtest.h"
+
+#include <filesystem>
+#include <string>
+
+#include <unistd.h>
+
+#include <osmium/builder/osm_object_builder.hpp>
+
+namespace {
+    /**
+     * Gives each test its own index directory, so that tests of concurrent runs do not share it,
+     * and removes the directory afterward.
+     */
+    class WayNodeIndexTest : public ::testing::Test {
+    protected:
+        std::filesystem::path _indexDir;
+
+        void SetUp() override {
+            const auto* testInfo = ::testing::UnitTest::GetInstance()->current_test_info();
+            _indexDir = std::filesystem::temp_directory_path() /
+                        ("olu_test_way_node_index_" + std::to_string(getpid()) + "_"
+                         + testInfo->name());
+            std::filesystem::remove_all(_indexDir);
+            std::filesystem::create_directory(_indexDir);
+        }
+
+        void TearDown() override {
+            std::error_code error;
+            std::filesystem::remove_all(_indexDir, error);
+        }
+    };
+
+    void applyWay(olu::osm::WayNodeIndex &index, const olu::id_t &wayId,
+                  const olu::version_t &version, const std::vector<olu::id_t> &nodeIds,
+                  const bool deleted = false) {
+        osmium::memory::Buffer buffer{1024 * 10};
+        {
+            osmium::builder::WayBuilder builder{buffer};
+            builder.set_id(wayId)
+                .set_visible(!deleted)
+                .set_version(version)
+                .set_deleted(deleted);
+
+            osmium::builder::WayNodeListBuilder wayNodes{buffer, &builder};
+            for (const auto &nodeId: nodeIds) {
+                wayNodes.add_node_ref(nodeId);
+            }
+        }
+
+        index.way(buffer.get<osmium::Way>(buffer.commit()));
+    }
+}
+
+// _________________________________________________________________________________________________
+TEST_F(WayNodeIndexTest, notBuilt) {
+    olu::osm::WayNodeIndex index(_indexDir);
+    ASSERT_FALSE(index.isBuilt());
+
+    // An index that was never built is not maintained
+    applyWay(index, 1, 1, {1, 2});
+    index.commit();
+    ASSERT_FALSE(index.isBuilt());
+    ASSERT_TRUE(index.getWaysReferencingNodes({1, 2}).empty());
+}
+
+// _________________________________________________________________________________________________
+TEST_F(WayNodeIndexTest, buildAndLookup) {
+    olu::osm::WayNodeIndex index(_indexDir);
+    index.beginBuild();
+    applyWay(index, 10, 1, {1, 2, 3});
+    applyWay(index, 11, 3, {3, 4, 1});
+    applyWay(index, 12, 2, {5, 6});
+    index.endBuild();
+
+    ASSERT_TRUE(index.isBuilt());
+    ASSERT_EQ(index.getWaysReferencingNodes({1}), std::set<olu::id_t>({10, 11}));
+    ASSERT_EQ(index.getWaysReferencingNodes({2, 6}), std::set<olu::id_t>({10, 12}));
+    ASSERT_TRUE(index.getWaysReferencingNodes({7}).empty());
+}
+
+// _________________________________________________________________________________________________
+TEST_F(WayNodeIndexTest, applyChanges) {
+    {
+        olu::osm::WayNodeIndex index(_indexDir);
+        index.beginBuild();
+        applyWay(index, 10, 1, {1, 2, 3});
+        applyWay(index, 11, 1, {3, 4});
+        index.endBuild();
+
+        // Modified way
+        applyWay(index, 10, 2, {2, 3, 5});
+        // Deleted way
+        applyWay(index, 11, 2, {}, true);
+        // Created way
+        applyWay(index, 12, 1, {4, 5});
+
+        ASSERT_TRUE(index.getWaysReferencingNodes({1}).empty());
+        ASSERT_EQ(index.getWaysReferencingNodes({3}), std::set<olu::id_t>({10}));
+        ASSERT_EQ(index.getWaysReferencingNodes({4}), std::set<olu::id_t>({12}));
+        ASSERT_EQ(index.getWaysReferencingNodes({5}), std::set<olu::id_t>({10, 12}));
+        index.commit();
+    }
+    {
+        // The changes are persistent
+        olu::osm::WayNodeIndex index(_indexDir);
+        ASSERT_TRUE(index.isBuilt());
+        ASSERT_TRUE(index.getWaysReferencingNodes({1}).empty());
+        ASSERT_EQ(index.getWaysReferencingNodes({2, 3}), std::set<olu::id_t>({10}));
+        ASSERT_EQ(index.getWaysReferencingNodes({4}), std::set<olu::id_t>({12}));
+        ASSERT_EQ(index.getWaysReferencingNodes({5}), std::set<olu::id_t>({10, 12}));
+    }
+}
@@ -356,6 +356,55 @@ namespace olu::sparql {
             );
         }
     }
+    TEST(QueryWriter, writeInsertDataQuery) {
+        {
+            std::vector<std::string> triples;
+            triples.emplace_back("osmnode:1 osmkey:name \"A\"");
+            triples.emplace_back("osmnode:2 osmkey:name \"B\"");
+
+            QueryWriter qw{config::Config()};
+            std::string query = qw.writeInsertDataQuery(triples);
+            ASSERT_EQ(
+                    "INSERT DATA { osmnode:1 osmkey:name \"A\" . "
+                    "osmnode:2 osmkey:name \"B\" . }",
+                    query
+            );
+        }
+        {
+            std::vector<std::string> triples;
+            triples.emplace_back("osmnode:1 osmkey:name \"A\"");
+
+            config::Config config {};
+            config.graphUri = "https://example.org/a";
+            QueryWriter qw{config};
+            std::string query = qw.writeInsertDataQuery(triples);
+            ASSERT_EQ(
+                    "INSERT DATA { GRAPH <https://example.org/a> { "
+                    "osmnode:1 osmkey:name \"A\" . } }",
+                    query
+            );
+        }
+    }
+    TEST(QueryWriter, writeUpdateSequence) {
+        {
+            std::string query = QueryWriter::writeUpdateSequence({});
+            ASSERT_EQ("", query);
+        }
+        {
+            std::string query = QueryWriter::writeUpdateSequence(
+                {"DELETE WHERE { osmnode:1 ?p ?o . }"});
+            ASSERT_EQ("DELETE WHERE { osmnode:1 ?p ?o . }", query);
+        }
+        {
+            std::string query = QueryWriter::writeUpdateSequence(
+                {"DELETE WHERE { osmnode:1 ?p ?o . }", "DELETE WHERE { osmnode:2 ?p ?o . }"});
+            ASSERT_EQ(
+                    "DELETE WHERE { osmnode:1 ?p ?o . } ; "
+                    "DELETE WHERE { osmnode:2 ?p ?o . }",
+                    query
+            );
+        }
+    }
     TEST(QueryWriter, writeQueryForNodeLocations) {
         {
             QueryWriter qw{config::Config()};
@@ -0,0 +1,88 @@
+// Copyright 2025, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "util/AdaptiveBatchSize.h"
+#include "gtest/gtest.h"
+
+#include <chrono>
+
+using namespace std::chrono_literals;
+
+// _________________________________________________________________________________________________
+TEST(AdaptiveBatchSize, fixedSize) {
+    olu::util::AdaptiveBatchSize batchSize(100);
+    ASSERT_FALSE(batchSize.isAdaptive());
+    ASSERT_EQ(batchSize.get(), 100);
+
+    batchSize.onSuccess(100, 1ms);
+    batchSize.onSuccess(100, 1us);
+    ASSERT_EQ(batchSize.get(), 100);
+
+    batchSize.onFailure(100);
+    ASSERT_EQ(batchSize.get(), 100);
+    ASSERT_EQ(batchSize.getNumOfFailures(), 1);
+}
+
+// _________________________________________________________________________________________________
+TEST(AdaptiveBatchSize, growWhileLatencyImproves) {
+    olu::util::AdaptiveBatchSize batchSize(80, true);
+    ASSERT_TRUE(batchSize.isAdaptive());
+
+    // The first full batch grows the size by one step
+    batchSize.onSuccess(80, 80ms);
+    ASSERT_EQ(batchSize.get(), 90);
+
+    // Batches that are smaller than the current size are ignored
+    batchSize.onSuccess(50, 500ms);
+    ASSERT_EQ(batchSize.get(), 90);
+
+    // Same time per element
+    batchSize.onSuccess(90, 90ms);
+    ASSERT_EQ(batchSize.get(), 100);
+
+    // Time per element got worse, so the size goes one step back
+    batchSize.onSuccess(100, 200ms);
+    ASSERT_EQ(batchSize.get(), 90);
+
+    // The size never grows beyond the maximum
+    for (int i = 0; i < 100; ++i) {
+        batchSize.onSuccess(batchSize.get(), 1ms);
+    }
+    ASSERT_EQ(batchSize.get(), 80 * olu::util::AdaptiveBatchSize::MAX_SIZE_FACTOR);
+}
+
+// _________________________________________________________________________________________________
+TEST(AdaptiveBatchSize, shrinkOnFailure) {
+    olu::util::AdaptiveBatchSize batchSize(80, true);
+
+    batchSize.onFailure(80);
+    ASSERT_EQ(batchSize.get(), 40);
+
+    // The size is halved relative to the failed batch if it was smaller
+    batchSize.onFailure(10);
+    ASSERT_EQ(batchSize.get(), 5);
+
+    batchSize.onFailure(1);
+    batchSize.onFailure(1);
+    ASSERT_EQ(batchSize.get(), 1);
+    ASSERT_EQ(batchSize.getNumOfFailures(), 4);
+
+    // After a failure, the size grows by steps relative to the new size
+    batchSize.onSuccess(1, 1ms);
+    ASSERT_EQ(batchSize.get(), 2);
+}
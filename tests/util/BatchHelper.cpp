@@ -0,0 +1,187 @@
+// Copyright 2025, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "util/BatchHelper.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+    std::set<olu::id_t> getIds(const olu::id_t count) {
+        std::set<olu::id_t> ids;
+        for (olu::id_t id = 1; id <= count; ++id) {
+            ids.insert(id);
+        }
+        return ids;
+    }
+}
+
+// _________________________________________________________________________________________________
+TEST(BatchHelper, doInBatchesConcurrentlyOrdered) {
+    const auto ids = getIds(1000);
+    std::vector<size_t> batchNumbers;
+    std::vector<olu::id_t> firstIds;
+    std::set<size_t> workers;
+    olu::util::BatchHelper::doInBatchesConcurrently(ids, 7, 4,
+        [](const std::set<olu::id_t> &batch, const size_t worker) {
+            // Let later batches finish first from time to time
+            if (*batch.begin() % 3 == 0) {
+                std::this_thread::yield();
+            }
+            return std::make_pair(*batch.begin(), worker);
+        },
+        [&](const std::pair<olu::id_t, size_t> &result, const size_t batchNumber) {
+            batchNumbers.push_back(batchNumber);
+            firstIds.push_back(result.first);
+            workers.insert(result.second);
+        }, olu::util::BatchCompletion::ORDERED);
+
+    ASSERT_EQ(batchNumbers.size(), 143);
+    for (size_t i = 0; i < batchNumbers.size(); ++i) {
+        ASSERT_EQ(batchNumbers[i], i);
+        ASSERT_EQ(firstIds[i], static_cast<olu::id_t>(i * 7 + 1));
+    }
+    for (const auto &worker: workers) {
+        ASSERT_TRUE(worker < 4);
+    }
+}
+
+// _________________________________________________________________________________________________
+TEST(BatchHelper, doInBatchesConcurrentlyUnordered) {
+    const auto ids = getIds(1000);
+    std::set<size_t> batchNumbers;
+    std::set<olu::id_t> processedIds;
+    olu::util::BatchHelper::doInBatchesConcurrently(ids, 10, 8,
+        [](const std::set<olu::id_t> &batch, size_t) {
+            return batch;
+        },
+        [&](const std::set<olu::id_t> &batch, const size_t batchNumber) {
+            ASSERT_TRUE(batchNumbers.insert(batchNumber).second);
+            processedIds.insert(batch.begin(), batch.end());
+        });
+
+    ASSERT_EQ(batchNumbers.size(), 100);
+    ASSERT_EQ(processedIds, ids);
+}
+
+// _________________________________________________________________________________________________
+TEST(BatchHelper, doInBatchesConcurrentlySequential) {
+    const auto mainThread = std::this_thread::get_id();
+    size_t numOfBatches = 0;
+    olu::util::BatchHelper::doInBatchesConcurrently(getIds(25), 10, 1,
+        [&mainThread](const std::set<olu::id_t> &batch, const size_t worker) {
+            EXPECT_EQ(std::this_thread::get_id(), mainThread);
+            EXPECT_EQ(worker, 0);
+            return batch.size();
+        },
+        [&numOfBatches](const size_t size, const size_t batchNumber) {
+            ASSERT_EQ(batchNumber, numOfBatches++);
+            ASSERT_EQ(size, batchNumber < 2 ? 10 : 5);
+        }, olu::util::BatchCompletion::ORDERED);
+    ASSERT_EQ(numOfBatches, 3);
+
+    // Nothing is done for an empty set
+    olu::util::BatchHelper::doInBatchesConcurrently({}, 10, 4,
+        [](const std::set<olu::id_t> &, size_t) { return 0; },
+        [](int, size_t) { FAIL(); });
+}
+
+// _________________________________________________________________________________________________
+TEST(BatchHelper, doInBatchesConcurrentlyError) {
+    const auto ids = getIds(100);
+    for (const auto &completion: {olu::util::BatchCompletion::ORDERED,
+                                  olu::util::BatchCompletion::UNORDERED}) {
+        std::set<size_t> completed;
+        try {
+            olu::util::BatchHelper::doInBatchesConcurrently(ids, 1, 4,
+                [](const std::set<olu::id_t> &batch, size_t) {
+                    if (*batch.begin() == 50 || *batch.begin() == 60) {
+                        throw std::runtime_error(std::to_string(*batch.begin()));
+                    }
+                    return *batch.begin();
+                },
+                [&completed](olu::id_t, const size_t batchNumber) {
+                    completed.insert(batchNumber);
+                }, completion);
+            FAIL();
+        } catch (const std::runtime_error &e) {
+            // The error of the first failed batch is reported
+            ASSERT_STREQ(e.what(), "50");
+        }
+
+        ASSERT_FALSE(completed.contains(49));
+        if (completion == olu::util::BatchCompletion::ORDERED) {
+            for (size_t batchNumber = 0; batchNumber < 49; ++batchNumber) {
+                ASSERT_TRUE(completed.contains(batchNumber));
+            }
+        }
+    }
+}
+
+// _________________________________________________________________________________________________
+TEST(BatchHelper, doInBatchesSplitsTooLargeBatches) {
+    const auto ids = getIds(100);
+
+    // Batches with more than 10 elements fail
+    const auto failIfTooLarge = [](const std::set<olu::id_t> &batch) {
+        if (batch.size() > 10) {
+            throw olu::util::BatchTooLargeException("too large");
+        }
+    };
+
+    {
+        olu::util::AdaptiveBatchSize batchSize(40, true);
+        std::set<olu::id_t> processedIds;
+        olu::util::BatchHelper::doInBatches(ids, batchSize,
+            [&](const std::set<olu::id_t> &batch) {
+                failIfTooLarge(batch);
+                processedIds.insert(batch.begin(), batch.end());
+            });
+
+        ASSERT_EQ(processedIds, ids);
+        ASSERT_TRUE(batchSize.getNumOfFailures() > 0);
+        ASSERT_TRUE(batchSize.get() < 40);
+    }
+    {
+        // Batches are not split if the batch size is fixed
+        olu::util::AdaptiveBatchSize batchSize(40);
+        ASSERT_THROW(olu::util::BatchHelper::doInBatches(ids, batchSize, failIfTooLarge),
+                     olu::util::BatchTooLargeException);
+    }
+    {
+        olu::util::AdaptiveBatchSize batchSize(40, true);
+        std::vector<size_t> batchNumbers;
+        std::set<olu::id_t> processedIds;
+        olu::util::BatchHelper::doInBatchesConcurrently(ids, batchSize, 4,
+            [&failIfTooLarge](const std::set<olu::id_t> &batch, size_t) {
+                failIfTooLarge(batch);
+                return batch;
+            },
+            [&](const std::set<olu::id_t> &batch, const size_t batchNumber) {
+                batchNumbers.push_back(batchNumber);
+                processedIds.insert(batch.begin(), batch.end());
+            }, olu::util::BatchCompletion::ORDERED);
+
+        ASSERT_EQ(processedIds, ids);
+        ASSERT_TRUE(std::ranges::is_sorted(batchNumbers));
+    }
+}
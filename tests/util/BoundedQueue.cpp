@@ -0,0 +1,81 @@
+// Copyright 2025, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "util/BoundedQueue.h"
+#include "gtest/gtest.h"
+
+#include <thread>
+#include <vector>
+
+// _________________________________________________________________________________________________
+TEST(BoundedQueue, pushAndPop) {
+    {
+        olu::util::BoundedQueue<int> queue(2);
+        ASSERT_TRUE(queue.push(1));
+        ASSERT_TRUE(queue.push(2));
+        queue.close();
+
+        ASSERT_EQ(queue.pop(), 1);
+        ASSERT_EQ(queue.pop(), 2);
+        ASSERT_EQ(queue.pop(), std::nullopt);
+        ASSERT_FALSE(queue.push(3));
+    }
+    {
+        olu::util::BoundedQueue<int> queue(0);
+        ASSERT_EQ(queue.capacity(), 1);
+    }
+}
+
+// _________________________________________________________________________________________________
+TEST(BoundedQueue, producerConsumer) {
+    olu::util::BoundedQueue<int> queue(1);
+    std::vector<int> consumed;
+    std::thread consumer([&queue, &consumed] {
+        while (auto element = queue.pop()) {
+            consumed.push_back(*element);
+        }
+    });
+
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_TRUE(queue.push(i));
+    }
+    queue.close();
+    consumer.join();
+
+    ASSERT_EQ(consumed.size(), 1000);
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_EQ(consumed[i], i);
+    }
+}
+
+// _________________________________________________________________________________________________
+TEST(BoundedQueue, closeWakesBlockedProducer) {
+    olu::util::BoundedQueue<int> queue(1);
+    ASSERT_TRUE(queue.push(1));
+
+    bool pushed = true;
+    std::thread producer([&queue, &pushed] {
+        pushed = queue.push(2);
+    });
+
+    queue.close();
+    producer.join();
+    ASSERT_FALSE(pushed);
+    ASSERT_EQ(queue.pop(), 1);
+    ASSERT_EQ(queue.pop(), std::nullopt);
+}
@@ -0,0 +1,113 @@
+// Copyright 2025, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "util/Compressor.h"
+
+#include <string>
+
+#include <zlib.h>
+
+#ifdef OLU_WITH_ZSTD
+#include <zstd.h>
+#endif
+
+#include "gtest/gtest.h"
+
+namespace {
+    std::string getBody() {
+        std::string body;
+        for (int i = 0; i < 1000; ++i) {
+            body += "<https://www.openstreetmap.org/node/" + std::to_string(i)
+                    + "> <https://www.openstreetmap.org/wiki/Key:name> \"Node\" .\n";
+        }
+        return body;
+    }
+
+    std::string gunzip(const std::string &input) {
+        z_stream stream{};
+        inflateInit2(&stream, 15 + 16);
+
+        std::string output(1 << 20, '\0');
+        stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+        stream.avail_in = static_cast<uInt>(input.size());
+        stream.next_out = reinterpret_cast<Bytef*>(output.data());
+        stream.avail_out = static_cast<uInt>(output.size());
+        const auto result = inflate(&stream, Z_FINISH);
+        output.resize(stream.total_out);
+        inflateEnd(&stream);
+
+        return result == Z_STREAM_END ? output : "";
+    }
+}
+
+// _________________________________________________________________________________________________
+TEST(Compressor, typeFromString) {
+    ASSERT_EQ(olu::util::Compressor::typeFromString(""), olu::util::CompressionType::NONE);
+    ASSERT_EQ(olu::util::Compressor::typeFromString("gzip"), olu::util::CompressionType::GZIP);
+    ASSERT_EQ(olu::util::Compressor::typeFromString("zstd"), olu::util::CompressionType::ZSTD);
+    ASSERT_THROW(olu::util::Compressor::typeFromString("br"),
+                 olu::util::CompressorException);
+
+    ASSERT_EQ(olu::util::Compressor::getContentEncoding(olu::util::CompressionType::GZIP),
+              "gzip");
+    ASSERT_EQ(olu::util::Compressor::getContentEncoding(olu::util::CompressionType::ZSTD),
+              "zstd");
+}
+
+// _________________________________________________________________________________________________
+TEST(Compressor, gzip) {
+    olu::util::Compressor compressor(olu::util::CompressionType::GZIP);
+    const std::string body = getBody();
+
+    // The compressor and the output buffer are reused for several bodies
+    std::string output;
+    for (int i = 0; i < 3; ++i) {
+        const auto info = compressor.compress(body, output);
+        ASSERT_EQ(info.inputSize, body.size());
+        ASSERT_EQ(info.outputSize, output.size());
+        ASSERT_TRUE(output.size() < body.size());
+        ASSERT_EQ(gunzip(output), body);
+    }
+
+    compressor.compress("", output);
+    ASSERT_EQ(gunzip(output), "");
+}
+
+// _________________________________________________________________________________________________
+TEST(Compressor, zstd) {
+    if (!olu::util::Compressor::isSupported(olu::util::CompressionType::ZSTD)) {
+        ASSERT_THROW(olu::util::Compressor compressor(olu::util::CompressionType::ZSTD),
+                     olu::util::CompressorException);
+        return;
+    }
+
+#ifdef OLU_WITH_ZSTD
+    olu::util::Compressor compressor(olu::util::CompressionType::ZSTD);
+    const std::string body = getBody();
+
+    std::string output;
+    const auto info = compressor.compress(body, output);
+    ASSERT_EQ(info.outputSize, output.size());
+    ASSERT_TRUE(output.size() < body.size());
+
+    std::string decompressed(ZSTD_getFrameContentSize(output.data(), output.size()), '\0');
+    ASSERT_EQ(ZSTD_decompress(decompressed.data(), decompressed.size(),
+                              output.data(), output.size()), body.size());
+    ASSERT_EQ(decompressed, body);
+#endif
+}
@@ -0,0 +1,70 @@
+// Copyright 2025, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "util/Histogram.h"
+#include "gtest/gtest.h"
+
+// _________________________________________________________________________________________________
+TEST(Histogram, empty) {
+    const olu::util::Histogram histogram;
+    ASSERT_EQ(histogram.count(), 0);
+    ASSERT_EQ(histogram.min(), 0);
+    ASSERT_EQ(histogram.max(), 0);
+    ASSERT_EQ(histogram.mean(), 0);
+    ASSERT_TRUE(histogram.getBuckets().empty());
+}
+
+// _________________________________________________________________________________________________
+TEST(Histogram, buckets) {
+    olu::util::Histogram histogram;
+    for (const size_t value: {0, 1, 2, 3, 4, 7, 8, 1000}) {
+        histogram.add(value);
+    }
+
+    ASSERT_EQ(histogram.count(), 8);
+    ASSERT_EQ(histogram.sum(), 1025);
+    ASSERT_EQ(histogram.min(), 0);
+    ASSERT_EQ(histogram.max(), 1000);
+
+    const auto buckets = histogram.getBuckets();
+    ASSERT_EQ(buckets.size(), 6);
+    ASSERT_EQ(buckets[0].lowerBound, 0);
+    ASSERT_EQ(buckets[0].upperBound, 0);
+    ASSERT_EQ(buckets[0].count, 1);
+    ASSERT_EQ(buckets[1].lowerBound, 1);
+    ASSERT_EQ(buckets[1].upperBound, 1);
+    ASSERT_EQ(buckets[1].count, 1);
+    ASSERT_EQ(buckets[2].lowerBound, 2);
+    ASSERT_EQ(buckets[2].upperBound, 3);
+    ASSERT_EQ(buckets[2].count, 2);
+    ASSERT_EQ(buckets[3].lowerBound, 4);
+    ASSERT_EQ(buckets[3].upperBound, 7);
+    ASSERT_EQ(buckets[3].count, 2);
+    ASSERT_EQ(buckets[4].lowerBound, 8);
+    ASSERT_EQ(buckets[4].count, 1);
+    ASSERT_EQ(buckets[5].lowerBound, 512);
+    ASSERT_EQ(buckets[5].upperBound, 1023);
+    ASSERT_EQ(buckets[5].count, 1);
+
+    // The largest value is in the top bucket, whose upper bound is inclusive as well
+    histogram.add(std::numeric_limits<size_t>::max());
+    const auto topBucket = histogram.getBuckets().back();
+    ASSERT_EQ(topBucket.lowerBound, size_t{1} << (std::numeric_limits<size_t>::digits - 1));
+    ASSERT_EQ(topBucket.upperBound, std::numeric_limits<size_t>::max());
+    ASSERT_EQ(topBucket.count, 1);
+}
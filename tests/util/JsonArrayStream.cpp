@@ -0,0 +1,88 @@
+// Copyright 2025, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "util/JsonArrayStream.h"
+#include "gtest/gtest.h"
+
+#include <string>
+#include <vector>
+
+namespace {
+    const std::string QLEVER_RESPONSE =
+        R"({"query":"SELECT \"res\": [1] ?x","res" : [ ["<a>", "\"1\"^^<x>"], )"
+        R"(["<b\\]>", null] , [] ],"time":{"total":"3ms"}})";
+}
+
+// _________________________________________________________________________________________________
+TEST(JsonArrayStream, splitsElementsInAllChunkSizes) {
+    for (size_t chunkSize = 1; chunkSize <= QLEVER_RESPONSE.size(); ++chunkSize) {
+        std::vector<std::string> elements;
+        olu::util::JsonArrayStream stream("res", [&elements](const std::string &element) {
+            ASSERT_GE(element.capacity(), element.size() + 64);
+            elements.push_back(element);
+        });
+
+        for (size_t i = 0; i < QLEVER_RESPONSE.size(); i += chunkSize) {
+            stream.feed(std::string_view(QLEVER_RESPONSE).substr(i, chunkSize));
+        }
+
+        ASSERT_TRUE(stream.isArrayComplete());
+        ASSERT_EQ(stream.getNumOfElements(), 3);
+        ASSERT_EQ(elements, (std::vector<std::string>{R"(["<a>", "\"1\"^^<x>"])",
+                                                      R"(["<b\\]>", null])", "[]"}));
+        ASSERT_EQ(stream.getRest(),
+                  R"({"query":"SELECT \"res\": [1] ?x","res" : [],"time":{"total":"3ms"}})");
+    }
+}
+
+// _________________________________________________________________________________________________
+TEST(JsonArrayStream, nestedArray) {
+    std::vector<std::string> elements;
+    olu::util::JsonArrayStream stream("bindings", [&elements](const std::string &element) {
+        elements.push_back(element);
+    });
+    stream.feed(R"({"head":{"vars":["a"]},"results":{"bindings":[{"a":{"value":"x"}},)");
+    ASSERT_EQ(elements.size(), 1);
+    ASSERT_FALSE(stream.isArrayComplete());
+    stream.feed(R"({"a":{"value":"}"}}]}})");
+    ASSERT_TRUE(stream.isArrayComplete());
+    ASSERT_EQ(elements, (std::vector<std::string>{R"({"a":{"value":"x"}})",
+                                                  R"({"a":{"value":"}"}})"}));
+    ASSERT_EQ(stream.getRest(), R"({"head":{"vars":["a"]},"results":{"bindings":[]}})");
+}
+
+// _________________________________________________________________________________________________
+TEST(JsonArrayStream, scalarElements) {
+    std::vector<std::string> elements;
+    olu::util::JsonArrayStream stream("v", [&elements](const std::string &element) {
+        elements.push_back(element);
+    });
+    stream.feed(R"({"v":[1, "a,b" ,true]})");
+    ASSERT_EQ(elements, (std::vector<std::string>{"1", "\"a,b\"", "true"}));
+}
+
+// _________________________________________________________________________________________________
+TEST(JsonArrayStream, missingArray) {
+    size_t numOfElements = 0;
+    olu::util::JsonArrayStream stream("res", [&numOfElements](const std::string &) {
+        ++numOfElements;
+    });
+    stream.feed(R"({"exception":"res"})");
+    ASSERT_FALSE(stream.isArrayComplete());
+    ASSERT_EQ(numOfElements, 0);
+}
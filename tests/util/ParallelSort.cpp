@@ -0,0 +1,40 @@
+// Copyright 2025, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "util/ParallelSort.h"
+#include "gtest/gtest.h"
+
+#include <functional>
+#include <random>
+#include <vector>
+
+// _________________________________________________________________________________________________
+TEST(ParallelSort, sortsLikeStdSort) {
+    std::mt19937 random(42);
+    for (const size_t size: {0, 1, 100, 20000, 1000003}) {
+        std::vector<int> values(size);
+        for (auto &value: values) {
+            value = static_cast<int>(random() % 1000);
+        }
+
+        auto expected = values;
+        std::ranges::sort(expected, std::greater());
+        olu::util::parallelSort(values.begin(), values.end(), std::greater());
+        ASSERT_EQ(values, expected);
+    }
+}
@@ -0,0 +1,126 @@
+// Copyright 2025, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "util/PolygonIndex.h"
+#include "gtest/gtest.h"
+
+#include <filesystem>
+#include <cmath>
+#include <fstream>
+
+namespace {
+    // Square from (0, 0) to (4, 4) with a hole from (1, 1) to (2, 2)
+    const std::vector<olu::util::PolygonIndex::ring_t> SQUARE_WITH_HOLE = {
+        {{0, 0}, {4, 0}, {4, 4}, {0, 4}},
+        {{1, 1}, {2, 1}, {2, 2}, {1, 2}}
+    };
+
+    // Checks the index against a test with all edges of the polygon
+    bool containsBruteForce(const std::vector<olu::util::PolygonIndex::ring_t> &rings,
+                            const double lon, const double lat) {
+        bool isInside = false;
+        for (const auto &ring: rings) {
+            for (size_t i = 0, j = ring.size() - 1; i < ring.size(); j = i++) {
+                const auto &[x1, y1] = ring[i];
+                const auto &[x2, y2] = ring[j];
+                if ((y1 > lat) != (y2 > lat) && lon < x1 + (lat - y1) * (x2 - x1) / (y2 - y1)) {
+                    isInside = !isInside;
+                }
+            }
+        }
+        return isInside;
+    }
+}
+
+// _________________________________________________________________________________________________
+TEST(PolygonIndex, contains) {
+    for (const size_t cellsPerAxis: {0, 1, 3, 16}) {
+        const olu::util::PolygonIndex index(SQUARE_WITH_HOLE, cellsPerAxis);
+        ASSERT_TRUE(index.contains(0.5, 0.5));
+        ASSERT_TRUE(index.contains(3.5, 3.9));
+        ASSERT_TRUE(index.contains(2.5, 1.5));
+        ASSERT_FALSE(index.contains(1.5, 1.5));
+        ASSERT_FALSE(index.contains(-1, 2));
+        ASSERT_FALSE(index.contains(5, 2));
+        ASSERT_FALSE(index.contains(2, 4.5));
+    }
+}
+
+// _________________________________________________________________________________________________
+TEST(PolygonIndex, concavePolygon) {
+    // Star shaped polygon, so that many grid cells are crossed by edges
+    olu::util::PolygonIndex::ring_t star;
+    for (size_t i = 0; i < 40; ++i) {
+        const double angle = 2 * M_PI * static_cast<double>(i) / 40;
+        const double radius = i % 2 == 0 ? 10 : 3;
+        star.emplace_back(radius * std::cos(angle), radius * std::sin(angle));
+    }
+
+    const std::vector<olu::util::PolygonIndex::ring_t> rings{star};
+    const olu::util::PolygonIndex index(rings);
+    for (double lon = -11; lon <= 11; lon += 0.37) {
+        for (double lat = -11; lat <= 11; lat += 0.41) {
+            ASSERT_EQ(index.contains(lon, lat), containsBruteForce(rings, lon, lat));
+        }
+    }
+}
+
+// _________________________________________________________________________________________________
+TEST(PolygonIndex, fromPolyFile) {
+    const auto path = std::filesystem::temp_directory_path() / "olu_test_polygon.poly";
+    {
+        std::ofstream file(path);
+        file << "test\n"
+                "1\n"
+                "   0.0E+00   0.0E+00\n"
+                "   4.0E+00   0.0E+00\n"
+                "   4.0E+00   4.0E+00\n"
+                "   0.0E+00   4.0E+00\n"
+                "END\n"
+                "!2\n"
+                "   1.0 1.0\n"
+                "   2.0 1.0\n"
+                "   2.0 2.0\n"
+                "   1.0 2.0\n"
+                "END\n"
+                "END\n";
+    }
+
+    const auto index = olu::util::PolygonIndex::fromPolyFile(path);
+    ASSERT_TRUE(index.contains(0.5, 0.5));
+    ASSERT_FALSE(index.contains(1.5, 1.5));
+    ASSERT_FALSE(index.contains(5, 5));
+    std::filesystem::remove(path);
+}
+
+// _________________________________________________________________________________________________
+TEST(PolygonIndex, invalidPolyFile) {
+    const auto path = std::filesystem::temp_directory_path() / "olu_test_polygon_invalid.poly";
+    {
+        std::ofstream file(path);
+        file << "test\n"
+                "1\n"
+                "   0.0 0.0\n"
+                "   4.0 0.0\n";
+    }
+
+    ASSERT_THROW(olu::util::PolygonIndex::fromPolyFile(path), olu::util::PolygonIndexException);
+    ASSERT_THROW(olu::util::PolygonIndex::fromPolyFile(path.string() + ".missing"),
+                 olu::util::PolygonIndexException);
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,136 @@
+// Copyright 2025, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+#include "util/StageGraph.h"
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+// _________________________________________________________________________________________________
+TEST(StageGraph, runsStagesAfterTheirInputs) {
+    olu::util::StageGraph graph;
+    std::mutex mutex;
+    std::vector<std::string> order;
+    const auto record = [&mutex, &order](const std::string &name) {
+        return [&mutex, &order, name] {
+            std::lock_guard lock(mutex);
+            order.push_back(name);
+        };
+    };
+
+    // Added in reverse order of execution
+    graph.addStage("c", {"a", "b"}, {"c"}, record("c"));
+    graph.addStage("b", {"source"}, {"b"}, record("b"));
+    graph.addStage("a", {"source"}, {"a"}, record("a"));
+    graph.addInput("source");
+
+    olu::util::WorkStealingPool pool(2);
+    graph.run(pool);
+
+    ASSERT_EQ(order.size(), 3);
+    ASSERT_EQ(order.back(), "c");
+
+    const auto timings = graph.getTimings();
+    ASSERT_EQ(timings.size(), 3);
+    ASSERT_EQ(timings[0].name, "c");
+    ASSERT_GE(timings[0].start, timings[1].end);
+    ASSERT_GE(timings[0].start, timings[2].end);
+}
+
+// _________________________________________________________________________________________________
+TEST(StageGraph, runsIndependentStagesConcurrently) {
+    olu::util::StageGraph graph;
+    std::atomic<int> running = 0;
+    std::atomic<int> maxRunning = 0;
+    const auto stage = [&running, &maxRunning] {
+        const int now = ++running;
+        int max = maxRunning;
+        while (now > max && !maxRunning.compare_exchange_weak(max, now)) { }
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        --running;
+    };
+
+    graph.addStage("a", {}, {"a"}, stage);
+    graph.addStage("b", {}, {"b"}, stage);
+
+    olu::util::WorkStealingPool pool(2);
+    graph.run(pool);
+
+    ASSERT_EQ(maxRunning, 2);
+}
+
+// _________________________________________________________________________________________________
+TEST(StageGraph, criticalPath) {
+    olu::util::StageGraph graph;
+    const auto sleep = [](const int ms) {
+        return [ms] { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); };
+    };
+
+    graph.addStage("read", {}, {"ids"}, sleep(1));
+    graph.addStage("fast", {"ids"}, {"fast"}, sleep(1));
+    graph.addStage("slow", {"ids"}, {"slow"}, sleep(100));
+    graph.addStage("write", {"fast", "slow"}, {}, sleep(1));
+
+    olu::util::WorkStealingPool pool(2);
+    graph.run(pool);
+
+    const auto path = graph.getCriticalPath();
+    ASSERT_EQ(path.size(), 3);
+    ASSERT_EQ(path[0].name, "read");
+    ASSERT_EQ(path[1].name, "slow");
+    ASSERT_EQ(path[2].name, "write");
+    ASSERT_GE(path[1].getTimeInMS(), 100);
+}
+
+// _________________________________________________________________________________________________
+TEST(StageGraph, exceptionStopsDependentStages) {
+    olu::util::StageGraph graph;
+    std::atomic<bool> dependentRan = false;
+    graph.addStage("fail", {}, {"a"}, [] { throw std::runtime_error("failed"); });
+    graph.addStage("dependent", {"a"}, {}, [&dependentRan] { dependentRan = true; });
+
+    olu::util::WorkStealingPool pool(2);
+    ASSERT_THROW(graph.run(pool), std::runtime_error);
+    ASSERT_FALSE(dependentRan);
+    ASSERT_EQ(graph.getTimings().size(), 1);
+}
+
+// _________________________________________________________________________________________________
+TEST(StageGraph, invalidGraphs) {
+    olu::util::WorkStealingPool pool(1);
+    {
+        olu::util::StageGraph graph;
+        graph.addStage("a", {"missing"}, {"a"}, [] {});
+        ASSERT_THROW(graph.run(pool), olu::util::StageGraphException);
+    }
+    {
+        olu::util::StageGraph graph;
+        graph.addStage("a", {}, {"a"}, [] {});
+        graph.addStage("b", {}, {"a"}, [] {});
+        ASSERT_THROW(graph.run(pool), olu::util::StageGraphException);
+    }
+    {
+        olu::util::StageGraph graph;
+        graph.addStage("a", {"b"}, {"a"}, [] {});
+        graph.addStage("b", {"a"}, {"b"}, [] {});
+        ASSERT_THROW(graph.run(pool), olu::util::StageGraphException);
+    }
+}
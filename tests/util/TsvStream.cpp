@@ -0,0 +1,93 @@
+// Copyright 2025, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "util/TsvStream.h"
+#include "gtest/gtest.h"
+
+#include <string>
+#include <vector>
+
+namespace {
+    const std::string RESULT =
+        "?node\t?location\n"
+        "<https://www.openstreetmap.org/node/1>\t\"POINT(7.8 48.0)\"^^<http://www.opengis.net/ont/geosparql#wktLiteral>\n"
+        "<https://www.openstreetmap.org/node/2>\t\n";
+}
+
+// _________________________________________________________________________________________________
+TEST(TsvStream, splitsRowsInAllChunkSizes) {
+    for (size_t chunkSize = 1; chunkSize <= RESULT.size(); ++chunkSize) {
+        std::vector<std::vector<std::string>> rows;
+        olu::util::TsvStream stream([&rows](const olu::util::TsvStream::row_t &row) {
+            rows.emplace_back(row.begin(), row.end());
+        });
+
+        for (size_t i = 0; i < RESULT.size(); i += chunkSize) {
+            stream.feed(std::string_view(RESULT).substr(i, chunkSize));
+        }
+        stream.finish();
+
+        ASSERT_EQ(stream.getNumOfRows(), 2);
+        ASSERT_EQ(rows, (std::vector<std::vector<std::string>>{
+                      {"<https://www.openstreetmap.org/node/1>",
+                       "\"POINT(7.8 48.0)\"^^<http://www.opengis.net/ont/geosparql#wktLiteral>"},
+                      {"<https://www.openstreetmap.org/node/2>", ""}}));
+    }
+}
+
+// _________________________________________________________________________________________________
+TEST(TsvStream, lastLineWithoutLineBreak) {
+    std::vector<std::vector<std::string>> rows;
+    olu::util::TsvStream stream([&rows](const olu::util::TsvStream::row_t &row) {
+        rows.emplace_back(row.begin(), row.end());
+    });
+    stream.feed("?a\r\n<x>\r\n<y>");
+    ASSERT_EQ(rows.size(), 1);
+    stream.finish();
+    ASSERT_EQ(rows, (std::vector<std::vector<std::string>>{{"<x>"}, {"<y>"}}));
+}
+
+// _________________________________________________________________________________________________
+TEST(TsvStream, emptyResult) {
+    size_t numOfRows = 0;
+    olu::util::TsvStream stream([&numOfRows](const olu::util::TsvStream::row_t &) {
+        ++numOfRows;
+    });
+    stream.feed("?a\t?b\n");
+    stream.finish();
+    ASSERT_EQ(numOfRows, 0);
+}
+
+// _________________________________________________________________________________________________
+TEST(TsvStream, escapedValues) {
+    for (const std::string result: {"?a\t?b\n\"a\\tb\\nc\"\t\"d\\\\e\\u00e4\"\n",
+                                    "?a\t?b\r\n\"a\\tb\\nc\"\t\"d\\\\e\\u00e4\""}) {
+        std::vector<std::vector<std::string>> rows;
+        olu::util::TsvStream stream([&rows](const olu::util::TsvStream::row_t &row) {
+            rows.emplace_back(row.begin(), row.end());
+        });
+        for (const char c: result) {
+            stream.feed(std::string_view(&c, 1));
+        }
+        stream.finish();
+
+        // Unknown escape sequences are kept
+        ASSERT_EQ(rows, (std::vector<std::vector<std::string>>{
+                      {"\"a\tb\nc\"", "\"d\\e\\u00e4\""}}));
+    }
+}
@@ -93,4 +93,12 @@ TEST(URLHelper, encodeForUrlQuery) {
         const std::string encoded = olu::util::URLHelper::encodeForUrlQuery(input);
         ASSERT_EQ(encoded, "");
     }
-}
\ No newline at end of file
+}
+
+// _________________________________________________________________________________________________
+TEST(URLHelper, appendEncodedForUrlQuery) {
+    std::string body = "update=";
+    olu::util::URLHelper::appendEncodedForUrlQuery(body, "PREFIX a: <b> ");
+    olu::util::URLHelper::appendEncodedForUrlQuery(body, "DELETE { ?s ?p ?o }");
+    ASSERT_EQ(body, "update=PREFIX%20a%3A%20%3Cb%3E%20DELETE%20%7B%20%3Fs%20%3Fp%20%3Fo%20%7D");
+}
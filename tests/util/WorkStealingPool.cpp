@@ -0,0 +1,94 @@
+// Copyright 2025, University of Freiburg
+// Authors: Nicolas von Trott <nicolasvontrott@gmail.com>.
+
+// This file is part of osm-live-updates.
+//
+// osm-live-updates is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// osm-live-updates is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with osm-live-updates.  If not, see <https://www.gnu.org/licenses/>.
+#include "util/WorkStealingPool.h"
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <chrono>
+#include <set>
+#include <thread>
+
+// _________________________________________________________________________________________________
+TEST(WorkStealingPool, runsAllTasks) {
+    olu::util::WorkStealingPool pool(4);
+    ASSERT_EQ(pool.size(), 4);
+
+    std::atomic<int> sum = 0;
+    for (int i = 1; i <= 1000; ++i) {
+        pool.submit([&sum, i] { sum += i; });
+    }
+    pool.wait();
+
+    ASSERT_EQ(sum, 500500);
+}
+
+// _________________________________________________________________________________________________
+TEST(WorkStealingPool, tasksSubmittedFromTasks) {
+    olu::util::WorkStealingPool pool(3);
+
+    std::atomic<int> count = 0;
+    for (int i = 0; i < 10; ++i) {
+        pool.submit([&pool, &count] {
+            for (int j = 0; j < 10; ++j) {
+                pool.submit([&count] { ++count; });
+            }
+            ++count;
+        });
+    }
+
+    // Waiting also includes the tasks that were submitted by other tasks
+    pool.wait();
+    ASSERT_EQ(count, 110);
+}
+
+// _________________________________________________________________________________________________
+TEST(WorkStealingPool, idleWorkersStealTasks) {
+    olu::util::WorkStealingPool pool(2);
+
+    std::mutex mutex;
+    std::set<std::thread::id> threads;
+    // All tasks are added to the queue of the worker that runs the first task, so the other
+    // worker can only run some of them by stealing.
+    pool.submit([&] {
+        for (int i = 0; i < 20; ++i) {
+            pool.submit([&] {
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+                std::lock_guard lock(mutex);
+                threads.insert(std::this_thread::get_id());
+            });
+        }
+    });
+    pool.wait();
+
+    ASSERT_EQ(threads.size(), 2);
+    ASSERT_GT(pool.getNumOfStolenTasks(), 0);
+}
+
+// _________________________________________________________________________________________________
+TEST(WorkStealingPool, destructorRunsQueuedTasks) {
+    std::atomic<int> count = 0;
+    {
+        olu::util::WorkStealingPool pool(0);
+        ASSERT_EQ(pool.size(), 1);
+        for (int i = 0; i < 100; ++i) {
+            pool.submit([&count] { ++count; });
+        }
+    }
+
+    ASSERT_EQ(count, 100);
+}